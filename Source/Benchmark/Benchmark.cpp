@@ -0,0 +1,101 @@
+﻿#include "Benchmark/Benchmark.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Fly3DPrivateBenchmark
+{
+	enum
+	{
+		MAX_BENCHMARKS = 64
+	};
+
+	struct FBenchmarkEntry
+	{
+		const char*			Name;
+		FBenchmarkFunction	Function;
+	};
+
+	// Filled during static initialization, so plain arrays rather than anything that allocates.
+	static FBenchmarkEntry s_Benchmarks[MAX_BENCHMARKS];
+	static int32 s_NumBenchmarks = 0;
+
+	static bool IsSelected(const char* name, int32 argc, char** argv)
+	{
+		if (argc <= 1)
+		{
+			return true;
+		}
+
+		for (int32 i = 1; i < argc; ++i)
+		{
+			if (strstr(name, argv[i]) != nullptr)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+void FBenchmark::Register(const char* name, FBenchmarkFunction function)
+{
+	using namespace Fly3DPrivateBenchmark;
+
+	Assert(s_NumBenchmarks < (int32)MAX_BENCHMARKS);
+
+	s_Benchmarks[s_NumBenchmarks].Name     = name;
+	s_Benchmarks[s_NumBenchmarks].Function = function;
+	s_NumBenchmarks += 1;
+}
+
+int32 FBenchmark::RunAll(int32 argc, char** argv)
+{
+	using namespace Fly3DPrivateBenchmark;
+
+	int32 numRun = 0;
+
+	for (int32 i = 0; i < s_NumBenchmarks; ++i)
+	{
+		if (!IsSelected(s_Benchmarks[i].Name, argc, argv))
+		{
+			continue;
+		}
+
+		printf("\n== %s ==\n", s_Benchmarks[i].Name);
+		printf("%-48s %12s %14s %12s\n", "", "ms", "Mitems/s", "GB/s");
+
+		s_Benchmarks[i].Function();
+		numRun += 1;
+	}
+
+	return numRun > 0 ? 0 : 1;
+}
+
+void FBenchmark::Report(const char* name, double seconds, uint64 numItems, uint64 numBytes)
+{
+	printf("%-48s %12.3f", name, seconds * 1000.0);
+
+	if (numItems > 0 && seconds > 0.0)
+	{
+		printf(" %14.2f", (double)numItems / seconds / 1e6);
+	}
+	else
+	{
+		printf(" %14s", "");
+	}
+
+	if (numBytes > 0 && seconds > 0.0)
+	{
+		printf(" %12.2f", (double)numBytes / seconds / 1e9);
+	}
+
+	printf("\n");
+	fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+	return FBenchmark::RunAll(argc, argv);
+}
\ No newline at end of file
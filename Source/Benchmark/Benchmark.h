@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformTime.h"
+
+typedef void (*FBenchmarkFunction)();
+
+/**
+* Micro benchmarks for the runtime, built into the console executable Fly3DBenchmark. IMPLEMENT_BENCHMARK registers
+* a function during static initialization; without arguments every benchmark runs, otherwise only those whose name
+* contains one of the arguments.
+*/
+class FBenchmark
+{
+public:
+
+	static void Register(const char* name, FBenchmarkFunction function);
+
+	static int32 RunAll(int32 argc, char** argv);
+
+	/** Prints one result row. Throughput columns are left empty when numItems or numBytes is 0. */
+	static void Report(const char* name, double seconds, uint64 numItems, uint64 numBytes = 0);
+
+	/** Runs function numRuns times and returns the fastest run in seconds. */
+	template <typename FunctionType>
+	static double MeasureBestOf(int32 numRuns, FunctionType function)
+	{
+		double best = 0.0;
+
+		for (int32 i = 0; i < numRuns; ++i)
+		{
+			double start = FPlatformTime::Seconds();
+			function();
+			double seconds = FPlatformTime::Seconds() - start;
+
+			if (i == 0 || seconds < best)
+			{
+				best = seconds;
+			}
+		}
+
+		return best;
+	}
+};
+
+struct FBenchmarkRegistrar
+{
+	FBenchmarkRegistrar(const char* name, FBenchmarkFunction function)
+	{
+		FBenchmark::Register(name, function);
+	}
+};
+
+#define IMPLEMENT_BENCHMARK(Name) \
+	static void Benchmark##Name(); \
+	static FBenchmarkRegistrar g_Benchmark##Name##Registrar(#Name, &Benchmark##Name); \
+	static void Benchmark##Name()
\ No newline at end of file
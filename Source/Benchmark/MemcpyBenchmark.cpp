@@ -0,0 +1,183 @@
+﻿#include "Benchmark/Benchmark.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Core/PlatformMemory.h"
+
+#include <stdio.h>
+
+namespace Fly3DPrivateMemcpyBenchmark
+{
+	enum
+	{
+		MIN_SIZE             = 256,
+		MAX_SIZE             = 64 * 1024 * 1024,
+		NUM_SIZES            = 19,
+
+		// Every measurement copies about this many bytes, repeating the copy on the same buffers.
+		BYTES_PER_RUN        = 128 * 1024 * 1024,
+		NUM_RUNS             = 3,
+
+		// A kernel has to be this many percent faster than memcpy to count as a win, smaller gaps are noise.
+		WIN_PERCENT          = 5,
+
+		// A crossover only counts once it holds for this many sizes in a row.
+		NUM_SIZES_TO_CONFIRM = 3
+	};
+
+	typedef void* (*FCopyFunction)(void* dest, const void* src, size_t count);
+
+	struct FWorkingSet
+	{
+		const uint8* Data;
+		size_t       Size;
+	};
+
+	// Keeps the working set reads from being optimized away.
+	static volatile uint64 s_Sink = 0;
+
+	static void* Memcpy(void* dest, const void* src, size_t count)
+	{
+		return FPlatformMemory::Memcpy(dest, src, count);
+	}
+
+	/** Reads one word per cache line, which is fast while the working set is cached and runs at memory latency once a copy evicted it. */
+	static uint64 TouchWorkingSet(const FWorkingSet& workingSet)
+	{
+		uint64 sum = 0;
+
+		for (size_t offset = 0; offset < workingSet.Size; offset += PLATFORM_CACHE_LINE_SIZE)
+		{
+			sum += *(const uint64*)(workingSet.Data + offset);
+		}
+
+		return sum;
+	}
+
+	/**
+	* Times copies of size bytes. With a working set, every copy is followed by a pass over it, so a copy that evicts the
+	* caller's data pays for reloading it, which a throughput-only measurement never sees.
+	*/
+	static void MeasureCopy(uint8* dest, const uint8* src, size_t size, const FWorkingSet* workingSet, FCopyFunction copy, const char* name, double& outSecondsPerCopy)
+	{
+		const size_t bytesPerIteration = size + (workingSet ? workingSet->Size : 0);
+		const size_t numIterations     = bytesPerIteration < BYTES_PER_RUN ? BYTES_PER_RUN / bytesPerIteration : 1;
+
+		const double seconds = FBenchmark::MeasureBestOf(NUM_RUNS, [&]()
+		{
+			uint64 sum = 0;
+
+			for (size_t n = 0; n < numIterations; ++n)
+			{
+				copy(dest, src, size);
+
+				if (workingSet)
+				{
+					sum += TouchWorkingSet(*workingSet);
+				}
+			}
+
+			s_Sink = s_Sink + sum;
+		});
+
+		AssertMsg(dest[size - 1] == src[size - 1], "Memcpy benchmark copied the wrong bytes\n");
+
+		char row[64];
+		snprintf(row, sizeof(row), "%-22s %9u bytes", name, (uint32)size);
+		FBenchmark::Report(row, seconds, 0, (uint64)(size * numIterations));
+
+		outSecondsPerCopy = seconds / numIterations;
+	}
+
+	/** Smallest size from which the kernel beats memcpy by WIN_PERCENT, or 0 if it never does. */
+	static size_t FindCrossover(const size_t* sizes, const double* memcpySeconds, const double* kernelSeconds, int32 numSizes)
+	{
+		int32 numInRow = 0;
+
+		for (int32 i = 0; i < numSizes; ++i)
+		{
+			const bool wins = kernelSeconds[i] * 100.0 <= memcpySeconds[i] * (100.0 - WIN_PERCENT);
+
+			numInRow = wins ? numInRow + 1 : 0;
+			if (numInRow == NUM_SIZES_TO_CONFIRM)
+			{
+				return sizes[i - NUM_SIZES_TO_CONFIRM + 1];
+			}
+		}
+
+		return 0;
+	}
+
+	static size_t CompareWithMemcpy(uint8* dest, const uint8* src, const FWorkingSet* workingSet, const char* kernelName, FCopyFunction kernel)
+	{
+		size_t sizes[NUM_SIZES];
+		double memcpySeconds[NUM_SIZES];
+		double kernelSeconds[NUM_SIZES];
+
+		for (int32 i = 0; i < NUM_SIZES; ++i)
+		{
+			sizes[i] = (size_t)MIN_SIZE << i;
+
+			MeasureCopy(dest, src, sizes[i], workingSet, Memcpy, "memcpy", memcpySeconds[i]);
+			MeasureCopy(dest, src, sizes[i], workingSet, kernel, kernelName, kernelSeconds[i]);
+		}
+
+		return FindCrossover(sizes, memcpySeconds, kernelSeconds, NUM_SIZES);
+	}
+}
+
+/**
+* Checks the size dispatch of BigBlockMemcpy and StreamingMemcpy against memcpy, a kernel only counts once it beats
+* memcpy by WIN_PERCENT. BigBlockMemcpy is measured on raw throughput. StreamingMemcpy is measured with a working set of
+* a quarter of the last level cache that is read after every copy, since what non-temporal stores buy is that working
+* set staying cached.
+*/
+IMPLEMENT_BENCHMARK(Memcpy)
+{
+	using namespace Fly3DPrivateMemcpyBenchmark;
+
+	const size_t cacheSize      = FPlatformMemory::GetLastLevelCacheSize();
+	const size_t workingSetSize = cacheSize / 4;
+
+	uint8* src     = (uint8*)FLY3D_MALLOC_ALIGNED(MAX_SIZE, PLATFORM_CACHE_LINE_SIZE, kMemTypeTemp);
+	uint8* dest    = (uint8*)FLY3D_MALLOC_ALIGNED(MAX_SIZE, PLATFORM_CACHE_LINE_SIZE, kMemTypeTemp);
+	uint8* working = (uint8*)FLY3D_MALLOC_ALIGNED(workingSetSize, PLATFORM_CACHE_LINE_SIZE, kMemTypeTemp);
+
+	for (size_t i = 0; i < MAX_SIZE; ++i)
+	{
+		src[i]  = (uint8)i;
+		dest[i] = 0;
+	}
+
+	FPlatformMemory::Memset(working, 1, workingSetSize);
+
+	const size_t bigBlockWin = CompareWithMemcpy(dest, src, nullptr, "BigBlockMemcpyKernel", FPlatformMemory::BigBlockMemcpyKernel);
+
+	if (bigBlockWin == 0)
+	{
+		printf("BigBlockMemcpyKernel never beat memcpy by %u%% up to %u bytes, keep BigBlockMemcpy on memcpy\n\n", (uint32)WIN_PERCENT, (uint32)MAX_SIZE);
+	}
+	else
+	{
+		printf("BigBlockMemcpyKernel beats memcpy by %u%% from %u bytes\n\n", (uint32)WIN_PERCENT, (uint32)bigBlockWin);
+	}
+
+	FWorkingSet workingSet;
+	workingSet.Data = working;
+	workingSet.Size = workingSetSize;
+
+	const size_t streamingCrossover = CompareWithMemcpy(dest, src, &workingSet, "StreamingMemcpyKernel", FPlatformMemory::StreamingMemcpyKernel);
+
+	printf("Last level cache %u bytes, StreamingMemcpy switches at %u bytes, ", (uint32)cacheSize, (uint32)FPlatformMemory::GetStreamingMemcpyMinSize());
+
+	if (streamingCrossover == 0)
+	{
+		printf("the kernel never beat memcpy by %u%% up to %u bytes\n\n", (uint32)WIN_PERCENT, (uint32)MAX_SIZE);
+	}
+	else
+	{
+		printf("the kernel beats memcpy by %u%% from %u bytes\n\n", (uint32)WIN_PERCENT, (uint32)streamingCrossover);
+	}
+
+	FLY3D_FREE(working);
+	FLY3D_FREE(dest);
+	FLY3D_FREE(src);
+}
\ No newline at end of file
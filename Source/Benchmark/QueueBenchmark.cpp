@@ -0,0 +1,205 @@
+﻿#include "Benchmark/Benchmark.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/MpmcQueue.h"
+#include "Runtime/Core/Containers/SpscQueue.h"
+#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#include <deque>
+#include <stdio.h>
+#include <thread>
+
+namespace Fly3DPrivateQueueBenchmark
+{
+	enum
+	{
+		NUM_ITEMS      = 1 << 22,
+		QUEUE_CAPACITY = 1024,
+
+		// Failed attempts before a thread yields, so runs with more threads than cores still make progress.
+		SPIN_LIMIT     = 64
+	};
+
+	/** Mutex protected bounded queue, the baseline the lock-free queues are measured against. */
+	class FLockedQueue
+	{
+	public:
+
+		explicit FLockedQueue(uint32 capacity)
+			: m_Capacity(capacity)
+		{
+
+		}
+
+		bool Push(uint64 item)
+		{
+			TScopeLock<FMutex> lock(m_Mutex);
+
+			if (m_Items.size() == m_Capacity)
+			{
+				return false;
+			}
+
+			m_Items.push_back(item);
+			return true;
+		}
+
+		bool Pop(uint64& outItem)
+		{
+			TScopeLock<FMutex> lock(m_Mutex);
+
+			if (m_Items.empty())
+			{
+				return false;
+			}
+
+			outItem = m_Items.front();
+			m_Items.pop_front();
+			return true;
+		}
+
+	private:
+
+		FMutex				m_Mutex;
+		std::deque<uint64>	m_Items;
+		size_t				m_Capacity;
+	};
+
+	static FORCE_INLINE void Backoff(int32& numFailures)
+	{
+		if (++numFailures < SPIN_LIMIT)
+		{
+			FPlatformAtomics::Pause();
+		}
+		else
+		{
+			FPlatformAtomics::YieldThread();
+			numFailures = 0;
+		}
+	}
+
+	static void WaitForGate(volatile int32* gate)
+	{
+		while (FPlatformAtomics::AtomicRead(gate, EMemoryOrder::Acquire) == 0)
+		{
+			FPlatformAtomics::YieldThread();
+		}
+	}
+
+	/** Moves NUM_ITEMS through the queue with the given number of producer and consumer threads, returns the wall time. */
+	template <typename QueueType>
+	static double RunProducersConsumers(QueueType& queue, int32 numProducers, int32 numConsumers)
+	{
+		Assert(NUM_ITEMS % numProducers == 0);
+
+		volatile int32 gate         = 0;
+		volatile int32 numProducing = numProducers;
+		volatile int64 checksum     = 0;
+
+		const uint64 itemsPerProducer = NUM_ITEMS / numProducers;
+
+		TArray<std::thread> threads;
+
+		for (int32 p = 0; p < numProducers; ++p)
+		{
+			threads.Emplace([&, p]()
+			{
+				WaitForGate(&gate);
+
+				int32 numFailures = 0;
+				for (uint64 i = 1; i <= itemsPerProducer; ++i)
+				{
+					while (!queue.Push(p * itemsPerProducer + i))
+					{
+						Backoff(numFailures);
+					}
+				}
+
+				FPlatformAtomics::InterlockedDecrement(&numProducing);
+			});
+		}
+
+		for (int32 c = 0; c < numConsumers; ++c)
+		{
+			threads.Emplace([&]()
+			{
+				WaitForGate(&gate);
+
+				int64 sum = 0;
+				int32 numFailures = 0;
+				uint64 item;
+
+				for (;;)
+				{
+					if (queue.Pop(item))
+					{
+						sum += (int64)item;
+						continue;
+					}
+
+					// Nothing is pushed once every producer is done, so one more failed Pop means the queue is drained.
+					if (FPlatformAtomics::AtomicRead(&numProducing, EMemoryOrder::Acquire) == 0)
+					{
+						if (!queue.Pop(item))
+						{
+							break;
+						}
+
+						sum += (int64)item;
+						continue;
+					}
+
+					Backoff(numFailures);
+				}
+
+				FPlatformAtomics::InterlockedAdd(&checksum, sum);
+			});
+		}
+
+		double start = FPlatformTime::Seconds();
+		FPlatformAtomics::AtomicStore(&gate, 1, EMemoryOrder::Release);
+
+		for (int32 i = 0; i < threads.Num(); ++i)
+		{
+			threads[i].join();
+		}
+
+		double seconds = FPlatformTime::Seconds() - start;
+
+		AssertMsg(checksum == (int64)NUM_ITEMS * (NUM_ITEMS + 1) / 2, "Queue benchmark lost or duplicated items\n");
+
+		return seconds;
+	}
+
+	template <typename QueueType>
+	static void ReportProducersConsumers(const char* queueName, int32 numProducers, int32 numConsumers)
+	{
+		QueueType queue(QUEUE_CAPACITY);
+		double seconds = RunProducersConsumers(queue, numProducers, numConsumers);
+
+		char name[64];
+		snprintf(name, sizeof(name), "%s %dP/%dC", queueName, numProducers, numConsumers);
+
+		FBenchmark::Report(name, seconds, NUM_ITEMS, (uint64)NUM_ITEMS * sizeof(uint64));
+	}
+}
+
+IMPLEMENT_BENCHMARK(SpscQueue)
+{
+	using namespace Fly3DPrivateQueueBenchmark;
+
+	ReportProducersConsumers<TSpscQueue<uint64>>("TSpscQueue", 1, 1);
+	ReportProducersConsumers<TMpmcQueue<uint64>>("TMpmcQueue", 1, 1);
+	ReportProducersConsumers<FLockedQueue>("FMutex + std::deque", 1, 1);
+}
+
+IMPLEMENT_BENCHMARK(MpmcQueue)
+{
+	using namespace Fly3DPrivateQueueBenchmark;
+
+	for (int32 numThreads = 2; numThreads <= 4; numThreads *= 2)
+	{
+		ReportProducersConsumers<TMpmcQueue<uint64>>("TMpmcQueue", numThreads, numThreads);
+		ReportProducersConsumers<FLockedQueue>("FMutex + std::deque", numThreads, numThreads);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+﻿#include "Benchmark/Benchmark.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Template/SharedPointer.h"
+
+#include <memory>
+#include <stdio.h>
+#include <thread>
+
+namespace Fly3DPrivateSharedPointerBenchmark
+{
+	enum
+	{
+		NUM_OBJECTS = 1 << 22,
+		NUM_RUNS    = 3,
+
+		// Objects alive at once per thread, so the pool recycles blocks the way a frame's worth of short lived objects would.
+		BATCH_SIZE  = 256
+	};
+
+	struct FPayload
+	{
+		explicit FPayload(uint64 value)
+			: Value(value)
+		{
+
+		}
+
+		uint64 Value;
+		uint64 Padding[3];
+	};
+
+	template <ESPMode Mode>
+	struct TMakeShared
+	{
+		typedef TSharedPtr<FPayload, Mode> PtrType;
+
+		static FORCE_INLINE PtrType Make(uint64 value)
+		{
+			return MakeShared<FPayload, Mode>(value);
+		}
+	};
+
+	struct FStdMakeShared
+	{
+		typedef std::shared_ptr<FPayload> PtrType;
+
+		static FORCE_INLINE PtrType Make(uint64 value)
+		{
+			return std::make_shared<FPayload>(value);
+		}
+	};
+
+	/** Creates and releases numObjects objects in batches, returns the sum of their values. */
+	template <typename FactoryType>
+	static uint64 Churn(uint64 numObjects)
+	{
+		typename FactoryType::PtrType batch[BATCH_SIZE];
+		uint64 sum = 0;
+
+		for (uint64 first = 0; first < numObjects; first += BATCH_SIZE)
+		{
+			for (int32 i = 0; i < BATCH_SIZE; ++i)
+			{
+				batch[i] = FactoryType::Make(first + i);
+			}
+
+			for (int32 i = 0; i < BATCH_SIZE; ++i)
+			{
+				sum += batch[i]->Value;
+				batch[i] = typename FactoryType::PtrType();
+			}
+		}
+
+		return sum;
+	}
+
+	/** Runs Churn on numThreads threads at once, NUM_OBJECTS in total, and returns the wall time. */
+	template <typename FactoryType>
+	static double RunChurn(int32 numThreads)
+	{
+		Assert(NUM_OBJECTS % (numThreads * BATCH_SIZE) == 0);
+
+		volatile int32 gate     = 0;
+		volatile int64 checksum = 0;
+
+		const uint64 objectsPerThread = NUM_OBJECTS / numThreads;
+
+		TArray<std::thread> threads;
+
+		for (int32 t = 0; t < numThreads; ++t)
+		{
+			threads.Emplace([&]()
+			{
+				while (FPlatformAtomics::AtomicRead(&gate, EMemoryOrder::Acquire) == 0)
+				{
+					FPlatformAtomics::YieldThread();
+				}
+
+				FPlatformAtomics::InterlockedAdd(&checksum, (int64)Churn<FactoryType>(objectsPerThread));
+			});
+		}
+
+		double start = FPlatformTime::Seconds();
+		FPlatformAtomics::AtomicStore(&gate, 1, EMemoryOrder::Release);
+
+		for (int32 i = 0; i < threads.Num(); ++i)
+		{
+			threads[i].join();
+		}
+
+		double seconds = FPlatformTime::Seconds() - start;
+
+		AssertMsg(checksum == (int64)numThreads * (int64)(objectsPerThread * (objectsPerThread - 1) / 2), "Shared pointer benchmark lost objects\n");
+
+		return seconds;
+	}
+
+	template <typename FactoryType>
+	static void ReportChurn(const char* factoryName, int32 numThreads)
+	{
+		const double seconds = FBenchmark::MeasureBestOf(NUM_RUNS, [&]()
+		{
+			RunChurn<FactoryType>(numThreads);
+		});
+
+		char name[64];
+		snprintf(name, sizeof(name), "%s %d thread%s", factoryName, numThreads, numThreads == 1 ? "" : "s");
+
+		FBenchmark::Report(name, seconds, NUM_OBJECTS);
+	}
+}
+
+/**
+* Creates and releases small objects through MakeShared, whose reference controllers come from the pooled size
+* classes, and through std::make_shared on the CRT heap. More threads than one contend on the size class locks.
+*/
+IMPLEMENT_BENCHMARK(SharedPointer)
+{
+	using namespace Fly3DPrivateSharedPointerBenchmark;
+
+	ReportChurn<TMakeShared<ESPMode::ThreadUnSafe>>("MakeShared ThreadUnSafe", 1);
+	ReportChurn<TMakeShared<ESPMode::ThreadSafe>>("MakeShared ThreadSafe", 1);
+	ReportChurn<FStdMakeShared>("std::make_shared", 1);
+
+	ReportChurn<TMakeShared<ESPMode::ThreadSafe>>("MakeShared ThreadSafe", 4);
+	ReportChurn<FStdMakeShared>("std::make_shared", 4);
+}
\ No newline at end of file
@@ -25,4 +25,9 @@ bool FBaseAllocator::TryDeallocate(const void* p)
 	Deallocate(p);
 
 	return true;
+}
+
+bool FBaseAllocator::TryExpandInPlace(void* p, uint32 size)
+{
+	return false;
 }
\ No newline at end of file
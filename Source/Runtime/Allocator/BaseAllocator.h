@@ -31,6 +31,9 @@ public:
 
 	virtual bool TryDeallocate(const void* p);
 
+	/** Resizes the allocation at p without moving it. Returns false if the allocator cannot do so. */
+	virtual bool TryExpandInPlace(void* p, uint32 size);
+
 	virtual uint32 GetAllocatedMemorySize() const 
 	{ 
 		return m_TotalAllocatedBytes;
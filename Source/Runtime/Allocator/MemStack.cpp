@@ -0,0 +1,105 @@
+﻿#include "Runtime/Allocator/MemStack.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+
+FMemStack::FMemStack(uint32 chunkSize)
+	: m_Top(nullptr)
+	, m_End(nullptr)
+	, m_TopChunk(nullptr)
+	, m_UnusedChunks(nullptr)
+	, m_ChunkSize(chunkSize)
+	, m_NumMarks(0)
+{
+
+}
+
+FMemStack::~FMemStack()
+{
+	Assert(m_NumMarks == 0);
+
+	FreeChunks(nullptr);
+
+	while (m_UnusedChunks)
+	{
+		FChunk* chunk = m_UnusedChunks;
+		m_UnusedChunks = chunk->Next;
+		FLY3D_FREE(chunk);
+	}
+}
+
+FMemStack& FMemStack::Get()
+{
+	static thread_local FMemStack s_MemStack;
+	return s_MemStack;
+}
+
+bool FMemStack::TryGrowTop(void* ptr, size_t oldSize, size_t newSize)
+{
+	if ((uint8*)ptr + oldSize != m_Top || (uint8*)ptr + newSize > m_End)
+	{
+		return false;
+	}
+
+	m_Top = (uint8*)ptr + newSize;
+	return true;
+}
+
+size_t FMemStack::GetByteCount() const
+{
+	size_t count = 0;
+	for (FChunk* chunk = m_TopChunk; chunk; chunk = chunk->Next)
+	{
+		count += chunk == m_TopChunk ? (size_t)(m_Top - chunk->Data()) : chunk->DataSize;
+	}
+
+	return count;
+}
+
+void* FMemStack::AllocateFromNewChunk(size_t size, size_t align)
+{
+	const size_t needed = size + align;
+
+	FChunk* chunk = nullptr;
+	if (needed <= m_ChunkSize && m_UnusedChunks)
+	{
+		chunk = m_UnusedChunks;
+		m_UnusedChunks = chunk->Next;
+	}
+	else
+	{
+		// Oversized requests get a chunk of their own, it is freed rather than recycled when popped.
+		const size_t dataSize = needed > m_ChunkSize ? needed : m_ChunkSize;
+		chunk = (FChunk*)FLY3D_MALLOC(sizeof(FChunk) + dataSize, kMemTypeMemStack);
+		chunk->DataSize = dataSize;
+	}
+
+	chunk->Next = m_TopChunk;
+	m_TopChunk  = chunk;
+	m_End       = chunk->Data() + chunk->DataSize;
+
+	uint8* result = (uint8*)(((size_t)chunk->Data() + (align - 1)) & ~(align - 1));
+	m_Top = result + size;
+
+	return result;
+}
+
+void FMemStack::FreeChunks(FChunk* newTopChunk)
+{
+	while (m_TopChunk != newTopChunk)
+	{
+		FChunk* chunk = m_TopChunk;
+		m_TopChunk = chunk->Next;
+
+		if (chunk->DataSize == m_ChunkSize)
+		{
+			chunk->Next = m_UnusedChunks;
+			m_UnusedChunks = chunk;
+		}
+		else
+		{
+			FLY3D_FREE(chunk);
+		}
+	}
+
+	m_Top = nullptr;
+	m_End = nullptr;
+}
\ No newline at end of file
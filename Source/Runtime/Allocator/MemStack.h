@@ -0,0 +1,139 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/Noncopyable.h"
+
+class FMemMark;
+
+/**
+* Linear allocator for short-lived data such as per-frame strings. Memory is bumped off the top of a chunk
+* and released all at once when the enclosing FMemMark goes out of scope; individual allocations are never
+* freed. Released chunks are kept for reuse, so a steady frame does not touch the heap at all.
+*/
+class FMemStack : public Noncopyable
+{
+	friend class FMemMark;
+
+public:
+
+	enum
+	{
+		DEFAULT_CHUNK_SIZE = 64 * 1024,
+	};
+
+public:
+
+	explicit FMemStack(uint32 chunkSize = DEFAULT_CHUNK_SIZE);
+
+	~FMemStack();
+
+	/** The calling thread's stack. A job running on a fiber must call it again after FJobSystem::Wait, see FJobSystem. */
+	static FMemStack& Get();
+
+	FORCE_INLINE void* PushBytes(size_t size, size_t align)
+	{
+		AssertMsg(m_NumMarks > 0, "FMemStack allocation without a FMemMark in scope\n");
+
+		uint8* result = (uint8*)(((size_t)m_Top + (align - 1)) & ~(align - 1));
+		if (m_Top != nullptr && result + size <= m_End)
+		{
+			m_Top = result + size;
+			return result;
+		}
+
+		return AllocateFromNewChunk(size, align);
+	}
+
+	template <typename T>
+	FORCE_INLINE T* PushArray(size_t count)
+	{
+		return (T*)PushBytes(count * sizeof(T), alignof(T));
+	}
+
+	/** Grows the latest allocation without moving it. Only possible while it is on top and its chunk has room. */
+	bool TryGrowTop(void* ptr, size_t oldSize, size_t newSize);
+
+	FORCE_INLINE int32 GetNumMarks() const
+	{
+		return m_NumMarks;
+	}
+
+	/** Bytes handed out since the outermost mark, alignment padding and chunk tails included. */
+	size_t GetByteCount() const;
+
+private:
+
+	struct FChunk
+	{
+		FChunk* Next;
+		size_t  DataSize;
+
+		FORCE_INLINE uint8* Data()
+		{
+			return (uint8*)(this + 1);
+		}
+	};
+
+	void* AllocateFromNewChunk(size_t size, size_t align);
+
+	/** Pops every chunk above newTopChunk. */
+	void FreeChunks(FChunk* newTopChunk);
+
+private:
+
+	uint8*  m_Top;
+	uint8*  m_End;
+	FChunk* m_TopChunk;
+	FChunk* m_UnusedChunks;
+	uint32  m_ChunkSize;
+	int32   m_NumMarks;
+};
+
+/** Everything pushed onto the stack after this mark was taken is released when the mark is destroyed. */
+class FMemMark : public Noncopyable
+{
+public:
+
+	explicit FMemMark(FMemStack& stack)
+		: m_Stack(stack)
+		, m_Top(stack.m_Top)
+		, m_End(stack.m_End)
+		, m_SavedChunk(stack.m_TopChunk)
+		, m_Popped(false)
+	{
+		m_Stack.m_NumMarks += 1;
+	}
+
+	~FMemMark()
+	{
+		Pop();
+	}
+
+	void Pop()
+	{
+		if (m_Popped)
+		{
+			return;
+		}
+
+		Assert(m_Stack.m_NumMarks > 0);
+		m_Popped = true;
+		m_Stack.m_NumMarks -= 1;
+
+		if (m_SavedChunk != m_Stack.m_TopChunk)
+		{
+			m_Stack.FreeChunks(m_SavedChunk);
+		}
+
+		m_Stack.m_Top = m_Top;
+		m_Stack.m_End = m_End;
+	}
+
+private:
+
+	FMemStack&          m_Stack;
+	uint8*              m_Top;
+	uint8*              m_End;
+	FMemStack::FChunk*  m_SavedChunk;
+	bool                m_Popped;
+};
\ No newline at end of file
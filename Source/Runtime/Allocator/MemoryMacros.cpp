@@ -18,6 +18,11 @@ namespace Fly3DPrivateMemory
 	{
 		return GetAllocator()->Deallocate(p);
 	}
+
+	bool TryExpandInPlace(void* p, uint32 size)
+	{
+		return GetAllocator()->TryExpandInPlace(p, size);
+	}
 }
 
 void* operator new(size_t size, size_t align, EAllocatorType type, const char* file, int32 line)
@@ -18,13 +18,38 @@ namespace Fly3DPrivateMemory
 
 	bool Deallocate(const void* p);
 
+	bool TryExpandInPlace(void* p, uint32 size);
+
+	/** The allocation starts at the most derived object, which a pointer to a polymorphic base need not point to. */
+	template <bool IsPolymorphic>
+	struct TAllocationStart
+	{
+		template <typename T>
+		static FORCE_INLINE const void* Get(T* ptr)
+		{
+			return ptr;
+		}
+	};
+
+	template <>
+	struct TAllocationStart<true>
+	{
+		template <typename T>
+		static FORCE_INLINE const void* Get(T* ptr)
+		{
+			return dynamic_cast<const void*>(ptr);
+		}
+	};
+
+	/** Runs the destructor, virtually if T has one, and frees the block the object was allocated in. */
 	template<typename T>
 	FORCE_INLINE void Delete(T* ptr)
 	{
 		if (ptr)
 		{
+			const void* block = TAllocationStart<__is_polymorphic(T)>::Get(ptr);
 			ptr->~T();
-			Deallocate(ptr);
+			Deallocate(block);
 		}
 	}
 }
@@ -43,4 +68,5 @@ void operator delete[](void* p, size_t align, EAllocatorType type, const char* f
 #define FLY3D_MALLOC_ALIGNED(size, align, label)		Fly3DPrivateMemory::Allocate((uint32)(size), (uint32)(align), label, __FILE__, __LINE__)
 #define FLY3D_REALLOC(ptr, size, label)					Fly3DPrivateMemory::Reallocate(ptr, (uint32)(size), FBaseAllocator::DEFAULT_ALIGN_SIZE, label, __FILE__, __LINE__)
 #define FLY3D_REALLOC_ALIGNED(ptr, size, align, label)	Fly3DPrivateMemory::Reallocate(ptr, (uint32)(size), (uint32)(align), label, __FILE__, __LINE__)
+#define FLY3D_EXPAND_IN_PLACE(ptr, size)				Fly3DPrivateMemory::TryExpandInPlace(ptr, (uint32)(size))
 #define FLY3D_FREE(ptr)									Fly3DPrivateMemory::Deallocate(ptr)
\ No newline at end of file
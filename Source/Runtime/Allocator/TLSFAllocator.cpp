@@ -66,26 +66,38 @@ const FMemorySalt* FTLSFAllocator::GetMemorySalt(const void* p) const
 	return salt->owner == this ? salt : nullptr;
 }
 
-void* FTLSFAllocator::Allocate(uint32 reqSize, uint32 align, EAllocatorType type, const char* file, int32 line)
+namespace Fly3DPrivateTLSFAllocator
+{
+	/** Salt plus the padding in front of it that puts the returned pointer on an align boundary. */
+	static FORCE_INLINE size_t GetHeaderSize(uint32 align)
+	{
+		return AlignUp(sizeof(FMemorySalt), (size_t)FMath::Max(align, (uint32)FBaseAllocator::DEFAULT_ALIGN_SIZE));
+	}
+}
+
+void* FTLSFAllocator::AllocateLocked(uint32 reqSize, uint32 align, EAllocatorType type, const char* file, int32 line)
 {
-	Assert(reqSize < TLSF_Pool_Size - sizeof(FMemorySalt));
-	
 	if (m_Tlsf == nullptr)
 	{
 		m_Tlsf = tlsf_create_with_pool(MallocBlock(), TLSF_Pool_Size);
 	}
 
-	size_t realSize = AlignUp((size_t)(reqSize + sizeof(FMemorySalt)), (size_t)align);
-	void* mem = tlsf_malloc(m_Tlsf, realSize);
+	align = FMath::Max(align, (uint32)DEFAULT_ALIGN_SIZE);
+
+	size_t headerSize = Fly3DPrivateTLSFAllocator::GetHeaderSize(align);
+	size_t realSize   = headerSize + reqSize;
+	void* mem = tlsf_memalign(m_Tlsf, align, realSize);
 
 	if (!mem)
 	{
 		tlsf_add_pool(m_Tlsf, MallocBlock(), TLSF_Pool_Size);
-		mem = tlsf_malloc(m_Tlsf, realSize);
+		mem = tlsf_memalign(m_Tlsf, align, realSize);
 	}
 
-	FMemorySalt* salt = (FMemorySalt*)mem;
-	salt->Fill((uint32)realSize, type, this, file, line);
+	uint8* result = (uint8*)mem + headerSize;
+
+	FMemorySalt* salt = (FMemorySalt*)(result - sizeof(FMemorySalt));
+	salt->Fill((uint32)realSize, (uint32)(headerSize - sizeof(FMemorySalt)), type, this, file, line);
 
 	m_NumAllocations      += 1;
 	m_TotalAllocatedBytes += (uint32)realSize;
@@ -95,7 +107,28 @@ void* FTLSFAllocator::Allocate(uint32 reqSize, uint32 align, EAllocatorType type
 	GetMemoryProfiler()->RegisterAllocation(salt);
 #endif
 
-	return (uint8*)mem + sizeof(FMemorySalt);
+	return result;
+}
+
+void FTLSFAllocator::DeallocateLocked(const FMemorySalt* salt)
+{
+	m_NumAllocations      -= 1;
+	m_TotalAllocatedBytes -= salt->size;
+
+#if ENABLE_MEM_PROFILER
+	GetMemoryProfiler()->UnRegisterAllocation(salt);
+#endif
+
+	tlsf_free(m_Tlsf, salt->GetBlock());
+}
+
+void* FTLSFAllocator::Allocate(uint32 reqSize, uint32 align, EAllocatorType type, const char* file, int32 line)
+{
+	Assert(reqSize < TLSF_Pool_Size - Fly3DPrivateTLSFAllocator::GetHeaderSize(align));
+
+	TScopeLock<FMutex> lock(m_Mutex);
+
+	return AllocateLocked(reqSize, align, type, file, line);
 }
 
 void* FTLSFAllocator::Reallocate(void* p, uint32 reqSize, uint32 align, EAllocatorType type, const char* file, int32 line)
@@ -103,6 +136,29 @@ void* FTLSFAllocator::Reallocate(void* p, uint32 reqSize, uint32 align, EAllocat
 	const FMemorySalt* temp = GetMemorySalt(p);
 	Assert(temp);
 
+	TScopeLock<FMutex> lock(m_Mutex);
+
+	align = FMath::Max(align, (uint32)DEFAULT_ALIGN_SIZE);
+
+	size_t headerSize = Fly3DPrivateTLSFAllocator::GetHeaderSize(align);
+	size_t realSize   = headerSize + reqSize;
+	void* block = temp->GetBlock();
+
+	// tlsf_realloc may move the block and only keeps the tlsf alignment, larger alignments can only be resized in place.
+	bool resizeInPlace = align > tlsf_align_size();
+	bool sameLayout    = headerSize == temp->offset + sizeof(FMemorySalt);
+
+	if (!sameLayout || (resizeInPlace && (((size_t)p & (align - 1)) != 0 || !tlsf_expand_in_place(m_Tlsf, block, realSize))))
+	{
+		uint32 oldSize = temp->size - temp->offset - sizeof(FMemorySalt);
+
+		void* result = AllocateLocked(reqSize, align, type, file, line);
+		memcpy(result, p, FMath::Min(oldSize, reqSize));
+		DeallocateLocked(temp);
+
+		return result;
+	}
+
 #if ENABLE_MEM_PROFILER
 	GetMemoryProfiler()->UnRegisterAllocation(temp);
 #endif
@@ -110,16 +166,21 @@ void* FTLSFAllocator::Reallocate(void* p, uint32 reqSize, uint32 align, EAllocat
 	m_TotalAllocatedBytes -= temp->size;
 	m_PeakAllocatedBytes  -= temp->size;
 
-	size_t realSize = AlignUp((size_t)(reqSize + sizeof(FMemorySalt)), (size_t)align);
-	void* mem = tlsf_realloc(m_Tlsf, (void*)temp, realSize);
-	if (!mem)
+	void* mem = block;
+	if (!resizeInPlace)
 	{
-		tlsf_add_pool(m_Tlsf, MallocBlock(), TLSF_Pool_Size);
-		mem = tlsf_realloc(m_Tlsf, (void*)temp, realSize);
+		mem = tlsf_realloc(m_Tlsf, block, realSize);
+		if (!mem)
+		{
+			tlsf_add_pool(m_Tlsf, MallocBlock(), TLSF_Pool_Size);
+			mem = tlsf_realloc(m_Tlsf, block, realSize);
+		}
 	}
 
-	FMemorySalt* salt = (FMemorySalt*)mem;
-	salt->Fill((uint32)realSize, type, this, file, line);
+	uint8* result = (uint8*)mem + headerSize;
+
+	FMemorySalt* salt = (FMemorySalt*)(result - sizeof(FMemorySalt));
+	salt->Fill((uint32)realSize, (uint32)(headerSize - sizeof(FMemorySalt)), type, this, file, line);
 
 	m_TotalAllocatedBytes += salt->size;
 	m_PeakAllocatedBytes  += salt->size;
@@ -128,7 +189,7 @@ void* FTLSFAllocator::Reallocate(void* p, uint32 reqSize, uint32 align, EAllocat
 	GetMemoryProfiler()->RegisterAllocation(salt);
 #endif
 
-	return mem;
+	return result;
 }
 
 bool FTLSFAllocator::Deallocate(const void* p)
@@ -141,14 +202,41 @@ bool FTLSFAllocator::Deallocate(const void* p)
 		return false;
 	}
 
-	m_NumAllocations      -= 1;
-	m_TotalAllocatedBytes -= salt->size;
+	TScopeLock<FMutex> lock(m_Mutex);
+
+	DeallocateLocked(salt);
+	return true;
+}
+
+bool FTLSFAllocator::TryExpandInPlace(void* p, uint32 reqSize)
+{
+	FMemorySalt* salt = (FMemorySalt*)GetMemorySalt(p);
+	Assert(salt);
+
+	TScopeLock<FMutex> lock(m_Mutex);
+
+	size_t realSize = AlignUp((size_t)(salt->offset + sizeof(FMemorySalt) + reqSize), (size_t)DEFAULT_ALIGN_SIZE);
+	if (!tlsf_expand_in_place(m_Tlsf, salt->GetBlock(), realSize))
+	{
+		return false;
+	}
 
 #if ENABLE_MEM_PROFILER
 	GetMemoryProfiler()->UnRegisterAllocation(salt);
 #endif
 
-	tlsf_free(m_Tlsf, (void*)salt);
+	m_TotalAllocatedBytes -= salt->size;
+	m_PeakAllocatedBytes  -= salt->size;
+
+	salt->size = (uint32)realSize;
+
+	m_TotalAllocatedBytes += salt->size;
+	m_PeakAllocatedBytes  += salt->size;
+
+#if ENABLE_MEM_PROFILER
+	GetMemoryProfiler()->RegisterAllocation(salt);
+#endif
+
 	return true;
 }
 
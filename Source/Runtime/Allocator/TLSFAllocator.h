@@ -2,7 +2,9 @@
 
 #include "Runtime/Allocator/BaseAllocator.h"
 #include "Runtime/Profiler/MemoryProfiler.h"
+#include "Runtime/Core/HAL/Mutex.h"
 
+/** Thread safe, every call holds m_Mutex. */
 class FTLSFAllocator : public FBaseAllocator
 {
 	enum 
@@ -29,15 +31,24 @@ public:
 
 	virtual bool Contains(const void* p) const override;
 
+	virtual bool TryExpandInPlace(void* p, uint32 size) override;
+
 	const FMemorySalt* GetMemorySalt(const void* p) const;
 
 private:
 
 	void* MallocBlock();
 
+	void* AllocateLocked(uint32 size, uint32 align, EAllocatorType type, const char* file, int32 line);
+
+	void DeallocateLocked(const FMemorySalt* salt);
+
 private:
 
 	void* m_Tlsf;
 	int32 m_PoolNum;
 	void* m_Pools[TLSF_Pool_Count];
+
+	// Also serializes the memory profiler, which is only called from here.
+	FMutex m_Mutex;
 };
\ No newline at end of file
@@ -7,7 +7,11 @@
 #include "Runtime/Template/AreTypesEqual.h"
 #include "Runtime/Template/TypeTraits.h"
 #include "Runtime/Template/MemoryOps.h"
+#include "Runtime/Template/BinaryHeap.h"
+#include "Runtime/Template/Less.h"
+#include "Runtime/Template/VectorOps.h"
 #include "Runtime/Core/HAL/FlyMemory.h"
+#include "Runtime/Profiler/ContainerSlackTracker.h"
 
 #include <initializer_list>
 
@@ -329,6 +333,14 @@ public:
 		return m_AllocatorInstance.GetAllocatedSize(m_ArrayMax, sizeof(ElementType));
 	}
 
+#if ENABLE_CONTAINER_SLACK_TRACKING
+	/** Bytes this array last reported to the memory profiler and their high-water marks. */
+	FORCE_INLINE const FContainerSlackTracker& GetSlackTracker() const
+	{
+		return m_SlackTracker;
+	}
+#endif
+
 	SizeType GetSlack() const
 	{
 		return m_ArrayMax - m_ArrayNum;
@@ -431,20 +443,9 @@ public:
 		return index != INDEX_NONE;
 	}
 
-	SizeType Find(const ElementType& item) const
+	FORCE_INLINE SizeType Find(const ElementType& item) const
 	{
-		const ElementType* start   = GetData();
-		const ElementType* dataEnd = start + m_ArrayNum;
-
-		for (const ElementType* data = start; data != dataEnd; ++data)
-		{
-			if (*data == item)
-			{
-				return static_cast<SizeType>(data - start);
-			}
-		}
-
-		return INDEX_NONE;
+		return FindItem(GetData(), m_ArrayNum, item);
 	}
 
 	bool FindLast(const ElementType& item, SizeType& index) const
@@ -453,21 +454,9 @@ public:
 		return index != INDEX_NONE;
 	}
 
-	SizeType FindLast(const ElementType& item) const
+	FORCE_INLINE SizeType FindLast(const ElementType& item) const
 	{
-		const ElementType* start = GetData();
-		const ElementType* data  = start + m_ArrayNum;
-
-		while (data != start)
-		{
-			--data;
-			if (*data == item)
-			{
-				return static_cast<SizeType>(data - start);
-			}
-		}
-
-		return INDEX_NONE;
+		return FindLastItem(GetData(), m_ArrayNum, item);
 	}
 
 	template <typename predicate>
@@ -612,6 +601,31 @@ public:
 		return false;
 	}
 
+	FORCE_INLINE bool Contains(const ElementType& item) const
+	{
+		return FindItem(GetData(), m_ArrayNum, item) != INDEX_NONE;
+	}
+
+	/** Returns how many elements are equal to item. */
+	FORCE_INLINE SizeType Count(const ElementType& item) const
+	{
+		return CountItems(GetData(), m_ArrayNum, item);
+	}
+
+	/** Returns the smallest element by operator<. The array must not be empty. */
+	FORCE_INLINE ElementType MinElement() const
+	{
+		RangeCheck(0);
+		return MinOfItems(GetData(), m_ArrayNum);
+	}
+
+	/** Returns the largest element by operator<. The array must not be empty. */
+	FORCE_INLINE ElementType MaxElement() const
+	{
+		RangeCheck(0);
+		return MaxOfItems(GetData(), m_ArrayNum);
+	}
+
 	template <typename predicate>
 	FORCE_INLINE bool ContainsByPredicate(predicate pred) const
 	{
@@ -641,6 +655,8 @@ public:
 			ResizeGrow(oldNum);
 		}
 
+		TrackSlack();
+
 		return oldNum;
 	}
 
@@ -714,6 +730,7 @@ public:
 		RelocateConstructItems<ElementType>(GetData() + inIndex, items.GetData(), numNewElements);
 
 		items.m_ArrayNum = 0;
+		items.TrackSlack();
 
 		return inIndex;
 	}
@@ -805,6 +822,7 @@ public:
 		{
 			DestructItems(GetData(), m_ArrayNum);
 			m_ArrayNum = 0;
+			TrackSlack();
 		}
 		else
 		{
@@ -824,6 +842,8 @@ public:
 		{
 			ResizeTo(slack);
 		}
+
+		TrackSlack();
 	}
 
 	void SetNum(SizeType newNum, bool allowShrinking = true)
@@ -868,6 +888,7 @@ public:
 	{
 		Assert(newNum <= Num() && newNum >= 0);
 		m_ArrayNum = newNum;
+		TrackSlack();
 	}
 	
 	template <typename OtherElementType, typename OtherAllocator>
@@ -886,6 +907,7 @@ public:
 		ConstructItems<ElementType>(GetData() + m_ArrayNum, source.GetData(), sourceCount);
 
 		m_ArrayNum += sourceCount;
+		TrackSlack();
 	}
 
 	template <typename OtherElementType, typename OtherAllocator>
@@ -903,8 +925,10 @@ public:
 		Reserve(m_ArrayNum + sourceCount);
 		RelocateConstructItems<ElementType>(GetData() + m_ArrayNum, source.GetData(), sourceCount);
 		source.m_ArrayNum = 0;
+		source.TrackSlack();
 
 		m_ArrayNum += sourceCount;
+		TrackSlack();
 	}
 
 	void Append(const ElementType* ptr, SizeType count)
@@ -1074,6 +1098,7 @@ public:
 		RelocateConstructItems<ElementType>(removePtr, removePtr + 1, m_ArrayNum - (index + 1));
 
 		--m_ArrayNum;
+		TrackSlack();
 
 		return 1;
 	}
@@ -1082,12 +1107,7 @@ public:
 	{
 		CheckAddress(&item);
 
-		return RemoveAll(
-			[&item](ElementType& element) 
-			{ 
-				return element == item; 
-			}
-		);
+		return RemoveImpl(item);
 	}
 
 	template <class PREDICATE_CLASS>
@@ -1119,7 +1139,7 @@ public:
 			{
 				if (writeIndex != runStartIndex)
 				{
-					FMemory::Memmove(&GetData()[writeIndex], &GetData()[runStartIndex], sizeof(ElementType)* runLength);
+					RelocateConstructItems<ElementType>(GetData() + writeIndex, GetData() + runStartIndex, runLength);
 				}
 				writeIndex += runLength;
 			}
@@ -1134,6 +1154,7 @@ public:
 		while (readIndex < originalNum);
 
 		m_ArrayNum = writeIndex;
+		TrackSlack();
 
 		return originalNum - m_ArrayNum;
 	}
@@ -1201,10 +1222,109 @@ public:
 
 		if (firstIndexToSwap != secondIndexToSwap)
 		{
-			SwapMemory(firstIndexToSwap, secondIndexToSwap);
+			SwapImpl(firstIndexToSwap, secondIndexToSwap);
 		}
 	}
 
+public:
+
+	// Binary heap
+	template <typename PredicateType>
+	FORCE_INLINE void Heapify(const PredicateType& predicate)
+	{
+		Fly3DPrivateHeap::Heapify<2>(GetData(), m_ArrayNum, predicate);
+	}
+
+	FORCE_INLINE void Heapify()
+	{
+		Heapify(TLess<ElementType>());
+	}
+
+	template <typename PredicateType>
+	FORCE_INLINE bool IsHeap(const PredicateType& predicate) const
+	{
+		return Fly3DPrivateHeap::IsHeap<2>(GetData(), m_ArrayNum, predicate);
+	}
+
+	template <typename PredicateType>
+	SizeType HeapPush(ElementType&& item, const PredicateType& predicate)
+	{
+		const SizeType index = Add(MoveTempIfPossible(item));
+		return Fly3DPrivateHeap::HeapSiftUp<2>(GetData(), (SizeType)0, index, predicate);
+	}
+
+	template <typename PredicateType>
+	SizeType HeapPush(const ElementType& item, const PredicateType& predicate)
+	{
+		const SizeType index = Add(item);
+		return Fly3DPrivateHeap::HeapSiftUp<2>(GetData(), (SizeType)0, index, predicate);
+	}
+
+	FORCE_INLINE SizeType HeapPush(ElementType&& item)
+	{
+		return HeapPush(MoveTempIfPossible(item), TLess<ElementType>());
+	}
+
+	FORCE_INLINE SizeType HeapPush(const ElementType& item)
+	{
+		return HeapPush(item, TLess<ElementType>());
+	}
+
+	template <typename PredicateType>
+	void HeapPop(ElementType& outItem, const PredicateType& predicate, bool allowShrinking = true)
+	{
+		RangeCheck(0);
+		outItem = MoveTemp(*GetData());
+		HeapPopDiscard(predicate, allowShrinking);
+	}
+
+	FORCE_INLINE void HeapPop(ElementType& outItem, bool allowShrinking = true)
+	{
+		HeapPop(outItem, TLess<ElementType>(), allowShrinking);
+	}
+
+	template <typename PredicateType>
+	void HeapPopDiscard(const PredicateType& predicate, bool allowShrinking = true)
+	{
+		RangeCheck(0);
+		RemoveAtSwap(0, 1, allowShrinking);
+		Fly3DPrivateHeap::HeapSiftDown<2>(GetData(), (SizeType)0, m_ArrayNum, predicate);
+	}
+
+	FORCE_INLINE void HeapPopDiscard(bool allowShrinking = true)
+	{
+		HeapPopDiscard(TLess<ElementType>(), allowShrinking);
+	}
+
+	FORCE_INLINE ElementType& HeapTop()
+	{
+		RangeCheck(0);
+		return GetData()[0];
+	}
+
+	FORCE_INLINE const ElementType& HeapTop() const
+	{
+		RangeCheck(0);
+		return GetData()[0];
+	}
+
+	template <typename PredicateType>
+	void HeapRemoveAt(SizeType index, const PredicateType& predicate, bool allowShrinking = true)
+	{
+		RemoveAtSwap(index, 1, allowShrinking);
+
+		if (index < m_ArrayNum)
+		{
+			Fly3DPrivateHeap::HeapSiftDown<2>(GetData(), index, m_ArrayNum, predicate);
+			Fly3DPrivateHeap::HeapSiftUp<2>(GetData(), (SizeType)0, index, predicate);
+		}
+	}
+
+	FORCE_INLINE void HeapRemoveAt(SizeType index, bool allowShrinking = true)
+	{
+		HeapRemoveAt(index, TLess<ElementType>(), allowShrinking);
+	}
+
 public:
 
 	// Iterators
@@ -1251,6 +1371,50 @@ public:
 
 private:
 
+	FORCE_INLINE void TrackSlack()
+	{
+#if ENABLE_CONTAINER_SLACK_TRACKING
+		m_SlackTracker.Update((EAllocatorType)TAllocatorTraits<Allocator>::MemoryLabel, GetAllocatedSize(), m_ArrayNum * sizeof(ElementType));
+#endif
+	}
+
+	template <typename T = ElementType>
+	FORCE_INLINE typename TEnableIf<TIsBitwiseRelocatable<T>::Value>::Type SwapImpl(SizeType firstIndexToSwap, SizeType secondIndexToSwap)
+	{
+		SwapMemory(firstIndexToSwap, secondIndexToSwap);
+	}
+
+	template <typename T = ElementType>
+	FORCE_INLINE typename TEnableIf<!TIsBitwiseRelocatable<T>::Value>::Type SwapImpl(SizeType firstIndexToSwap, SizeType secondIndexToSwap)
+	{
+		ElementType temp = MoveTemp(GetData()[firstIndexToSwap]);
+		GetData()[firstIndexToSwap] = MoveTemp(GetData()[secondIndexToSwap]);
+		GetData()[secondIndexToSwap] = MoveTemp(temp);
+	}
+
+	template <typename T = ElementType>
+	FORCE_INLINE typename TEnableIf<TIsVectorSearchable<T>::Value, SizeType>::Type RemoveImpl(const ElementType& item)
+	{
+		const ElementType value = item;
+		const SizeType originalNum = m_ArrayNum;
+
+		m_ArrayNum = RemoveItems(GetData(), m_ArrayNum, value);
+		TrackSlack();
+
+		return originalNum - m_ArrayNum;
+	}
+
+	template <typename T = ElementType>
+	FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<T>::Value, SizeType>::Type RemoveImpl(const ElementType& item)
+	{
+		return RemoveAll(
+			[&item](ElementType& element) 
+			{ 
+				return element == item; 
+			}
+		);
+	}
+
 	template <typename FromArrayType, typename ToArrayType>
 	static FORCE_INLINE typename TEnableIf<Fly3DPrivateArray::TCanMoveTArrayPointersBetweenArrayTypes<FromArrayType, ToArrayType>::Value>::Type MoveOrCopy(ToArrayType& toArray, FromArrayType& fromArray, SizeType prevMax)
 	{
@@ -1259,6 +1423,9 @@ private:
 		toArray.m_ArrayMax = fromArray.m_ArrayMax;
 		fromArray.m_ArrayNum = 0;
 		fromArray.m_ArrayMax = 0;
+
+		toArray.TrackSlack();
+		fromArray.TrackSlack();
 	}
 
 	template <typename FromArrayType, typename ToArrayType>
@@ -1288,7 +1455,7 @@ private:
 		Assert((count >= 0) & (index >= 0) & (index <= m_ArrayNum));
 
 		SizeType newNum = count;
-		AssertMsg((OtherSizeType)newNum == count, TEXT("Invalid number of elements to add to this array type: %llu"), (unsigned long long)newNum);
+		AssertMsg((OtherSizeType)newNum == count, "Invalid number of elements to add to this array type: %llu\n", (unsigned long long)newNum);
 
 		const SizeType oldNum = m_ArrayNum;
 		if ((m_ArrayNum += count) > m_ArrayMax)
@@ -1298,6 +1465,8 @@ private:
 
 		ElementType* data = GetData() + index;
 		RelocateConstructItems<ElementType>(data + count, data, oldNum - index);
+
+		TrackSlack();
 	}
 
 	void RemoveAtImpl(SizeType index, SizeType count, bool allowShrinking)
@@ -1313,12 +1482,7 @@ private:
 
 			if (numToMove)
 			{
-				FMemory::Memmove
-				(
-					(uint8*)m_AllocatorInstance.GetAllocation() + (index) * sizeof(ElementType),
-					(uint8*)m_AllocatorInstance.GetAllocation() + (index + count) * sizeof(ElementType),
-					numToMove * sizeof(ElementType)
-				);
+				RelocateConstructItems<ElementType>(GetData() + index, GetData() + index + count, numToMove);
 			}
 
 			m_ArrayNum -= count;
@@ -1327,6 +1491,8 @@ private:
 			{
 				ResizeShrink();
 			}
+
+			TrackSlack();
 		}
 	}
 
@@ -1345,11 +1511,7 @@ private:
 
 			if (numElementsToMoveIntoHole)
 			{
-				FMemory::Memcpy(
-					(uint8*)m_AllocatorInstance.GetAllocation() + (index) * sizeof(ElementType),
-					(uint8*)m_AllocatorInstance.GetAllocation() + (m_ArrayNum - numElementsToMoveIntoHole) * sizeof(ElementType),
-					numElementsToMoveIntoHole * sizeof(ElementType)
-				);
+				RelocateConstructItems<ElementType>(GetData() + index, GetData() + m_ArrayNum - numElementsToMoveIntoHole, numElementsToMoveIntoHole);
 			}
 
 			m_ArrayNum -= count;
@@ -1358,6 +1520,8 @@ private:
 			{
 				ResizeShrink();
 			}
+
+			TrackSlack();
 		}
 	}
 
@@ -1376,7 +1540,7 @@ private:
 	void ResizeGrow(SizeType oldNum)
 	{
 		m_ArrayMax = m_AllocatorInstance.CalculateSlackGrow(m_ArrayNum, m_ArrayMax, sizeof(ElementType));
-		m_AllocatorInstance.ResizeAllocation(oldNum, m_ArrayMax, sizeof(ElementType));
+		ResizeAllocation(oldNum, m_ArrayMax);
 	}
 
 	void ResizeShrink()
@@ -1386,7 +1550,7 @@ private:
 		{
 			m_ArrayMax = newArrayMax;
 			Assert(m_ArrayMax >= m_ArrayNum);
-			m_AllocatorInstance.ResizeAllocation(m_ArrayNum, m_ArrayMax, sizeof(ElementType));
+			ResizeAllocation(m_ArrayNum, m_ArrayMax);
 		}
 	}
 
@@ -1400,10 +1564,56 @@ private:
 		if (newMax != m_ArrayMax)
 		{
 			m_ArrayMax = newMax;
-			m_AllocatorInstance.ResizeAllocation(m_ArrayNum, m_ArrayMax, sizeof(ElementType));
+			ResizeAllocation(m_ArrayNum, m_ArrayMax);
+			TrackSlack();
 		}
 	}
 
+	/**
+	* Resizes the allocation keeping the first numToKeep elements. The allocator is first asked to resize in place, 
+	* which never touches the elements. Otherwise relocatable elements ride along with a realloc, 
+	* and the rest are move-constructed into a fresh allocation one by one, by the allocator itself when it stores
+	* elements inline.
+	*/
+	template <typename T = ElementType>
+	FORCE_INLINE typename TEnableIf<TIsBitwiseRelocatable<T>::Value>::Type ResizeAllocation(SizeType numToKeep, SizeType newMax)
+	{
+		if (!m_AllocatorInstance.TryExpandInPlace(numToKeep, newMax, sizeof(ElementType)))
+		{
+			m_AllocatorInstance.ResizeAllocation(numToKeep, newMax, sizeof(ElementType));
+		}
+	}
+
+	template <typename T = ElementType>
+	typename TEnableIf<!TIsBitwiseRelocatable<T>::Value>::Type ResizeAllocation(SizeType numToKeep, SizeType newMax)
+	{
+		if (m_AllocatorInstance.TryExpandInPlace(numToKeep, newMax, sizeof(ElementType)))
+		{
+			return;
+		}
+
+		RelocateAllocation(numToKeep, newMax);
+	}
+
+	template <typename A = Allocator>
+	FORCE_INLINE typename TEnableIf<TAllocatorTraits<A>::StoresElementsInline>::Type RelocateAllocation(SizeType numToKeep, SizeType newMax)
+	{
+		m_AllocatorInstance.ResizeAllocation(numToKeep, newMax, sizeof(ElementType));
+	}
+
+	template <typename A = Allocator>
+	typename TEnableIf<!TAllocatorTraits<A>::StoresElementsInline>::Type RelocateAllocation(SizeType numToKeep, SizeType newMax)
+	{
+		ElementAllocatorType newAllocator;
+		if (newMax)
+		{
+			newAllocator.ResizeAllocation(0, newMax, sizeof(ElementType));
+		}
+
+		RelocateConstructItems<ElementType>(newAllocator.GetAllocation(), GetData(), numToKeep);
+		m_AllocatorInstance.MoveToEmpty(newAllocator);
+	}
+
 	void ResizeForCopy(SizeType newMax, SizeType prevMax)
 	{
 		if (newMax)
@@ -1423,9 +1633,9 @@ private:
 	void CopyToEmpty(const OtherElementType* otherData, OtherSizeType otherNum, SizeType prevMax, SizeType extraSlack)
 	{
 		SizeType newNum = otherNum;
-		AssertMsg((OtherSizeType)newNum == otherNum, TEXT("Invalid number of elements to add to this array type: %llu"), (unsigned long long)newNum);
+		AssertMsg((OtherSizeType)newNum == otherNum, "Invalid number of elements to add to this array type: %llu\n", (unsigned long long)newNum);
 
-		checkSlow(extraSlack >= 0);
+		Assert(extraSlack >= 0);
 
 		m_ArrayNum = newNum;
 		if (otherNum || extraSlack || prevMax)
@@ -1437,6 +1647,8 @@ private:
 		{
 			m_ArrayMax = 0;
 		}
+
+		TrackSlack();
 	}
 
 protected:
@@ -1453,6 +1665,10 @@ protected:
 	SizeType             m_ArrayNum;
 	SizeType             m_ArrayMax;
 
+#if ENABLE_CONTAINER_SLACK_TRACKING
+	FContainerSlackTracker m_SlackTracker;
+#endif
+
 };
 
 
@@ -1461,6 +1677,17 @@ struct TContainerTraits<TArray<InElementType, Allocator>> : public TContainerTra
 {
 	enum 
 	{ 
-		MoveWillEmptyContainer = TAllocatorTraits<Allocator>::SupportsMove 
+		MoveWillEmptyContainer = 
+			TAllocatorTraits<Allocator>::SupportsMove && 
+			(!TAllocatorTraits<Allocator>::StoresElementsInline || TIsBitwiseRelocatable<InElementType>::Value)
+	};
+};
+
+template <typename InElementType, typename Allocator>
+struct TIsBitwiseRelocatable<TArray<InElementType, Allocator>>
+{
+	enum 
+	{ 
+		Value = TContainerTraits<TArray<InElementType, Allocator>>::MoveWillEmptyContainer 
 	};
 };
\ No newline at end of file
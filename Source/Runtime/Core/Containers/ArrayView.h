@@ -0,0 +1,387 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Template/EnableIf.h"
+#include "Runtime/Template/AreTypesEqual.h"
+#include "Runtime/Template/RemoveCV.h"
+#include "Runtime/Template/PointerIsConvertibleFromTo.h"
+
+#include <initializer_list>
+
+template <typename InElementType>
+class TArrayView;
+
+template <typename T>
+using TConstArrayView = TArrayView<const T>;
+
+namespace Fly3DPrivateArrayView
+{
+	template <typename FromElementType, typename ToElementType>
+	struct TIsCompatibleElementType
+	{
+		enum
+		{
+			Value =
+				TPointerIsConvertibleFromTo<FromElementType, ToElementType>::Value &&
+				TIsSame<typename TRemoveCV<FromElementType>::Type, typename TRemoveCV<ToElementType>::Type>::Value
+		};
+	};
+}
+
+/**
+* Non-owning view over a contiguous range of elements. Views are cheap to copy and never allocate,
+* so functions that only read or patch elements in place should take a TArrayView (or TConstArrayView)
+* instead of a TArray reference. The caller guarantees the viewed memory outlives the view.
+*/
+template <typename InElementType>
+class TArrayView
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef int32         SizeType;
+
+public:
+
+	TArrayView()
+		: m_Data(nullptr)
+		, m_ArrayNum(0)
+	{
+
+	}
+
+	TArrayView(ElementType* data, SizeType count)
+		: m_Data(data)
+		, m_ArrayNum(count)
+	{
+		Assert(m_ArrayNum >= 0);
+		Assert(m_Data != nullptr || m_ArrayNum == 0);
+	}
+
+	template <
+		typename OtherElementType,
+		typename = typename TEnableIf<Fly3DPrivateArrayView::TIsCompatibleElementType<OtherElementType, ElementType>::Value>::Type
+	>
+	TArrayView(const TArrayView<OtherElementType>& other)
+		: m_Data(other.GetData())
+		, m_ArrayNum(other.Num())
+	{
+
+	}
+
+	template <
+		typename OtherElementType,
+		typename OtherAllocator,
+		typename = typename TEnableIf<Fly3DPrivateArrayView::TIsCompatibleElementType<OtherElementType, ElementType>::Value>::Type
+	>
+	TArrayView(TArray<OtherElementType, OtherAllocator>& other)
+		: m_Data(other.GetData())
+		, m_ArrayNum((SizeType)other.Num())
+	{
+		Assert((int64)other.Num() == (int64)m_ArrayNum);
+	}
+
+	template <
+		typename OtherElementType,
+		typename OtherAllocator,
+		typename = typename TEnableIf<Fly3DPrivateArrayView::TIsCompatibleElementType<const OtherElementType, ElementType>::Value>::Type
+	>
+	TArrayView(const TArray<OtherElementType, OtherAllocator>& other)
+		: m_Data(other.GetData())
+		, m_ArrayNum((SizeType)other.Num())
+	{
+		Assert((int64)other.Num() == (int64)m_ArrayNum);
+	}
+
+	template <
+		typename OtherElementType,
+		size_t N,
+		typename = typename TEnableIf<Fly3DPrivateArrayView::TIsCompatibleElementType<OtherElementType, ElementType>::Value>::Type
+	>
+	TArrayView(OtherElementType (&other)[N])
+		: m_Data(other)
+		, m_ArrayNum((SizeType)N)
+	{
+
+	}
+
+	/** Only valid for the lifetime of the full expression that created the list, typically a function call. */
+	template <
+		typename OtherElementType,
+		typename = typename TEnableIf<Fly3DPrivateArrayView::TIsCompatibleElementType<const OtherElementType, ElementType>::Value>::Type
+	>
+	TArrayView(std::initializer_list<OtherElementType> initList)
+		: m_Data(initList.begin())
+		, m_ArrayNum((SizeType)initList.size())
+	{
+
+	}
+
+	FORCE_INLINE ElementType* GetData() const
+	{
+		return m_Data;
+	}
+
+	FORCE_INLINE SizeType Num() const
+	{
+		return m_ArrayNum;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_ArrayNum == 0;
+	}
+
+	FORCE_INLINE uint32 GetTypeSize() const
+	{
+		return sizeof(ElementType);
+	}
+
+	FORCE_INLINE bool IsValidIndex(SizeType index) const
+	{
+		return index >= 0 && index < m_ArrayNum;
+	}
+
+	FORCE_INLINE void CheckInvariants() const
+	{
+		Assert(m_ArrayNum >= 0);
+	}
+
+	FORCE_INLINE void RangeCheck(SizeType index) const
+	{
+		CheckInvariants();
+		AssertMsg((index >= 0) && (index < m_ArrayNum), "Array index out of bounds: %i from an array of size %i", index, m_ArrayNum);
+	}
+
+	FORCE_INLINE void SliceRangeCheck(SizeType index, SizeType count) const
+	{
+		AssertMsg((index >= 0) && (count >= 0) && (index + count <= m_ArrayNum), "Array slice out of bounds: index %i, count %i from an array of size %i", index, count, m_ArrayNum);
+	}
+
+	FORCE_INLINE ElementType& operator[](SizeType index) const
+	{
+		RangeCheck(index);
+		return m_Data[index];
+	}
+
+	FORCE_INLINE ElementType& Last(SizeType indexFromTheEnd = 0) const
+	{
+		RangeCheck(m_ArrayNum - indexFromTheEnd - 1);
+		return m_Data[m_ArrayNum - indexFromTheEnd - 1];
+	}
+
+	FORCE_INLINE TArrayView Slice(SizeType index, SizeType count) const
+	{
+		SliceRangeCheck(index, count);
+		return TArrayView(m_Data + index, count);
+	}
+
+	FORCE_INLINE TArrayView Left(SizeType count) const
+	{
+		return Slice(0, FMath::Min(count, m_ArrayNum));
+	}
+
+	FORCE_INLINE TArrayView Right(SizeType count) const
+	{
+		const SizeType clamped = FMath::Min(count, m_ArrayNum);
+		return Slice(m_ArrayNum - clamped, clamped);
+	}
+
+	FORCE_INLINE TArrayView RightChop(SizeType count) const
+	{
+		const SizeType clamped = FMath::Min(count, m_ArrayNum);
+		return Slice(clamped, m_ArrayNum - clamped);
+	}
+
+	bool Find(const ElementType& item, SizeType& index) const
+	{
+		index = this->Find(item);
+		return index != INDEX_NONE;
+	}
+
+	FORCE_INLINE SizeType Find(const ElementType& item) const
+	{
+		return FindItem(m_Data, m_ArrayNum, item);
+	}
+
+	bool FindLast(const ElementType& item, SizeType& index) const
+	{
+		index = this->FindLast(item);
+		return index != INDEX_NONE;
+	}
+
+	FORCE_INLINE SizeType FindLast(const ElementType& item) const
+	{
+		return FindLastItem(m_Data, m_ArrayNum, item);
+	}
+
+	template <typename predicate>
+	SizeType FindLastByPredicate(predicate pred) const
+	{
+		const ElementType* data = m_Data + m_ArrayNum;
+
+		while (data != m_Data)
+		{
+			--data;
+			if (pred(*data))
+			{
+				return static_cast<SizeType>(data - m_Data);
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	template <typename KeyType>
+	SizeType IndexOfByKey(const KeyType& key) const
+	{
+		const ElementType* dataEnd = m_Data + m_ArrayNum;
+
+		for (const ElementType* data = m_Data; data != dataEnd; ++data)
+		{
+			if (*data == key)
+			{
+				return static_cast<SizeType>(data - m_Data);
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	template <typename predicate>
+	SizeType IndexOfByPredicate(predicate pred) const
+	{
+		const ElementType* dataEnd = m_Data + m_ArrayNum;
+
+		for (const ElementType* data = m_Data; data != dataEnd; ++data)
+		{
+			if (pred(*data))
+			{
+				return static_cast<SizeType>(data - m_Data);
+			}
+		}
+
+		return INDEX_NONE;
+	}
+
+	template <typename KeyType>
+	ElementType* FindByKey(const KeyType& key) const
+	{
+		ElementType* dataEnd = m_Data + m_ArrayNum;
+
+		for (ElementType* data = m_Data; data != dataEnd; ++data)
+		{
+			if (*data == key)
+			{
+				return data;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename predicate>
+	ElementType* FindByPredicate(predicate pred) const
+	{
+		ElementType* dataEnd = m_Data + m_ArrayNum;
+
+		for (ElementType* data = m_Data; data != dataEnd; ++data)
+		{
+			if (pred(*data))
+			{
+				return data;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename ComparisonType>
+	bool Contains(const ComparisonType& item) const
+	{
+		const ElementType* dataEnd = m_Data + m_ArrayNum;
+
+		for (const ElementType* data = m_Data; data != dataEnd; ++data)
+		{
+			if (*data == item)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	FORCE_INLINE bool Contains(const ElementType& item) const
+	{
+		return FindItem(m_Data, m_ArrayNum, item) != INDEX_NONE;
+	}
+
+	/** Returns how many elements are equal to item. */
+	FORCE_INLINE SizeType Count(const ElementType& item) const
+	{
+		return CountItems(m_Data, m_ArrayNum, item);
+	}
+
+	/** Returns the smallest element by operator<. The view must not be empty. */
+	FORCE_INLINE ElementType MinElement() const
+	{
+		RangeCheck(0);
+		return MinOfItems(m_Data, m_ArrayNum);
+	}
+
+	/** Returns the largest element by operator<. The view must not be empty. */
+	FORCE_INLINE ElementType MaxElement() const
+	{
+		RangeCheck(0);
+		return MaxOfItems(m_Data, m_ArrayNum);
+	}
+
+	template <typename predicate>
+	FORCE_INLINE bool ContainsByPredicate(predicate pred) const
+	{
+		return FindByPredicate(pred) != nullptr;
+	}
+
+	FORCE_INLINE ElementType* begin() const
+	{
+		return m_Data;
+	}
+
+	FORCE_INLINE ElementType* end() const
+	{
+		return m_Data + m_ArrayNum;
+	}
+
+private:
+
+	ElementType* m_Data;
+	SizeType     m_ArrayNum;
+};
+
+template <typename ElementType>
+FORCE_INLINE TArrayView<ElementType> MakeArrayView(ElementType* data, int32 count)
+{
+	return TArrayView<ElementType>(data, count);
+}
+
+template <typename ElementType, typename Allocator>
+FORCE_INLINE TArrayView<ElementType> MakeArrayView(TArray<ElementType, Allocator>& other)
+{
+	return TArrayView<ElementType>(other);
+}
+
+template <typename ElementType, typename Allocator>
+FORCE_INLINE TArrayView<const ElementType> MakeArrayView(const TArray<ElementType, Allocator>& other)
+{
+	return TArrayView<const ElementType>(other);
+}
+
+template <typename ElementType, size_t N>
+FORCE_INLINE TArrayView<ElementType> MakeArrayView(ElementType (&other)[N])
+{
+	return TArrayView<ElementType>(other);
+}
@@ -0,0 +1,407 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/ArrayView.h"
+#include "Runtime/Template/MemoryOps.h"
+#include "Runtime/Template/Template.h"
+
+template <typename ChunkedArrayType, typename ElementType>
+class TChunkedArrayIterator
+{
+public:
+
+	typedef typename ChunkedArrayType::SizeType SizeType;
+
+	TChunkedArrayIterator(ChunkedArrayType& owner, SizeType chunkIndex, ElementType* element, ElementType* chunkEnd)
+		: m_Owner(owner)
+		, m_ChunkIndex(chunkIndex)
+		, m_Element(element)
+		, m_ChunkEnd(chunkEnd)
+	{
+
+	}
+
+	TChunkedArrayIterator& operator++()
+	{
+		++m_Element;
+		if (m_Element == m_ChunkEnd && m_ChunkIndex + 1 < m_Owner.NumChunks())
+		{
+			++m_ChunkIndex;
+			TArrayView<ElementType> chunk = m_Owner.GetChunk(m_ChunkIndex);
+			m_Element  = chunk.GetData();
+			m_ChunkEnd = chunk.GetData() + chunk.Num();
+		}
+		return *this;
+	}
+
+	FORCE_INLINE ElementType& operator*() const
+	{
+		return *m_Element;
+	}
+
+	FORCE_INLINE ElementType* operator->() const
+	{
+		return m_Element;
+	}
+
+	FORCE_INLINE bool operator==(const TChunkedArrayIterator& rhs) const
+	{
+		return m_Element == rhs.m_Element;
+	}
+
+	FORCE_INLINE bool operator!=(const TChunkedArrayIterator& rhs) const
+	{
+		return m_Element != rhs.m_Element;
+	}
+
+private:
+
+	ChunkedArrayType& m_Owner;
+	SizeType          m_ChunkIndex;
+	ElementType*      m_Element;
+	ElementType*      m_ChunkEnd;
+};
+
+/**
+* Array that grows by appending fixed-size chunks instead of reallocating. Elements are never moved once added,
+* so pointers and references stay valid until the element is removed, and growth never copies the existing data.
+* Prefer it over TArray for large append-only data; iterate per chunk with GetChunk() in hot loops.
+*/
+template <typename InElementType, uint32 TargetBytesPerChunk = 16384>
+class TChunkedArray
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef int32         SizeType;
+
+	enum
+	{
+		NumElementsPerChunk = TargetBytesPerChunk / sizeof(ElementType) > 0 ? TargetBytesPerChunk / sizeof(ElementType) : 1
+	};
+
+	typedef TChunkedArrayIterator<TChunkedArray, ElementType>             TIterator;
+	typedef TChunkedArrayIterator<const TChunkedArray, const ElementType> TConstIterator;
+
+public:
+
+	TChunkedArray()
+		: m_ArrayNum(0)
+	{
+
+	}
+
+	TChunkedArray(const TChunkedArray& other)
+		: m_ArrayNum(0)
+	{
+		CopyFrom(other);
+	}
+
+	TChunkedArray(TChunkedArray&& other)
+		: m_Chunks(MoveTemp(other.m_Chunks))
+		, m_ArrayNum(other.m_ArrayNum)
+	{
+		other.m_ArrayNum = 0;
+	}
+
+	TChunkedArray& operator=(const TChunkedArray& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			CopyFrom(other);
+		}
+		return *this;
+	}
+
+	TChunkedArray& operator=(TChunkedArray&& other)
+	{
+		if (this != &other)
+		{
+			Empty();
+			m_Chunks   = MoveTemp(other.m_Chunks);
+			m_ArrayNum = other.m_ArrayNum;
+			other.m_ArrayNum = 0;
+		}
+		return *this;
+	}
+
+	~TChunkedArray()
+	{
+		Empty();
+	}
+
+	FORCE_INLINE SizeType Num() const
+	{
+		return m_ArrayNum;
+	}
+
+	FORCE_INLINE SizeType Max() const
+	{
+		return m_Chunks.Num() * (SizeType)NumElementsPerChunk;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_ArrayNum == 0;
+	}
+
+	FORCE_INLINE bool IsValidIndex(SizeType index) const
+	{
+		return index >= 0 && index < m_ArrayNum;
+	}
+
+	FORCE_INLINE void RangeCheck(SizeType index) const
+	{
+		AssertMsg((index >= 0) && (index < m_ArrayNum), "Array index out of bounds: %i from an array of size %i", index, m_ArrayNum);
+	}
+
+	size_t GetAllocatedSize() const
+	{
+		return m_Chunks.GetAllocatedSize() + (size_t)m_Chunks.Num() * NumElementsPerChunk * sizeof(ElementType);
+	}
+
+	/** Number of chunks holding at least one element. Reserved but unused chunks are not counted. */
+	FORCE_INLINE SizeType NumChunks() const
+	{
+		return (m_ArrayNum + (SizeType)NumElementsPerChunk - 1) / (SizeType)NumElementsPerChunk;
+	}
+
+	FORCE_INLINE TArrayView<ElementType> GetChunk(SizeType chunkIndex)
+	{
+		return TArrayView<ElementType>(m_Chunks[chunkIndex], GetNumInChunk(chunkIndex));
+	}
+
+	FORCE_INLINE TArrayView<const ElementType> GetChunk(SizeType chunkIndex) const
+	{
+		return TArrayView<const ElementType>(m_Chunks[chunkIndex], GetNumInChunk(chunkIndex));
+	}
+
+	FORCE_INLINE ElementType& operator[](SizeType index)
+	{
+		RangeCheck(index);
+		return m_Chunks[index / (SizeType)NumElementsPerChunk][index % (SizeType)NumElementsPerChunk];
+	}
+
+	FORCE_INLINE const ElementType& operator[](SizeType index) const
+	{
+		RangeCheck(index);
+		return m_Chunks[index / (SizeType)NumElementsPerChunk][index % (SizeType)NumElementsPerChunk];
+	}
+
+	FORCE_INLINE ElementType& Last(SizeType indexFromTheEnd = 0)
+	{
+		return (*this)[m_ArrayNum - indexFromTheEnd - 1];
+	}
+
+	FORCE_INLINE const ElementType& Last(SizeType indexFromTheEnd = 0) const
+	{
+		return (*this)[m_ArrayNum - indexFromTheEnd - 1];
+	}
+
+	/** Adds count uninitialized elements and returns the index of the first one. The new range may span several chunks. */
+	SizeType AddUninitialized(SizeType count = 1)
+	{
+		Assert(count >= 0);
+
+		const SizeType oldNum = m_ArrayNum;
+		m_ArrayNum += count;
+		Assert(m_ArrayNum >= oldNum);
+
+		AllocateChunks(NumChunks());
+
+		return oldNum;
+	}
+
+	FORCE_INLINE SizeType Add(const ElementType& item)
+	{
+		return Emplace(item);
+	}
+
+	FORCE_INLINE SizeType Add(ElementType&& item)
+	{
+		return Emplace(MoveTempIfPossible(item));
+	}
+
+	template <typename... ArgsType>
+	FORCE_INLINE SizeType Emplace(ArgsType&&... args)
+	{
+		const SizeType index = AddUninitialized(1);
+		new (GetElementAddress(index)) ElementType(Forward<ArgsType>(args)...);
+		return index;
+	}
+
+	template <typename... ArgsType>
+	FORCE_INLINE ElementType& Emplace_GetRef(ArgsType&&... args)
+	{
+		const SizeType index = AddUninitialized(1);
+		return *new (GetElementAddress(index)) ElementType(Forward<ArgsType>(args)...);
+	}
+
+	SizeType AddDefaulted(SizeType count = 1)
+	{
+		const SizeType index = AddUninitialized(count);
+		ForEachRange(index, count, [](ElementType* data, SizeType num) { DefaultConstructItems<ElementType>(data, num); });
+		return index;
+	}
+
+	SizeType AddZeroed(SizeType count = 1)
+	{
+		const SizeType index = AddUninitialized(count);
+		ForEachRange(index, count, [](ElementType* data, SizeType num) { FMemory::Memzero(data, num * sizeof(ElementType)); });
+		return index;
+	}
+
+	/** Removes the last count elements. Chunks are kept unless allowShrinking is set. */
+	void RemoveLast(SizeType count = 1, bool allowShrinking = false)
+	{
+		Assert(count >= 0 && count <= m_ArrayNum);
+
+		ForEachRange(m_ArrayNum - count, count, [](ElementType* data, SizeType num) { DestructItems(data, num); });
+		m_ArrayNum -= count;
+
+		if (allowShrinking)
+		{
+			Shrink();
+		}
+	}
+
+	FORCE_INLINE void Reserve(SizeType number)
+	{
+		Assert(number >= 0);
+		AllocateChunks((number + (SizeType)NumElementsPerChunk - 1) / (SizeType)NumElementsPerChunk);
+	}
+
+	/** Destroys all elements but keeps the chunks for reuse. */
+	void Reset()
+	{
+		DestructAll();
+		m_ArrayNum = 0;
+	}
+
+	void Empty()
+	{
+		DestructAll();
+		m_ArrayNum = 0;
+		FreeChunks(0);
+		m_Chunks.Empty();
+	}
+
+	/** Frees the chunks past the last one in use. */
+	void Shrink()
+	{
+		FreeChunks(NumChunks());
+		m_Chunks.Shrink();
+	}
+
+	FORCE_INLINE TIterator begin()
+	{
+		return m_ArrayNum ? TIterator(*this, 0, m_Chunks[0], m_Chunks[0] + GetNumInChunk(0)) : end();
+	}
+
+	FORCE_INLINE TConstIterator begin() const
+	{
+		return m_ArrayNum ? TConstIterator(*this, 0, m_Chunks[0], m_Chunks[0] + GetNumInChunk(0)) : end();
+	}
+
+	FORCE_INLINE TIterator end()
+	{
+		ElementType* last = GetEndAddress();
+		return TIterator(*this, NumChunks(), last, last);
+	}
+
+	FORCE_INLINE TConstIterator end() const
+	{
+		const ElementType* last = GetEndAddress();
+		return TConstIterator(*this, NumChunks(), last, last);
+	}
+
+private:
+
+	FORCE_INLINE SizeType GetNumInChunk(SizeType chunkIndex) const
+	{
+		Assert(chunkIndex >= 0 && chunkIndex < NumChunks());
+
+		const SizeType remaining = m_ArrayNum - chunkIndex * (SizeType)NumElementsPerChunk;
+		return remaining < (SizeType)NumElementsPerChunk ? remaining : (SizeType)NumElementsPerChunk;
+	}
+
+	FORCE_INLINE ElementType* GetElementAddress(SizeType index) const
+	{
+		return m_Chunks[index / (SizeType)NumElementsPerChunk] + index % (SizeType)NumElementsPerChunk;
+	}
+
+	FORCE_INLINE ElementType* GetEndAddress() const
+	{
+		if (m_ArrayNum == 0)
+		{
+			return nullptr;
+		}
+
+		const SizeType lastChunk = NumChunks() - 1;
+		return m_Chunks[lastChunk] + GetNumInChunk(lastChunk);
+	}
+
+	template <typename FunctorType>
+	void ForEachRange(SizeType index, SizeType count, FunctorType functor) const
+	{
+		while (count > 0)
+		{
+			const SizeType offset = index % (SizeType)NumElementsPerChunk;
+			const SizeType space  = (SizeType)NumElementsPerChunk - offset;
+			const SizeType num    = count < space ? count : space;
+
+			functor(m_Chunks[index / (SizeType)NumElementsPerChunk] + offset, num);
+
+			index += num;
+			count -= num;
+		}
+	}
+
+	void AllocateChunks(SizeType numChunks)
+	{
+		while (m_Chunks.Num() < numChunks)
+		{
+			m_Chunks.Add((ElementType*)FLY3D_MALLOC_ALIGNED(NumElementsPerChunk * sizeof(ElementType), alignof(ElementType), kMemTypeChunkedArray));
+		}
+	}
+
+	void FreeChunks(SizeType numToKeep)
+	{
+		for (SizeType i = numToKeep; i < m_Chunks.Num(); ++i)
+		{
+			FLY3D_FREE(m_Chunks[i]);
+		}
+
+		if (numToKeep < m_Chunks.Num())
+		{
+			m_Chunks.RemoveAt(numToKeep, m_Chunks.Num() - numToKeep, false);
+		}
+	}
+
+	void DestructAll()
+	{
+		ForEachRange(0, m_ArrayNum, [](ElementType* data, SizeType num) { DestructItems(data, num); });
+	}
+
+	void CopyFrom(const TChunkedArray& other)
+	{
+		Assert(m_ArrayNum == 0);
+
+		Reserve(other.m_ArrayNum);
+		for (SizeType chunkIndex = 0; chunkIndex < other.NumChunks(); ++chunkIndex)
+		{
+			TArrayView<const ElementType> chunk = other.GetChunk(chunkIndex);
+			ConstructItems<ElementType>(m_Chunks[chunkIndex], chunk.GetData(), chunk.Num());
+		}
+		m_ArrayNum = other.m_ArrayNum;
+	}
+
+private:
+
+	TArray<ElementType*> m_Chunks;
+	SizeType             m_ArrayNum;
+};
@@ -3,8 +3,10 @@
 #include "Runtime/Platform/Platform.h"
 #include "Runtime/Template/TypeCompatibleBytes.h"
 #include "Runtime/Template/Template.h"
+#include "Runtime/Template/MemoryOps.h"
 #include "Runtime/Allocator/MemoryMacros.h"
 #include "Runtime/Math/Math.h"
+#include "Runtime/Core/HAL/FlyMemory.h"
 
 template<int IndexSize> 
 class TSizedDefaultAllocator;
@@ -63,6 +65,16 @@ struct TAllocatorTraitsBase
 	{ 
 		IsZeroConstruct = false 
 	};
+	/** Label the allocations are tagged with, used to bucket container slack in the memory profiler. */
+	enum 
+	{ 
+		MemoryLabel = kMemTypeRegular 
+	};
+	/** Elements may live inside the allocator object itself, so moving the allocator moves them. */
+	enum 
+	{ 
+		StoresElementsInline = false 
+	};
 };
 
 template <typename AllocatorType>
@@ -133,10 +145,16 @@ public:
 			}
 			else
 			{
-				FLY3D_REALLOC_ALIGNED(m_Data, numElements * numBytesPerElement, Alignment, kMemTypeAlignedHeapAllocator);
+				m_Data = FLY3D_REALLOC_ALIGNED(m_Data, numElements * numBytesPerElement, Alignment, kMemTypeAlignedHeapAllocator);
 			}
 		}
 
+		/** Resizes the allocation without moving it, returns false if the underlying allocator cannot. */
+		FORCE_INLINE bool TryExpandInPlace(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			return m_Data != nullptr && numElements > 0 && FLY3D_EXPAND_IN_PLACE(m_Data, numElements * numBytesPerElement);
+		}
+
 		FORCE_INLINE SizeType CalculateSlackReserve(SizeType numElements, size_t numBytesPerElement) const
 		{
 			return DefaultCalculateSlackReserve(numElements, numBytesPerElement, Alignment);
@@ -200,6 +218,11 @@ struct TAllocatorTraits<TAlignedHeapAllocator<Alignment>> : TAllocatorTraitsBase
 	{ 
 		IsZeroConstruct = true 
 	};
+
+	enum 
+	{ 
+		MemoryLabel = kMemTypeAlignedHeapAllocator 
+	};
 };
 
 template <int IndexSize>
@@ -293,10 +316,16 @@ public:
 			}
 			else
 			{
-				FLY3D_REALLOC_ALIGNED(m_Data, numElements * numBytesPerElement, DEFAULT_ALIGNMENT, kMemTypeSizedHeapAllocator);
+				m_Data = FLY3D_REALLOC_ALIGNED(m_Data, numElements * numBytesPerElement, DEFAULT_ALIGNMENT, kMemTypeSizedHeapAllocator);
 			}
 		}
 
+		/** Resizes the allocation without moving it, returns false if the underlying allocator cannot. */
+		FORCE_INLINE bool TryExpandInPlace(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			return m_Data != nullptr && numElements > 0 && FLY3D_EXPAND_IN_PLACE(m_Data, numElements * numBytesPerElement);
+		}
+
 		FORCE_INLINE SizeType CalculateSlackReserve(SizeType numElements, size_t numBytesPerElement) const
 		{
 			return DefaultCalculateSlackReserve(numElements, numBytesPerElement);
@@ -347,7 +376,7 @@ public:
 	};
 };
 
-template <uint8 IndexSize>
+template <int IndexSize>
 struct TAllocatorTraits<TSizedHeapAllocator<IndexSize>> : TAllocatorTraitsBase<TSizedHeapAllocator<IndexSize>>
 {
 	enum 
@@ -359,6 +388,11 @@ struct TAllocatorTraits<TSizedHeapAllocator<IndexSize>> : TAllocatorTraitsBase<T
 	{ 
 		IsZeroConstruct = true 
 	};
+
+	enum 
+	{ 
+		MemoryLabel = kMemTypeSizedHeapAllocator 
+	};
 };
 
 template <int IndexSize> 
@@ -378,4 +412,176 @@ template <>
 struct TAllocatorTraits<FDefaultAllocator> : TAllocatorTraits<typename FDefaultAllocator::Typedef> 
 {
 
+};
+
+/**
+* Keeps the first NumInlineElements elements inside the container object and switches to SecondaryAllocator
+* once more are needed. Growing and shrinking relocate the elements one by one unless they are bitwise relocatable.
+* MoveToEmpty copies the inline elements as raw bytes and is only available for bitwise relocatable types; TArray
+* copies the elements of other types instead, see MoveWillEmptyContainer.
+*/
+template <uint32 NumInlineElements, typename SecondaryAllocator = FDefaultAllocator>
+class TInlineAllocator
+{
+public:
+	using SizeType = typename SecondaryAllocator::SizeType;
+
+	enum 
+	{ 
+		NeedsElementType = true 
+	};
+
+	enum 
+	{ 
+		RequireRangeCheck = true 
+	};
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		ForElementType()
+		{
+
+		}
+
+		/** Moves the state of another allocator into this one. The allocator does not know how many inline elements are live, so they move as raw bytes. */
+		FORCE_INLINE void MoveToEmpty(ForElementType& other)
+		{
+			static_assert(TIsBitwiseRelocatable<ElementType>::Value, "TInlineAllocator can only move bitwise relocatable inline elements");
+			Assert(this != &other);
+
+			if (!other.m_SecondaryData.GetAllocation())
+			{
+				FMemory::Memcpy(m_InlineData, other.m_InlineData, sizeof(m_InlineData));
+			}
+
+			m_SecondaryData.MoveToEmpty(other.m_SecondaryData);
+		}
+
+		FORCE_INLINE ElementType* GetAllocation() const
+		{
+			ElementType* secondary = m_SecondaryData.GetAllocation();
+			return secondary ? secondary : GetInlineElements();
+		}
+
+		void ResizeAllocation(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			if (numElements <= (SizeType)NumInlineElements)
+			{
+				if (m_SecondaryData.GetAllocation())
+				{
+					RelocateConstructItems<ElementType>((void*)m_InlineData, m_SecondaryData.GetAllocation(), previousNumElements);
+
+					SecondaryType empty;
+					m_SecondaryData.MoveToEmpty(empty);
+				}
+			}
+			else if (!m_SecondaryData.GetAllocation())
+			{
+				m_SecondaryData.ResizeAllocation(0, numElements, numBytesPerElement);
+				RelocateConstructItems<ElementType>((void*)m_SecondaryData.GetAllocation(), GetInlineElements(), previousNumElements);
+			}
+			else
+			{
+				ResizeSecondary(previousNumElements, numElements, numBytesPerElement);
+			}
+		}
+
+		/** Switching between inline and secondary storage is always handled here, only secondary regrowth can fail. */
+		FORCE_INLINE bool TryExpandInPlace(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			if (numElements <= (SizeType)NumInlineElements || !m_SecondaryData.GetAllocation())
+			{
+				ResizeAllocation(previousNumElements, numElements, numBytesPerElement);
+				return true;
+			}
+
+			return m_SecondaryData.TryExpandInPlace(previousNumElements, numElements, numBytesPerElement);
+		}
+
+		FORCE_INLINE SizeType CalculateSlackReserve(SizeType numElements, size_t numBytesPerElement) const
+		{
+			return numElements <= (SizeType)NumInlineElements ? (SizeType)NumInlineElements : m_SecondaryData.CalculateSlackReserve(numElements, numBytesPerElement);
+		}
+
+		FORCE_INLINE SizeType CalculateSlackShrink(SizeType numElements, SizeType numAllocatedElements, size_t numBytesPerElement) const
+		{
+			return numElements <= (SizeType)NumInlineElements ? (SizeType)NumInlineElements : m_SecondaryData.CalculateSlackShrink(numElements, numAllocatedElements, numBytesPerElement);
+		}
+
+		FORCE_INLINE SizeType CalculateSlackGrow(SizeType numElements, SizeType numAllocatedElements, size_t numBytesPerElement) const
+		{
+			if (numElements <= (SizeType)NumInlineElements)
+			{
+				return (SizeType)NumInlineElements;
+			}
+
+			return m_SecondaryData.CalculateSlackGrow(numElements, numAllocatedElements <= (SizeType)NumInlineElements ? 0 : numAllocatedElements, numBytesPerElement);
+		}
+
+		/** The inline capacity counts as allocated while it is in use, so the reported size never drops below what the elements occupy. */
+		size_t GetAllocatedSize(SizeType numAllocatedElements, size_t numBytesPerElement) const
+		{
+			return m_SecondaryData.GetAllocation() ? m_SecondaryData.GetAllocatedSize(numAllocatedElements, numBytesPerElement) : NumInlineElements * numBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return m_SecondaryData.HasAllocation();
+		}
+
+	private:
+		ForElementType(const ForElementType& other);
+
+		ForElementType& operator=(const ForElementType& other);
+
+		FORCE_INLINE ElementType* GetInlineElements() const
+		{
+			return (ElementType*)m_InlineData;
+		}
+
+		/** Relocatable elements ride along with a realloc of the secondary storage. */
+		template <typename T = ElementType>
+		FORCE_INLINE typename TEnableIf<TIsBitwiseRelocatable<T>::Value>::Type ResizeSecondary(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			m_SecondaryData.ResizeAllocation(previousNumElements, numElements, numBytesPerElement);
+		}
+
+		template <typename T = ElementType>
+		typename TEnableIf<!TIsBitwiseRelocatable<T>::Value>::Type ResizeSecondary(SizeType previousNumElements, SizeType numElements, size_t numBytesPerElement)
+		{
+			SecondaryType newData;
+			newData.ResizeAllocation(0, numElements, numBytesPerElement);
+			RelocateConstructItems<ElementType>((void*)newData.GetAllocation(), m_SecondaryData.GetAllocation(), previousNumElements);
+			m_SecondaryData.MoveToEmpty(newData);
+		}
+
+		typedef typename SecondaryAllocator::template ForElementType<ElementType> SecondaryType;
+
+		TTypeCompatibleBytes<ElementType> m_InlineData[NumInlineElements];
+		SecondaryType                     m_SecondaryData;
+	};
+
+	typedef void ForAnyElementType;
+};
+
+template <uint32 NumInlineElements, typename SecondaryAllocator>
+struct TAllocatorTraits<TInlineAllocator<NumInlineElements, SecondaryAllocator>> : TAllocatorTraitsBase<TInlineAllocator<NumInlineElements, SecondaryAllocator>>
+{
+	enum 
+	{ 
+		SupportsMove = TAllocatorTraits<SecondaryAllocator>::SupportsMove 
+	};
+
+	enum 
+	{ 
+		MemoryLabel = TAllocatorTraits<SecondaryAllocator>::MemoryLabel 
+	};
+
+	enum 
+	{ 
+		StoresElementsInline = true 
+	};
 };
\ No newline at end of file
@@ -0,0 +1,184 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/Containers/ContainerAllocationPolicies.h"
+#include "Runtime/Template/MemoryOps.h"
+#include "Runtime/Template/Template.h"
+#include "Runtime/Template/TypeCompatibleBytes.h"
+
+/**
+* Bounded multi-producer/multi-consumer queue (Vyukov). Every cell carries a sequence number that tells
+* producers and consumers whose turn it is, so each operation costs one CAS on the shared position
+* and never blocks; Push fails when the queue is full and Pop fails when it is empty.
+*/
+template <typename InElementType, typename InAllocator = FDefaultAllocator>
+class TMpmcQueue
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef InAllocator   Allocator;
+
+public:
+
+	/** Capacity is rounded up to a power of two, at least 2. */
+	explicit TMpmcQueue(uint32 capacity)
+		: m_Capacity(FMath::RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+		, m_Mask(m_Capacity - 1)
+		, m_EnqueuePos(0)
+		, m_DequeuePos(0)
+	{
+		m_Storage.ResizeAllocation(0, m_Capacity, sizeof(FCell));
+
+		FCell* cells = m_Storage.GetAllocation();
+		for (uint32 index = 0; index < m_Capacity; ++index)
+		{
+			cells[index].Sequence = (int32)index;
+		}
+	}
+
+	~TMpmcQueue()
+	{
+		FCell* cells = m_Storage.GetAllocation();
+		for (uint32 index = (uint32)m_DequeuePos; index != (uint32)m_EnqueuePos; ++index)
+		{
+			DestructItem(cells[index & m_Mask].Storage.GetTypedPtr());
+		}
+	}
+
+	FORCE_INLINE uint32 Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	/** Approximate while other threads are pushing or popping. */
+	FORCE_INLINE uint32 Num() const
+	{
+		const uint32 num = (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_EnqueuePos) - (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_DequeuePos);
+		return (int32)num < 0 ? 0 : num;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	FORCE_INLINE bool Push(const ElementType& item)
+	{
+		return Emplace(item);
+	}
+
+	FORCE_INLINE bool Push(ElementType&& item)
+	{
+		return Emplace(MoveTempIfPossible(item));
+	}
+
+	template <typename... ArgsType>
+	bool Emplace(ArgsType&&... args)
+	{
+		FCell* cells = m_Storage.GetAllocation();
+		FCell* cell;
+
+		uint32 pos = (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_EnqueuePos);
+		while (true)
+		{
+			cell = &cells[pos & m_Mask];
+
+			const int32 diff = (int32)((uint32)FPlatformAtomics::AtomicRead(&cell->Sequence, EMemoryOrder::Acquire) - pos);
+			if (diff == 0)
+			{
+				// Only claims the cell, the element itself is published by the release store of its sequence.
+				const uint32 prevPos = (uint32)FPlatformAtomics::InterlockedCompareExchange(&m_EnqueuePos, (int32)(pos + 1), (int32)pos, EMemoryOrder::Relaxed);
+				if (prevPos == pos)
+				{
+					break;
+				}
+				pos = prevPos;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_EnqueuePos);
+			}
+		}
+
+		new (cell->Storage.GetTypedPtr()) ElementType(Forward<ArgsType>(args)...);
+		FPlatformAtomics::AtomicStore(&cell->Sequence, (int32)(pos + 1), EMemoryOrder::Release);
+
+		return true;
+	}
+
+	bool Pop(ElementType& outItem)
+	{
+		FCell* cells = m_Storage.GetAllocation();
+		FCell* cell;
+
+		uint32 pos = (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_DequeuePos);
+		while (true)
+		{
+			cell = &cells[pos & m_Mask];
+
+			const int32 diff = (int32)((uint32)FPlatformAtomics::AtomicRead(&cell->Sequence, EMemoryOrder::Acquire) - (pos + 1));
+			if (diff == 0)
+			{
+				const uint32 prevPos = (uint32)FPlatformAtomics::InterlockedCompareExchange(&m_DequeuePos, (int32)(pos + 1), (int32)pos, EMemoryOrder::Relaxed);
+				if (prevPos == pos)
+				{
+					break;
+				}
+				pos = prevPos;
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_DequeuePos);
+			}
+		}
+
+		ElementType* item = cell->Storage.GetTypedPtr();
+		outItem = MoveTemp(*item);
+		DestructItem(item);
+		FPlatformAtomics::AtomicStore(&cell->Sequence, (int32)(pos + m_Mask + 1), EMemoryOrder::Release);
+
+		return true;
+	}
+
+private:
+
+	TMpmcQueue(const TMpmcQueue& other);
+
+	TMpmcQueue& operator=(const TMpmcQueue& other);
+
+private:
+
+	struct FCell
+	{
+		volatile int32                    Sequence;
+		TTypeCompatibleBytes<ElementType> Storage;
+	};
+
+	typedef typename Allocator::template ForElementType<FCell> FStorage;
+
+	FStorage m_Storage;
+	uint32   m_Capacity;
+	uint32   m_Mask;
+
+	uint8 m_Pad0[PLATFORM_CACHE_LINE_SIZE];
+
+	volatile int32 m_EnqueuePos;
+
+	uint8 m_Pad1[PLATFORM_CACHE_LINE_SIZE - sizeof(int32)];
+
+	volatile int32 m_DequeuePos;
+
+	uint8 m_Pad2[PLATFORM_CACHE_LINE_SIZE - sizeof(int32)];
+};
@@ -0,0 +1,145 @@
+﻿#pragma once
+
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Template/BinaryHeap.h"
+#include "Runtime/Template/Less.h"
+
+/**
+* Priority queue on top of a TArray heap. Top() is the element for which Predicate holds against every other element.
+* Arity selects a d-ary layout; 4 is usually faster than 2 once the heap no longer fits in cache.
+*/
+template <typename InElementType, typename PredicateType = TLess<InElementType>, uint32 Arity = 2, typename InAllocator = FDefaultAllocator>
+class TPriorityQueue
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef InAllocator   Allocator;
+	typedef typename TArray<ElementType, Allocator>::SizeType SizeType;
+
+public:
+
+	TPriorityQueue()
+		: m_Predicate()
+	{
+
+	}
+
+	explicit TPriorityQueue(const PredicateType& predicate)
+		: m_Predicate(predicate)
+	{
+
+	}
+
+	template <typename OtherAllocator>
+	explicit TPriorityQueue(const TArray<ElementType, OtherAllocator>& elements, const PredicateType& predicate = PredicateType())
+		: m_Heap(elements)
+		, m_Predicate(predicate)
+	{
+		Fly3DPrivateHeap::Heapify<Arity>(m_Heap.GetData(), m_Heap.Num(), m_Predicate);
+	}
+
+	FORCE_INLINE SizeType Num() const
+	{
+		return m_Heap.Num();
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_Heap.Num() == 0;
+	}
+
+	FORCE_INLINE void Reserve(SizeType number)
+	{
+		m_Heap.Reserve(number);
+	}
+
+	FORCE_INLINE void Reset()
+	{
+		m_Heap.Reset();
+	}
+
+	FORCE_INLINE void Empty(SizeType slack = 0)
+	{
+		m_Heap.Empty(slack);
+	}
+
+	FORCE_INLINE const ElementType& Top() const
+	{
+		Assert(m_Heap.Num() > 0);
+		return m_Heap[0];
+	}
+
+	FORCE_INLINE SizeType Push(const ElementType& item)
+	{
+		return SiftUpLast(m_Heap.Add(item));
+	}
+
+	FORCE_INLINE SizeType Push(ElementType&& item)
+	{
+		return SiftUpLast(m_Heap.Add(MoveTempIfPossible(item)));
+	}
+
+	template <typename... ArgsType>
+	FORCE_INLINE SizeType Emplace(ArgsType&&... args)
+	{
+		return SiftUpLast(m_Heap.Emplace(Forward<ArgsType>(args)...));
+	}
+
+	ElementType Pop(bool allowShrinking = false)
+	{
+		Assert(m_Heap.Num() > 0);
+		ElementType result = MoveTemp(m_Heap[0]);
+		RemoveAt(0, allowShrinking);
+		return result;
+	}
+
+	bool Pop(ElementType& outItem, bool allowShrinking = false)
+	{
+		if (m_Heap.Num() == 0)
+		{
+			return false;
+		}
+
+		outItem = MoveTemp(m_Heap[0]);
+		RemoveAt(0, allowShrinking);
+
+		return true;
+	}
+
+	void RemoveAt(SizeType index, bool allowShrinking = false)
+	{
+		m_Heap.RemoveAtSwap(index, 1, allowShrinking);
+
+		const SizeType count = m_Heap.Num();
+		if (index < count)
+		{
+			Fly3DPrivateHeap::HeapSiftDown<Arity>(m_Heap.GetData(), index, count, m_Predicate);
+			Fly3DPrivateHeap::HeapSiftUp<Arity>(m_Heap.GetData(), (SizeType)0, index, m_Predicate);
+		}
+	}
+
+	/** Re-establishes heap order after the element at index was modified in place. */
+	void Update(SizeType index)
+	{
+		Fly3DPrivateHeap::HeapSiftDown<Arity>(m_Heap.GetData(), index, m_Heap.Num(), m_Predicate);
+		Fly3DPrivateHeap::HeapSiftUp<Arity>(m_Heap.GetData(), (SizeType)0, index, m_Predicate);
+	}
+
+	FORCE_INLINE const TArray<ElementType, Allocator>& GetArray() const
+	{
+		return m_Heap;
+	}
+
+private:
+
+	FORCE_INLINE SizeType SiftUpLast(SizeType index)
+	{
+		return Fly3DPrivateHeap::HeapSiftUp<Arity>(m_Heap.GetData(), (SizeType)0, index, m_Predicate);
+	}
+
+private:
+
+	TArray<ElementType, Allocator> m_Heap;
+	PredicateType                  m_Predicate;
+};
@@ -0,0 +1,477 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Utilities/Align.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Core/Containers/ContainerAllocationPolicies.h"
+#include "Runtime/Core/Containers/ArrayView.h"
+#include "Runtime/Template/IntegerSequence.h"
+#include "Runtime/Template/MemoryOps.h"
+#include "Runtime/Template/Template.h"
+
+namespace Fly3DPrivateSoAArray
+{
+	template <uint32 Index, typename... Types>
+	struct TNthType;
+
+	template <typename First, typename... Rest>
+	struct TNthType<0, First, Rest...>
+	{
+		typedef First Type;
+	};
+
+	template <uint32 Index, typename First, typename... Rest>
+	struct TNthType<Index, First, Rest...>
+	{
+		typedef typename TNthType<Index - 1, Rest...>::Type Type;
+	};
+}
+
+/**
+* Structure-of-arrays container. Every element type is stored in its own contiguous stream and all streams
+* share one allocation and one capacity, so a loop over a single field only touches that field's cache lines.
+* Streams start on MinStreamAlignment boundaries so they can be fed directly to aligned SIMD loads.
+*/
+template <typename... InElementTypes>
+class TSoAArray
+{
+	static_assert(sizeof...(InElementTypes) > 0, "TSoAArray needs at least one stream.");
+
+public:
+
+	typedef int32 SizeType;
+
+	enum
+	{
+		NumStreams = sizeof...(InElementTypes)
+	};
+
+	enum
+	{
+		MinStreamAlignment = 32
+	};
+
+	template <uint32 StreamIndex>
+	using TStreamType = typename Fly3DPrivateSoAArray::TNthType<StreamIndex, InElementTypes...>::Type;
+
+private:
+
+	typedef TMakeIntegerSequence<uint32, NumStreams> FStreamIndices;
+
+public:
+
+	TSoAArray()
+		: m_Data(nullptr)
+		, m_ArrayNum(0)
+		, m_ArrayMax(0)
+	{
+		ResetStreams();
+	}
+
+	TSoAArray(const TSoAArray& other)
+		: m_Data(nullptr)
+		, m_ArrayNum(0)
+		, m_ArrayMax(0)
+	{
+		ResetStreams();
+		CopyFrom(other);
+	}
+
+	TSoAArray(TSoAArray&& other)
+		: m_Data(nullptr)
+		, m_ArrayNum(0)
+		, m_ArrayMax(0)
+	{
+		ResetStreams();
+		MoveFrom(other);
+	}
+
+	TSoAArray& operator=(const TSoAArray& other)
+	{
+		if (this != &other)
+		{
+			Reset();
+			CopyFrom(other);
+		}
+		return *this;
+	}
+
+	TSoAArray& operator=(TSoAArray&& other)
+	{
+		if (this != &other)
+		{
+			Empty();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	~TSoAArray()
+	{
+		Empty();
+	}
+
+	FORCE_INLINE SizeType Num() const
+	{
+		return m_ArrayNum;
+	}
+
+	FORCE_INLINE SizeType Max() const
+	{
+		return m_ArrayMax;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_ArrayNum == 0;
+	}
+
+	FORCE_INLINE bool IsValidIndex(SizeType index) const
+	{
+		return index >= 0 && index < m_ArrayNum;
+	}
+
+	FORCE_INLINE void RangeCheck(SizeType index) const
+	{
+		AssertMsg((index >= 0) && (index < m_ArrayNum), "Array index out of bounds: %i from an array of size %i", index, m_ArrayNum);
+	}
+
+	size_t GetAllocatedSize() const
+	{
+		size_t offsets[NumStreams];
+		return m_ArrayMax ? CalculateLayout(m_ArrayMax, offsets) : 0;
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE TStreamType<StreamIndex>* GetStreamData()
+	{
+		return (TStreamType<StreamIndex>*)m_Streams[StreamIndex];
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE const TStreamType<StreamIndex>* GetStreamData() const
+	{
+		return (const TStreamType<StreamIndex>*)m_Streams[StreamIndex];
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE TArrayView<TStreamType<StreamIndex>> GetStream()
+	{
+		return TArrayView<TStreamType<StreamIndex>>(GetStreamData<StreamIndex>(), m_ArrayNum);
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE TArrayView<const TStreamType<StreamIndex>> GetStream() const
+	{
+		return TArrayView<const TStreamType<StreamIndex>>(GetStreamData<StreamIndex>(), m_ArrayNum);
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE TStreamType<StreamIndex>& Get(SizeType index)
+	{
+		RangeCheck(index);
+		return GetStreamData<StreamIndex>()[index];
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE const TStreamType<StreamIndex>& Get(SizeType index) const
+	{
+		RangeCheck(index);
+		return GetStreamData<StreamIndex>()[index];
+	}
+
+	FORCE_INLINE SizeType AddUninitialized(SizeType count = 1)
+	{
+		Assert(count >= 0);
+
+		const SizeType oldNum = m_ArrayNum;
+		if ((m_ArrayNum += count) > m_ArrayMax)
+		{
+			ResizeTo(DefaultCalculateSlackGrow(m_ArrayNum, m_ArrayMax, GetBytesPerElement()), oldNum);
+		}
+
+		return oldNum;
+	}
+
+	SizeType Add(const InElementTypes&... values)
+	{
+		const SizeType index = AddUninitialized(1);
+		CopyConstructAt(FStreamIndices(), index, values...);
+		return index;
+	}
+
+	template <typename... ArgsType>
+	SizeType Emplace(ArgsType&&... args)
+	{
+		static_assert(sizeof...(ArgsType) == NumStreams, "TSoAArray::Emplace expects one argument per stream.");
+
+		const SizeType index = AddUninitialized(1);
+		EmplaceAt(FStreamIndices(), index, Forward<ArgsType>(args)...);
+		return index;
+	}
+
+	SizeType AddDefaulted(SizeType count = 1)
+	{
+		const SizeType index = AddUninitialized(count);
+		DefaultConstructStreams(FStreamIndices(), index, count);
+		return index;
+	}
+
+	SizeType AddZeroed(SizeType count = 1)
+	{
+		const SizeType index = AddUninitialized(count);
+		ZeroStreams(FStreamIndices(), index, count);
+		return index;
+	}
+
+	void RemoveAtSwap(SizeType index, bool allowShrinking = true)
+	{
+		RangeCheck(index);
+
+		RemoveAtSwapStreams(FStreamIndices(), index, m_ArrayNum - 1);
+		--m_ArrayNum;
+
+		if (allowShrinking)
+		{
+			const SizeType newArrayMax = DefaultCalculateSlackShrink(m_ArrayNum, m_ArrayMax, GetBytesPerElement());
+			if (newArrayMax != m_ArrayMax)
+			{
+				ResizeTo(newArrayMax, m_ArrayNum);
+			}
+		}
+	}
+
+	FORCE_INLINE void Reserve(SizeType number)
+	{
+		Assert(number >= 0);
+
+		if (number > m_ArrayMax)
+		{
+			ResizeTo(number, m_ArrayNum);
+		}
+	}
+
+	void Reset()
+	{
+		DestructStreams(FStreamIndices());
+		m_ArrayNum = 0;
+	}
+
+	void Empty(SizeType slack = 0)
+	{
+		Assert(slack >= 0);
+
+		DestructStreams(FStreamIndices());
+		m_ArrayNum = 0;
+
+		if (m_ArrayMax != slack)
+		{
+			ResizeTo(slack, m_ArrayNum);
+		}
+	}
+
+	void Shrink()
+	{
+		if (m_ArrayMax != m_ArrayNum)
+		{
+			ResizeTo(m_ArrayNum, m_ArrayNum);
+		}
+	}
+
+private:
+
+	static size_t GetBytesPerElement()
+	{
+		static const size_t sizes[] = { sizeof(InElementTypes)... };
+
+		size_t bytes = 0;
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			bytes += sizes[i];
+		}
+
+		return bytes;
+	}
+
+	static size_t GetStreamAlignment(uint32 streamIndex)
+	{
+		static const size_t alignments[] = { alignof(InElementTypes)... };
+		return FMath::Max(alignments[streamIndex], (size_t)MinStreamAlignment);
+	}
+
+	static size_t CalculateLayout(SizeType capacity, size_t* outOffsets)
+	{
+		static const size_t sizes[] = { sizeof(InElementTypes)... };
+
+		size_t offset = 0;
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			offset = AlignUp(offset, GetStreamAlignment(i));
+			outOffsets[i] = offset;
+			offset += sizes[i] * capacity;
+		}
+
+		return offset;
+	}
+
+	static size_t GetBlockAlignment()
+	{
+		size_t alignment = MinStreamAlignment;
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			alignment = FMath::Max(alignment, GetStreamAlignment(i));
+		}
+
+		return alignment;
+	}
+
+	void ResetStreams()
+	{
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			m_Streams[i] = nullptr;
+		}
+	}
+
+	void ResizeTo(SizeType newMax, SizeType numToRelocate)
+	{
+		Assert(newMax >= m_ArrayNum && numToRelocate <= m_ArrayNum);
+
+		uint8* newData = nullptr;
+		void*  newStreams[NumStreams];
+
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			newStreams[i] = nullptr;
+		}
+
+		if (newMax)
+		{
+			size_t offsets[NumStreams];
+			const size_t totalSize = CalculateLayout(newMax, offsets);
+
+			newData = (uint8*)FLY3D_MALLOC_ALIGNED(totalSize, GetBlockAlignment(), kMemTypeSoAArray);
+			for (uint32 i = 0; i < NumStreams; ++i)
+			{
+				newStreams[i] = newData + offsets[i];
+			}
+		}
+
+		RelocateStreams(FStreamIndices(), newStreams, numToRelocate);
+
+		if (m_Data)
+		{
+			FLY3D_FREE(m_Data);
+		}
+
+		m_Data = newData;
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			m_Streams[i] = newStreams[i];
+		}
+
+		m_ArrayMax = newMax;
+	}
+
+	void CopyFrom(const TSoAArray& other)
+	{
+		Reserve(other.m_ArrayNum);
+		CopyStreams(FStreamIndices(), other);
+		m_ArrayNum = other.m_ArrayNum;
+	}
+
+	void MoveFrom(TSoAArray& other)
+	{
+		Assert(m_Data == nullptr);
+
+		m_Data     = other.m_Data;
+		m_ArrayNum = other.m_ArrayNum;
+		m_ArrayMax = other.m_ArrayMax;
+		for (uint32 i = 0; i < NumStreams; ++i)
+		{
+			m_Streams[i] = other.m_Streams[i];
+		}
+
+		other.m_Data     = nullptr;
+		other.m_ArrayNum = 0;
+		other.m_ArrayMax = 0;
+		other.ResetStreams();
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void CopyConstructAt(TIntegerSequence<uint32, StreamIndices...>, SizeType index, const InElementTypes&... values)
+	{
+		int32 dummy[] = { 0, (new (GetStreamData<StreamIndices>() + index) TStreamType<StreamIndices>(values), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices, typename... ArgsType>
+	FORCE_INLINE void EmplaceAt(TIntegerSequence<uint32, StreamIndices...>, SizeType index, ArgsType&&... args)
+	{
+		int32 dummy[] = { 0, (new (GetStreamData<StreamIndices>() + index) TStreamType<StreamIndices>(Forward<ArgsType>(args)), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void DefaultConstructStreams(TIntegerSequence<uint32, StreamIndices...>, SizeType index, SizeType count)
+	{
+		int32 dummy[] = { 0, (DefaultConstructItems<TStreamType<StreamIndices>>(GetStreamData<StreamIndices>() + index, count), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void ZeroStreams(TIntegerSequence<uint32, StreamIndices...>, SizeType index, SizeType count)
+	{
+		int32 dummy[] = { 0, (memset(GetStreamData<StreamIndices>() + index, 0, sizeof(TStreamType<StreamIndices>) * count), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void DestructStreams(TIntegerSequence<uint32, StreamIndices...>)
+	{
+		int32 dummy[] = { 0, (DestructItems(GetStreamData<StreamIndices>(), m_ArrayNum), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void RelocateStreams(TIntegerSequence<uint32, StreamIndices...>, void** newStreams, SizeType count)
+	{
+		int32 dummy[] = { 0, (RelocateConstructItems<TStreamType<StreamIndices>>(newStreams[StreamIndices], GetStreamData<StreamIndices>(), count), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void CopyStreams(TIntegerSequence<uint32, StreamIndices...>, const TSoAArray& other)
+	{
+		int32 dummy[] = { 0, (ConstructItems<TStreamType<StreamIndices>>(GetStreamData<StreamIndices>(), other.template GetStreamData<StreamIndices>(), other.m_ArrayNum), 0)... };
+		(void)dummy;
+	}
+
+	template <uint32 StreamIndex>
+	FORCE_INLINE void RemoveAtSwapStream(SizeType index, SizeType lastIndex)
+	{
+		TStreamType<StreamIndex>* data = GetStreamData<StreamIndex>();
+
+		DestructItem(data + index);
+		if (index != lastIndex)
+		{
+			RelocateConstructItems<TStreamType<StreamIndex>>(data + index, data + lastIndex, 1);
+		}
+	}
+
+	template <uint32... StreamIndices>
+	FORCE_INLINE void RemoveAtSwapStreams(TIntegerSequence<uint32, StreamIndices...>, SizeType index, SizeType lastIndex)
+	{
+		int32 dummy[] = { 0, (RemoveAtSwapStream<StreamIndices>(index, lastIndex), 0)... };
+		(void)dummy;
+	}
+
+private:
+
+	uint8*   m_Data;
+	void*    m_Streams[NumStreams];
+	SizeType m_ArrayNum;
+	SizeType m_ArrayMax;
+};
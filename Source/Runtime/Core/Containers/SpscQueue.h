@@ -0,0 +1,164 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/Containers/ContainerAllocationPolicies.h"
+#include "Runtime/Template/MemoryOps.h"
+#include "Runtime/Template/Template.h"
+
+/**
+* Bounded single-producer/single-consumer ring buffer. Exactly one thread may call Push/Emplace and exactly one
+* thread may call Pop/Peek. Each side keeps a cached copy of the other side's index on its own cache line,
+* so the shared index is only re-read when the cached value says the queue is full or empty.
+*/
+template <typename InElementType, typename InAllocator = FDefaultAllocator>
+class TSpscQueue
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef InAllocator   Allocator;
+
+public:
+
+	/** Capacity is rounded up to a power of two. */
+	explicit TSpscQueue(uint32 capacity)
+		: m_Capacity(FMath::RoundUpToPowerOfTwo(capacity))
+		, m_Mask(m_Capacity - 1)
+		, m_Tail(0)
+		, m_CachedHead(0)
+		, m_Head(0)
+		, m_CachedTail(0)
+	{
+		Assert(capacity > 0);
+		m_Storage.ResizeAllocation(0, m_Capacity, sizeof(ElementType));
+	}
+
+	~TSpscQueue()
+	{
+		ElementType* data = m_Storage.GetAllocation();
+		for (uint32 index = (uint32)m_Head; index != (uint32)m_Tail; ++index)
+		{
+			DestructItem(data + (index & m_Mask));
+		}
+	}
+
+	FORCE_INLINE uint32 Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	/** Only exact when called from the producer or consumer thread while the other side is idle. */
+	FORCE_INLINE uint32 Num() const
+	{
+		return (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_Tail) - (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_Head);
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	/** Producer only. Returns false if the queue is full. */
+	FORCE_INLINE bool Push(const ElementType& item)
+	{
+		return Emplace(item);
+	}
+
+	FORCE_INLINE bool Push(ElementType&& item)
+	{
+		return Emplace(MoveTempIfPossible(item));
+	}
+
+	template <typename... ArgsType>
+	bool Emplace(ArgsType&&... args)
+	{
+		const uint32 tail = (uint32)m_Tail;
+
+		if (tail - m_CachedHead == m_Capacity)
+		{
+			m_CachedHead = (uint32)FPlatformAtomics::AtomicRead(&m_Head, EMemoryOrder::Acquire);
+			if (tail - m_CachedHead == m_Capacity)
+			{
+				return false;
+			}
+		}
+
+		new (m_Storage.GetAllocation() + (tail & m_Mask)) ElementType(Forward<ArgsType>(args)...);
+		FPlatformAtomics::AtomicStore(&m_Tail, (int32)(tail + 1), EMemoryOrder::Release);
+
+		return true;
+	}
+
+	/** Consumer only. Returns false if the queue is empty. */
+	bool Pop(ElementType& outItem)
+	{
+		ElementType* item = Peek();
+		if (item == nullptr)
+		{
+			return false;
+		}
+
+		outItem = MoveTemp(*item);
+		PopDiscard();
+
+		return true;
+	}
+
+	/** Consumer only. Returns the oldest element without removing it, or nullptr if the queue is empty. */
+	ElementType* Peek()
+	{
+		const uint32 head = (uint32)m_Head;
+
+		if (head == m_CachedTail)
+		{
+			m_CachedTail = (uint32)FPlatformAtomics::AtomicRead(&m_Tail, EMemoryOrder::Acquire);
+			if (head == m_CachedTail)
+			{
+				return nullptr;
+			}
+		}
+
+		return m_Storage.GetAllocation() + (head & m_Mask);
+	}
+
+	/** Consumer only. Removes the element returned by the last successful Peek(). */
+	void PopDiscard()
+	{
+		const uint32 head = (uint32)m_Head;
+		Assert(head != m_CachedTail);
+
+		DestructItem(m_Storage.GetAllocation() + (head & m_Mask));
+		FPlatformAtomics::AtomicStore(&m_Head, (int32)(head + 1), EMemoryOrder::Release);
+	}
+
+private:
+
+	TSpscQueue(const TSpscQueue& other);
+
+	TSpscQueue& operator=(const TSpscQueue& other);
+
+private:
+
+	typedef typename Allocator::template ForElementType<ElementType> FStorage;
+
+	FStorage m_Storage;
+	uint32   m_Capacity;
+	uint32   m_Mask;
+
+	uint8 m_Pad0[PLATFORM_CACHE_LINE_SIZE];
+
+	// Written by the producer.
+	volatile int32 m_Tail;
+	uint32         m_CachedHead;
+
+	uint8 m_Pad1[PLATFORM_CACHE_LINE_SIZE - sizeof(int32) - sizeof(uint32)];
+
+	// Written by the consumer.
+	volatile int32 m_Head;
+	uint32         m_CachedTail;
+
+	uint8 m_Pad2[PLATFORM_CACHE_LINE_SIZE - sizeof(int32) - sizeof(uint32)];
+};
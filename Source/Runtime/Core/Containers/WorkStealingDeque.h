@@ -0,0 +1,149 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Log/Assert.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/Containers/ContainerAllocationPolicies.h"
+
+/**
+* Bounded work-stealing deque of pointers (Chase-Lev). The owning thread pushes and pops at the bottom like a
+* stack, which keeps recently spawned and still cache-hot work local, while any other thread may steal the
+* oldest element from the top. Push and Pop touch no shared cache line unless the deque is almost empty; only
+* Steal and the race for the last element pay for a CAS.
+*/
+template <typename InElementType, typename InAllocator = FDefaultAllocator>
+class TWorkStealingDeque
+{
+public:
+
+	typedef InElementType ElementType;
+	typedef InAllocator   Allocator;
+
+public:
+
+	/** Capacity is rounded up to a power of two. */
+	explicit TWorkStealingDeque(uint32 capacity)
+		: m_Capacity(FMath::RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity))
+		, m_Mask(m_Capacity - 1)
+		, m_Bottom(0)
+		, m_Top(0)
+	{
+		m_Storage.ResizeAllocation(0, m_Capacity, sizeof(ElementType*));
+	}
+
+	FORCE_INLINE uint32 Capacity() const
+	{
+		return m_Capacity;
+	}
+
+	/** Approximate while other threads are stealing. */
+	FORCE_INLINE uint32 Num() const
+	{
+		const int64 num = FPlatformAtomics::AtomicRead_Relaxed(&m_Bottom) - FPlatformAtomics::AtomicRead_Relaxed(&m_Top);
+		return num > 0 ? (uint32)num : 0;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	/** Owner only. Returns false if the deque is full. */
+	bool Push(ElementType* item)
+	{
+		const int64 bottom = FPlatformAtomics::AtomicRead_Relaxed(&m_Bottom);
+		const int64 top    = FPlatformAtomics::AtomicRead(&m_Top, EMemoryOrder::Acquire);
+
+		if (bottom - top >= (int64)m_Capacity)
+		{
+			return false;
+		}
+
+		FPlatformAtomics::AtomicStorePtr(GetSlot(bottom), item, EMemoryOrder::Relaxed);
+		FPlatformAtomics::AtomicStore(&m_Bottom, bottom + 1, EMemoryOrder::Release);
+
+		return true;
+	}
+
+	/** Owner only. Takes the newest element, nullptr if the deque is empty or a thief got the last one. */
+	ElementType* Pop()
+	{
+		const int64 bottom = FPlatformAtomics::AtomicRead_Relaxed(&m_Bottom) - 1;
+
+		// Reserving the bottom slot must be visible before top is read, a thief does the opposite.
+		FPlatformAtomics::InterlockedExchange(&m_Bottom, bottom);
+		int64 top = FPlatformAtomics::AtomicRead(&m_Top);
+
+		if (top > bottom)
+		{
+			FPlatformAtomics::AtomicStoreRelaxed(&m_Bottom, bottom + 1);
+			return nullptr;
+		}
+
+		ElementType* item = (ElementType*)FPlatformAtomics::AtomicReadPtr(GetSlot(bottom), EMemoryOrder::Relaxed);
+		if (top == bottom)
+		{
+			// The last element, race the thieves for it.
+			if (FPlatformAtomics::InterlockedCompareExchange(&m_Top, top + 1, top) != top)
+			{
+				item = nullptr;
+			}
+
+			FPlatformAtomics::AtomicStoreRelaxed(&m_Bottom, bottom + 1);
+		}
+
+		return item;
+	}
+
+	/** Any thread. Takes the oldest element, nullptr if the deque is empty or another thread won the race. */
+	ElementType* Steal()
+	{
+		const int64 top    = FPlatformAtomics::AtomicRead(&m_Top);
+		const int64 bottom = FPlatformAtomics::AtomicRead(&m_Bottom);
+
+		if (top >= bottom)
+		{
+			return nullptr;
+		}
+
+		ElementType* item = (ElementType*)FPlatformAtomics::AtomicReadPtr(GetSlot(top), EMemoryOrder::Relaxed);
+		if (FPlatformAtomics::InterlockedCompareExchange(&m_Top, top + 1, top) != top)
+		{
+			return nullptr;
+		}
+
+		return item;
+	}
+
+private:
+
+	TWorkStealingDeque(const TWorkStealingDeque& other);
+
+	TWorkStealingDeque& operator=(const TWorkStealingDeque& other);
+
+	FORCE_INLINE void* volatile* GetSlot(int64 index)
+	{
+		return (void* volatile*)(m_Storage.GetAllocation() + (index & m_Mask));
+	}
+
+private:
+
+	typedef typename Allocator::template ForElementType<ElementType*> FStorage;
+
+	FStorage m_Storage;
+	uint32   m_Capacity;
+	uint32   m_Mask;
+
+	uint8 m_Pad0[PLATFORM_CACHE_LINE_SIZE];
+
+	// Written by the owner.
+	volatile int64 m_Bottom;
+
+	uint8 m_Pad1[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+
+	// Advanced by thieves, and by the owner when it takes the last element.
+	volatile int64 m_Top;
+
+	uint8 m_Pad2[PLATFORM_CACHE_LINE_SIZE - sizeof(int64)];
+};
\ No newline at end of file
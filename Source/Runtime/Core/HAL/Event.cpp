@@ -0,0 +1,61 @@
+﻿#include "Runtime/Core/HAL/Event.h"
+#include "Runtime/Core/PlatformTime.h"
+
+void FEvent::Trigger()
+{
+	FPlatformAtomics::InterlockedExchange(&m_IsSignaled, 1);
+
+	// The sleeper counts itself before its last look at the event, so either it sees the signal or this sees it.
+	if (FPlatformAtomics::AtomicRead(&m_NumSleepers) > 0)
+	{
+		if (m_Mode == EMode::AutoReset)
+		{
+			FPlatformFutex::WakeOne(&m_IsSignaled);
+		}
+		else
+		{
+			FPlatformFutex::WakeAll(&m_IsSignaled);
+		}
+	}
+}
+
+bool FEvent::Wait(uint32 timeoutMs)
+{
+	if (TryConsume())
+	{
+		return true;
+	}
+
+	m_Stats.AddContended();
+
+	const double startTime   = FPlatformTime::Seconds();
+	uint32       remainingMs = timeoutMs;
+
+	while (true)
+	{
+		FPlatformAtomics::InterlockedIncrement(&m_NumSleepers);
+		if (FPlatformAtomics::AtomicRead(&m_IsSignaled) == 0 && remainingMs != 0)
+		{
+			m_Stats.AddSleep();
+			FPlatformFutex::Wait(&m_IsSignaled, 0, remainingMs);
+		}
+		FPlatformAtomics::InterlockedDecrement(&m_NumSleepers);
+
+		// Another waiter may have consumed the signal of an auto reset event first.
+		if (TryConsume())
+		{
+			return true;
+		}
+
+		if (timeoutMs != FPlatformFutex::WAIT_INFINITE)
+		{
+			const uint32 elapsedMs = (uint32)((FPlatformTime::Seconds() - startTime) * 1000.0);
+			if (elapsedMs >= timeoutMs)
+			{
+				return false;
+			}
+
+			remainingMs = timeoutMs - elapsedMs;
+		}
+	}
+}
\ No newline at end of file
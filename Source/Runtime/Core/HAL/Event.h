@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/PlatformFutex.h"
+#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Template/Noncopyable.h"
+
+/**
+* Lets threads sleep until another thread signals. Triggering an auto reset event releases one waiter, which
+* resets it; a manual reset event releases every waiter and stays signaled until Reset. Signaling and waiting on a
+* signaled event stay in userspace.
+*/
+class FEvent : public Noncopyable
+{
+public:
+
+	enum class EMode
+	{
+		AutoReset,
+		ManualReset,
+	};
+
+public:
+
+	explicit FEvent(EMode mode = EMode::AutoReset, bool isSignaled = false)
+		: m_IsSignaled(isSignaled ? 1 : 0)
+		, m_NumSleepers(0)
+		, m_Mode(mode)
+	{
+
+	}
+
+	void Trigger();
+
+	FORCE_INLINE void Reset()
+	{
+		FPlatformAtomics::AtomicStore(&m_IsSignaled, 0, EMemoryOrder::Relaxed);
+	}
+
+	FORCE_INLINE bool IsSignaled() const
+	{
+		return FPlatformAtomics::AtomicRead(&m_IsSignaled, EMemoryOrder::Acquire) != 0;
+	}
+
+	/** False if timeoutMs passed before the event was signaled. */
+	bool Wait(uint32 timeoutMs = FPlatformFutex::WAIT_INFINITE);
+
+	/** Contended counts the waits that found the event not signaled. */
+	FORCE_INLINE const FLockStats& GetStats() const
+	{
+		return m_Stats;
+	}
+
+private:
+
+	FORCE_INLINE bool TryConsume()
+	{
+		if (m_Mode == EMode::ManualReset)
+		{
+			return IsSignaled();
+		}
+
+		return FPlatformAtomics::InterlockedCompareExchange(&m_IsSignaled, 0, 1, EMemoryOrder::Acquire) == 1;
+	}
+
+private:
+
+	volatile int32 m_IsSignaled;
+	volatile int32 m_NumSleepers;
+	EMode          m_Mode;
+	FLockStats     m_Stats;
+};
\ No newline at end of file
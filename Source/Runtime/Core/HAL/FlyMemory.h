@@ -1,43 +1,48 @@
-﻿#include "Runtime/Platform/Platform.h"
-#include "Runtime/Log/Assert.h"
+﻿#pragma once
 
-#include <memory>
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformMemory.h"
 
 struct FMemory
 {
 	static FORCE_INLINE void* Memmove(void* dst, const void* src, size_t count)
 	{
-		return memmove(dst, src, count);
+		return FPlatformMemory::Memmove(dst, src, count);
 	}
 
 	static FORCE_INLINE int32 Memcmp(const void* buf1, const void* buf2, size_t count)
 	{
-		return memcmp(buf1, buf2, count);
+		return FPlatformMemory::Memcmp(buf1, buf2, count);
 	}
 
 	static FORCE_INLINE void* Memset(void* dst, uint8 Char, size_t count)
 	{
-		return memset(dst, Char, count);
+		return FPlatformMemory::Memset(dst, Char, count);
 	}
 
 	static FORCE_INLINE void* Memzero(void* dst, size_t count)
 	{
-		return memset(dst, 0, count);
+		return FPlatformMemory::Memzero(dst, count);
 	}
 
 	static FORCE_INLINE void* Memcpy(void* dst, const void* src, size_t count)
 	{
-		return memcpy(dst, src, count);
+		return FPlatformMemory::Memcpy(dst, src, count);
 	}
 
 	static FORCE_INLINE void* BigBlockMemcpy(void* dst, const void* src, size_t count)
 	{
-		return memcpy(dst, src, count);
+		return FPlatformMemory::BigBlockMemcpy(dst, src, count);
 	}
 
 	static FORCE_INLINE void* StreamingMemcpy(void* dst, const void* src, size_t count)
 	{
-		return memcpy( dst, src, count );
+		return FPlatformMemory::StreamingMemcpy(dst, src, count);
+	}
+
+	static FORCE_INLINE void Memswap(void* ptr1, void* ptr2, size_t size)
+	{
+		FPlatformMemory::Memswap(ptr1, ptr2, size);
 	}
 
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+﻿#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Core/PlatformFutex.h"
+
+namespace Fly3DPrivateMutex
+{
+	enum
+	{
+		/** Pauses of the last spin round before sleeping, the rounds double from one so all spinning takes 127 pauses. */
+		MAX_SPIN_BACKOFF = 64,
+
+		/** Backoff rounds a ticket lock waiter spins before it starts yielding its thread. */
+		MAX_TICKET_SPIN_ROUNDS = 64,
+	};
+
+	/** Pauses for backoff and doubles it, false once the spinning is used up. */
+	static FORCE_INLINE bool SpinBackoff(int32& backoff)
+	{
+		if (backoff > MAX_SPIN_BACKOFF)
+		{
+			return false;
+		}
+
+		for (int32 index = 0; index < backoff; ++index)
+		{
+			FPlatformAtomics::Pause();
+		}
+
+		backoff *= 2;
+		return true;
+	}
+}
+
+void FMutex::LockSlow()
+{
+	m_Stats.AddContended();
+
+	int32 backoff = 1;
+	while (Fly3DPrivateMutex::SpinBackoff(backoff))
+	{
+		if (FPlatformAtomics::AtomicRead(&m_State, EMemoryOrder::Relaxed) == UNLOCKED && TryLock())
+		{
+			return;
+		}
+	}
+
+	// A thread that sleeps takes the lock in the sleepers state when woken, it can not tell whether others still sleep.
+	while (FPlatformAtomics::InterlockedExchange(&m_State, LOCKED_WITH_SLEEPERS, EMemoryOrder::Acquire) != UNLOCKED)
+	{
+		m_Stats.AddSleep();
+		FPlatformFutex::Wait(&m_State, LOCKED_WITH_SLEEPERS);
+	}
+}
+
+void FMutex::WakeSleeper()
+{
+	FPlatformFutex::WakeOne(&m_State);
+}
+
+void FTicketLock::LockSlow(uint32 ticket)
+{
+	m_Stats.AddContended();
+
+	// Backs off in proportion to the place in the line, so waiters do not all hammer the line on every handover.
+	// The lock can not be handed over past a thread that lost its core, so a long wait yields to let it run.
+	for (int32 round = 0; ; ++round)
+	{
+		// The unsigned difference stays the place in the line when the counters wrap around.
+		const uint32 ahead = ticket - (uint32)FPlatformAtomics::AtomicRead(NowServing(), EMemoryOrder::Acquire);
+		if (ahead == 0)
+		{
+			return;
+		}
+
+		if (round >= Fly3DPrivateMutex::MAX_TICKET_SPIN_ROUNDS)
+		{
+			m_Stats.AddSleep();
+			FPlatformAtomics::YieldThread();
+			continue;
+		}
+
+		for (uint32 index = 0; index < ahead * 8; ++index)
+		{
+			FPlatformAtomics::Pause();
+		}
+	}
+}
+
+void FRWLock::ReadLockSlow()
+{
+	m_Stats.AddContended();
+
+	int32 backoff = 1;
+	while (true)
+	{
+		const int32 state = FPlatformAtomics::AtomicRead(&m_State, EMemoryOrder::Relaxed);
+		if ((state & WRITER) == 0)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&m_State, state + 1, state, EMemoryOrder::Acquire) == state)
+			{
+				return;
+			}
+
+			continue;
+		}
+
+		if (!Fly3DPrivateMutex::SpinBackoff(backoff))
+		{
+			SleepWhile(state);
+		}
+	}
+}
+
+void FRWLock::WriteLockSlow()
+{
+	m_Stats.AddContended();
+
+	int32 backoff = 1;
+	while (true)
+	{
+		const int32 state = FPlatformAtomics::AtomicRead(&m_State, EMemoryOrder::Relaxed);
+		if (state == 0)
+		{
+			if (FPlatformAtomics::InterlockedCompareExchange(&m_State, (int32)WRITER, 0, EMemoryOrder::Acquire) == 0)
+			{
+				return;
+			}
+
+			continue;
+		}
+
+		if (!Fly3DPrivateMutex::SpinBackoff(backoff))
+		{
+			SleepWhile(state);
+		}
+	}
+}
+
+void FRWLock::SleepWhile(int32 state)
+{
+	// Counted before the last look at the state, an unlock after that look sees the sleeper and wakes it.
+	FPlatformAtomics::InterlockedIncrement(&m_NumSleepers);
+
+	if (FPlatformAtomics::AtomicRead(&m_State) == state)
+	{
+		m_Stats.AddSleep();
+		FPlatformFutex::Wait(&m_State, state);
+	}
+
+	FPlatformAtomics::InterlockedDecrement(&m_NumSleepers);
+}
+
+void FRWLock::WakeAllSleepers()
+{
+	FPlatformFutex::WakeAll(&m_State);
+}
\ No newline at end of file
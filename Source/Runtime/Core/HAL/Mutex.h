@@ -0,0 +1,330 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Template/Noncopyable.h"
+
+/**
+* Contention counters of a lock, kept with ENABLE_LOCK_STATS. Only the slow paths count, so an uncontended
+* acquisition stays a single atomic operation either way.
+*/
+struct FLockStats
+{
+#if ENABLE_LOCK_STATS
+	FLockStats()
+		: NumContended(0)
+		, NumSleeps(0)
+	{
+
+	}
+
+	FORCE_INLINE void AddContended()
+	{
+		FPlatformAtomics::InterlockedIncrement(&NumContended, EMemoryOrder::Relaxed);
+	}
+
+	FORCE_INLINE void AddSleep()
+	{
+		FPlatformAtomics::InterlockedIncrement(&NumSleeps, EMemoryOrder::Relaxed);
+	}
+
+	/** Acquisitions that had to wait for another thread. */
+	FORCE_INLINE int32 GetNumContended() const
+	{
+		return FPlatformAtomics::AtomicRead_Relaxed(&NumContended);
+	}
+
+	/** Times a waiting thread went to sleep in the kernel. */
+	FORCE_INLINE int32 GetNumSleeps() const
+	{
+		return FPlatformAtomics::AtomicRead_Relaxed(&NumSleeps);
+	}
+
+	volatile int32 NumContended;
+	volatile int32 NumSleeps;
+#else
+	FORCE_INLINE void AddContended()
+	{
+
+	}
+
+	FORCE_INLINE void AddSleep()
+	{
+
+	}
+
+	FORCE_INLINE int32 GetNumContended() const
+	{
+		return 0;
+	}
+
+	FORCE_INLINE int32 GetNumSleeps() const
+	{
+		return 0;
+	}
+#endif
+};
+
+/**
+* Mutex that stays in userspace unless it has to sleep. A contended Lock spins with exponential backoff first,
+* which covers the short critical sections it is meant for, and only then sleeps on a futex. Not recursive.
+*/
+class FMutex : public Noncopyable
+{
+public:
+
+	FMutex()
+		: m_State(UNLOCKED)
+	{
+
+	}
+
+	FORCE_INLINE void Lock()
+	{
+		if (FPlatformAtomics::InterlockedCompareExchange(&m_State, LOCKED, UNLOCKED, EMemoryOrder::Acquire) != UNLOCKED)
+		{
+			LockSlow();
+		}
+	}
+
+	FORCE_INLINE bool TryLock()
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(&m_State, LOCKED, UNLOCKED, EMemoryOrder::Acquire) == UNLOCKED;
+	}
+
+	FORCE_INLINE void Unlock()
+	{
+		if (FPlatformAtomics::InterlockedExchange(&m_State, UNLOCKED, EMemoryOrder::Release) == LOCKED_WITH_SLEEPERS)
+		{
+			WakeSleeper();
+		}
+	}
+
+	FORCE_INLINE const FLockStats& GetStats() const
+	{
+		return m_Stats;
+	}
+
+private:
+
+	enum
+	{
+		UNLOCKED,
+		LOCKED,
+		LOCKED_WITH_SLEEPERS,
+	};
+
+	void LockSlow();
+
+	void WakeSleeper();
+
+private:
+
+	volatile int32 m_State;
+	FLockStats     m_Stats;
+};
+
+/** Spin lock that hands out the lock in the order it was asked for. For short critical sections under heavy contention. */
+class FTicketLock : public Noncopyable
+{
+public:
+
+	FTicketLock()
+		: m_NextTicket(0)
+		, m_NowServing(0)
+	{
+
+	}
+
+	FORCE_INLINE void Lock()
+	{
+		const uint32 ticket = (uint32)FPlatformAtomics::InterlockedAdd(NextTicket(), 1, EMemoryOrder::Relaxed);
+		if ((uint32)FPlatformAtomics::AtomicRead(NowServing(), EMemoryOrder::Acquire) != ticket)
+		{
+			LockSlow(ticket);
+		}
+	}
+
+	FORCE_INLINE bool TryLock()
+	{
+		const uint32 ticket = (uint32)FPlatformAtomics::AtomicRead(NowServing(), EMemoryOrder::Relaxed);
+		return (uint32)FPlatformAtomics::InterlockedCompareExchange(NextTicket(), (int32)(ticket + 1), (int32)ticket, EMemoryOrder::Acquire) == ticket;
+	}
+
+	FORCE_INLINE void Unlock()
+	{
+		// Only the holder writes m_NowServing.
+		FPlatformAtomics::AtomicStore(NowServing(), (int32)(m_NowServing + 1), EMemoryOrder::Release);
+	}
+
+	FORCE_INLINE const FLockStats& GetStats() const
+	{
+		return m_Stats;
+	}
+
+private:
+
+	void LockSlow(uint32 ticket);
+
+	/** The tickets are unsigned so that they wrap around instead of overflowing, the atomics operate on them as int32. */
+	FORCE_INLINE volatile int32* NextTicket()
+	{
+		return (volatile int32*)&m_NextTicket;
+	}
+
+	FORCE_INLINE volatile int32* NowServing()
+	{
+		return (volatile int32*)&m_NowServing;
+	}
+
+private:
+
+	volatile uint32 m_NextTicket;
+	volatile uint32 m_NowServing;
+	FLockStats     m_Stats;
+};
+
+/**
+* Reader-writer lock that favors readers: a reader gets in whenever no writer holds the lock, even while writers
+* wait. Suits registries that are read all the time and rarely changed, writers can starve under constant reads.
+*/
+class FRWLock : public Noncopyable
+{
+public:
+
+	FRWLock()
+		: m_State(0)
+		, m_NumSleepers(0)
+	{
+
+	}
+
+	FORCE_INLINE void ReadLock()
+	{
+		const int32 state = FPlatformAtomics::AtomicRead(&m_State, EMemoryOrder::Relaxed);
+		if ((state & WRITER) != 0 || FPlatformAtomics::InterlockedCompareExchange(&m_State, state + 1, state, EMemoryOrder::Acquire) != state)
+		{
+			ReadLockSlow();
+		}
+	}
+
+	FORCE_INLINE void ReadUnlock()
+	{
+		// The last reader out lets waiting writers in.
+		if (FPlatformAtomics::InterlockedAdd(&m_State, -1) == 1)
+		{
+			WakeSleepers();
+		}
+	}
+
+	FORCE_INLINE void WriteLock()
+	{
+		if (FPlatformAtomics::InterlockedCompareExchange(&m_State, (int32)WRITER, 0, EMemoryOrder::Acquire) != 0)
+		{
+			WriteLockSlow();
+		}
+	}
+
+	FORCE_INLINE void WriteUnlock()
+	{
+		FPlatformAtomics::InterlockedAdd(&m_State, -(int32)WRITER);
+		WakeSleepers();
+	}
+
+	FORCE_INLINE const FLockStats& GetStats() const
+	{
+		return m_Stats;
+	}
+
+private:
+
+	enum : int32
+	{
+		/** Set while a writer holds the lock, the bits below count the readers. */
+		WRITER = 1 << 30,
+	};
+
+	void ReadLockSlow();
+
+	void WriteLockSlow();
+
+	/** Sleeps until m_State changes from state. */
+	void SleepWhile(int32 state);
+
+	FORCE_INLINE void WakeSleepers()
+	{
+		if (FPlatformAtomics::AtomicRead(&m_NumSleepers) > 0)
+		{
+			WakeAllSleepers();
+		}
+	}
+
+	void WakeAllSleepers();
+
+private:
+
+	volatile int32 m_State;
+	volatile int32 m_NumSleepers;
+	FLockStats     m_Stats;
+};
+
+template <typename LockType>
+class TScopeLock : public Noncopyable
+{
+public:
+
+	explicit TScopeLock(LockType& lock)
+		: m_Lock(lock)
+	{
+		m_Lock.Lock();
+	}
+
+	~TScopeLock()
+	{
+		m_Lock.Unlock();
+	}
+
+private:
+
+	LockType& m_Lock;
+};
+
+class FReadScopeLock : public Noncopyable
+{
+public:
+
+	explicit FReadScopeLock(FRWLock& lock)
+		: m_Lock(lock)
+	{
+		m_Lock.ReadLock();
+	}
+
+	~FReadScopeLock()
+	{
+		m_Lock.ReadUnlock();
+	}
+
+private:
+
+	FRWLock& m_Lock;
+};
+
+class FWriteScopeLock : public Noncopyable
+{
+public:
+
+	explicit FWriteScopeLock(FRWLock& lock)
+		: m_Lock(lock)
+	{
+		m_Lock.WriteLock();
+	}
+
+	~FWriteScopeLock()
+	{
+		m_Lock.WriteUnlock();
+	}
+
+private:
+
+	FRWLock& m_Lock;
+};
\ No newline at end of file
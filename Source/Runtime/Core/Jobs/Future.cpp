@@ -0,0 +1,70 @@
+﻿#include "Runtime/Core/Jobs/Future.h"
+
+namespace Fly3DPrivateFuture
+{
+	void FFutureStateBase::Wait()
+	{
+		if (FJobSystem::GetCurrentThreadIndex() == INDEX_NONE)
+		{
+			m_ReadyEvent.Wait();
+			return;
+		}
+
+		// The work that sets the result may be queued behind this thread, so it must not sleep.
+		while (!IsReady())
+		{
+			if (!FJobSystem::TryExecuteOne())
+			{
+				FPlatformAtomics::YieldThread();
+			}
+		}
+	}
+
+	void FFutureStateBase::AddContinuation(TUniqueFunction<void()>&& continuation)
+	{
+		{
+			TScopeLock<FMutex> lock(m_Mutex);
+			if (!IsReady())
+			{
+				m_Continuations.Emplace(MoveTemp(continuation));
+				return;
+			}
+		}
+
+		FJobSystem::Run(MoveTemp(continuation));
+	}
+
+	void FFutureStateBase::MarkReady()
+	{
+		{
+			// Under the lock, so a continuation added concurrently is either in the list or sees the result.
+			TScopeLock<FMutex> lock(m_Mutex);
+			m_ReadyEvent.Trigger();
+		}
+
+		// Once ready nothing is added anymore, so the list is read without the lock. The caller holds a reference,
+		// the state outlives continuations that run right away.
+		for (TUniqueFunction<void()>& continuation : m_Continuations)
+		{
+			FJobSystem::Run(MoveTemp(continuation));
+		}
+
+		m_Continuations.Empty();
+	}
+
+	void FWhenAllState::OnFutureReady()
+	{
+		if (FPlatformAtomics::InterlockedDecrement(&m_NumPending, EMemoryOrder::AcquireRelease) == 0)
+		{
+			SetResult();
+		}
+	}
+
+	void FWhenAnyState::OnFutureReady(int32 index)
+	{
+		if (FPlatformAtomics::InterlockedCompareExchange(&m_IsDecided, 1, 0, EMemoryOrder::Relaxed) == 0)
+		{
+			SetResult(index);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,539 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/HAL/Event.h"
+#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Template/Decay.h"
+#include "Runtime/Template/Function.h"
+#include "Runtime/Template/Noncopyable.h"
+#include "Runtime/Template/RefCounting.h"
+#include "Runtime/Template/Template.h"
+#include "Runtime/Template/TypeCompatibleBytes.h"
+
+template <typename ResultType>
+class TFuture;
+
+template <typename ResultType>
+class TPromise;
+
+namespace Fly3DPrivateFuture
+{
+	/**
+	* What a promise and its future share: whether the result was set and what runs once it is. Allocated with
+	* FLY3D_NEW and freed by the last TRefCountPtr through FThreadSafeRefCountedObject::Release.
+	*/
+	class FFutureStateBase : public FThreadSafeRefCountedObject
+	{
+	public:
+
+		enum
+		{
+			/** A future usually gets one continuation from Then, plus one per WhenAll or WhenAny it is given to. */
+			NUM_INLINE_CONTINUATIONS = 2
+		};
+
+		FFutureStateBase()
+			: m_ReadyEvent(FEvent::EMode::ManualReset)
+		{
+
+		}
+
+		/** Acquire, so the result is visible once this returns true. */
+		FORCE_INLINE bool IsReady() const
+		{
+			return m_ReadyEvent.IsSignaled();
+		}
+
+		/** Job system threads execute jobs while waiting, any other thread sleeps. */
+		void Wait();
+
+		/** Queues continuation as a job once the result is set, right away if it already is. */
+		void AddContinuation(TUniqueFunction<void()>&& continuation);
+
+	protected:
+
+		/** Called once the result was stored, queues the continuations. */
+		void MarkReady();
+
+	private:
+
+		FEvent                          m_ReadyEvent;
+		FMutex                          m_Mutex;
+		TArray<TUniqueFunction<void()>, TInlineAllocator<NUM_INLINE_CONTINUATIONS>> m_Continuations;
+	};
+
+	template <typename ResultType>
+	class TFutureState : public FFutureStateBase
+	{
+	public:
+
+		virtual ~TFutureState()
+		{
+			if (IsReady())
+			{
+				m_Result.GetTypedPtr()->~ResultType();
+			}
+		}
+
+		template <typename... ArgTypes>
+		void SetResult(ArgTypes&&... args)
+		{
+			AssertMsg(!IsReady(), "The result of a promise was set twice\n");
+
+			new ((void*)m_Result.GetTypedPtr()) ResultType(Forward<ArgTypes>(args)...);
+			MarkReady();
+		}
+
+		FORCE_INLINE ResultType& GetResult()
+		{
+			return *m_Result.GetTypedPtr();
+		}
+
+	private:
+
+		TTypeCompatibleBytes<ResultType> m_Result;
+	};
+
+	template <>
+	class TFutureState<void> : public FFutureStateBase
+	{
+	public:
+
+		FORCE_INLINE void SetResult()
+		{
+			AssertMsg(!IsReady(), "The result of a promise was set twice\n");
+			MarkReady();
+		}
+	};
+
+	/** Ready once every future given to WhenAll is. */
+	class FWhenAllState : public TFutureState<void>
+	{
+	public:
+
+		explicit FWhenAllState(int32 numPending)
+			: m_NumPending(numPending)
+		{
+
+		}
+
+		void OnFutureReady();
+
+	private:
+
+		volatile int32 m_NumPending;
+	};
+
+	/** Holds the index of the first future given to WhenAny that became ready. */
+	class FWhenAnyState : public TFutureState<int32>
+	{
+	public:
+
+		FWhenAnyState()
+			: m_IsDecided(0)
+		{
+
+		}
+
+		void OnFutureReady(int32 index);
+
+	private:
+
+		volatile int32 m_IsDecided;
+	};
+
+	template <typename FuncType, typename ResultType>
+	struct TContinuationResult
+	{
+		typedef typename TDecay<decltype(DeclVal<FuncType&>()(DeclVal<ResultType>()))>::Type Type;
+	};
+
+	template <typename FuncType>
+	struct TContinuationResult<FuncType, void>
+	{
+		typedef typename TDecay<decltype(DeclVal<FuncType&>()())>::Type Type;
+	};
+
+	template <typename ResultType>
+	struct TSetResultFromCall
+	{
+		template <typename FuncType, typename... ArgTypes>
+		static FORCE_INLINE void Call(TFutureState<ResultType>& state, FuncType& func, ArgTypes&&... args)
+		{
+			state.SetResult(func(Forward<ArgTypes>(args)...));
+		}
+	};
+
+	template <>
+	struct TSetResultFromCall<void>
+	{
+		template <typename FuncType, typename... ArgTypes>
+		static FORCE_INLINE void Call(TFutureState<void>& state, FuncType& func, ArgTypes&&... args)
+		{
+			func(Forward<ArgTypes>(args)...);
+			state.SetResult();
+		}
+	};
+
+	/** The future was consumed by Then, so the continuation is the only reader and may take the result. */
+	template <typename NextType, typename FuncType, typename ResultType>
+	FORCE_INLINE void RunContinuation(TFutureState<NextType>& next, FuncType& func, TFutureState<ResultType>& state)
+	{
+		TSetResultFromCall<NextType>::Call(next, func, MoveTemp(state.GetResult()));
+	}
+
+	template <typename NextType, typename FuncType>
+	FORCE_INLINE void RunContinuation(TFutureState<NextType>& next, FuncType& func, TFutureState<void>& state)
+	{
+		TSetResultFromCall<NextType>::Call(next, func);
+	}
+
+	/**
+	* The job queued by Then. A functor rather than a lambda so that func is moved in, not copied. It holds two state
+	* handles next to func, so TUniqueFunction keeps it inline only while func is at most FUNCTION_INLINE_SIZE minus
+	* two pointers, larger captures go to the heap. The next state is allocated either way.
+	*/
+	template <typename FuncType, typename ResultType, typename NextType>
+	class TContinuation
+	{
+	public:
+
+		TContinuation(FuncType&& func, TRefCountPtr<TFutureState<ResultType>>&& state, const TRefCountPtr<TFutureState<NextType>>& next)
+			: m_Func(MoveTemp(func))
+			, m_State(MoveTemp(state))
+			, m_Next(next)
+		{
+
+		}
+
+		void operator()()
+		{
+			RunContinuation(*m_Next, m_Func, *m_State);
+		}
+
+	private:
+
+		FuncType                               m_Func;
+		TRefCountPtr<TFutureState<ResultType>> m_State;
+		TRefCountPtr<TFutureState<NextType>>   m_Next;
+	};
+
+	template <typename FuncType, typename ResultType>
+	class TAsyncJob
+	{
+	public:
+
+		TAsyncJob(FuncType&& func, const TRefCountPtr<TFutureState<ResultType>>& state)
+			: m_Func(MoveTemp(func))
+			, m_State(state)
+		{
+
+		}
+
+		void operator()()
+		{
+			TSetResultFromCall<ResultType>::Call(*m_State, m_Func);
+		}
+
+	private:
+
+		FuncType                               m_Func;
+		TRefCountPtr<TFutureState<ResultType>> m_State;
+	};
+
+	template <typename ResultType>
+	class TFutureBase : public Noncopyable
+	{
+	public:
+
+		FORCE_INLINE bool IsValid() const
+		{
+			return m_State.IsValid();
+		}
+
+		/** False for a future that is not valid, such as a default constructed one or one consumed by Then. */
+		FORCE_INLINE bool IsReady() const
+		{
+			return m_State.IsValid() && m_State->IsReady();
+		}
+
+		FORCE_INLINE void Wait() const
+		{
+			AssertMsg(IsValid(), "Wait called on a future that is not valid\n");
+
+			if (!m_State->IsReady())
+			{
+				m_State->Wait();
+			}
+		}
+
+		/**
+		* Calls func with the result as a job once it is set, and returns the future of what func returns. Consumes
+		* this future, func receives the result as an rvalue. func takes no argument if ResultType is void.
+		*/
+		template <typename FuncType>
+		TFuture<typename TContinuationResult<typename TDecay<FuncType>::Type, ResultType>::Type> Then(FuncType&& func)
+		{
+			typedef typename TDecay<FuncType>::Type                                 DecayedFuncType;
+			typedef typename TContinuationResult<DecayedFuncType, ResultType>::Type NextType;
+
+			AssertMsg(IsValid(), "Then called on a future that is not valid\n");
+
+			TRefCountPtr<TFutureState<NextType>>   next(FLY3D_NEW(TFutureState<NextType>, kMemTypeJob)());
+			TRefCountPtr<TFutureState<ResultType>> state(MoveTemp(m_State));
+
+			TFutureState<ResultType>& stateRef = *state;
+			stateRef.AddContinuation(TContinuation<DecayedFuncType, ResultType, NextType>(DecayedFuncType(Forward<FuncType>(func)), MoveTemp(state), next));
+
+			return TFuture<NextType>(next);
+		}
+
+	protected:
+
+		TFutureBase()
+		{
+
+		}
+
+		explicit TFutureBase(const TRefCountPtr<TFutureState<ResultType>>& state)
+			: m_State(state)
+		{
+
+		}
+
+		TFutureBase(TFutureBase&& other)
+			: m_State(MoveTemp(other.m_State))
+		{
+
+		}
+
+		FORCE_INLINE void MoveFrom(TFutureBase&& other)
+		{
+			m_State = MoveTemp(other.m_State);
+		}
+
+	protected:
+
+		TRefCountPtr<TFutureState<ResultType>> m_State;
+	};
+}
+
+/**
+* The result of asynchronous work such as an asset load or a file read, set later through the TPromise it came
+* from. Rather than waiting for it, chain the work that needs the result with Then: it runs as a job once the
+* result is set, so a chain of asynchronous steps holds no thread while it waits. Move only.
+*
+*	TFuture<FString> text = FFileSystem::ReadTextAsync(path);
+*	TFuture<int32> numLines = text.Then([](FString&& str) { return CountLines(str); });
+*/
+template <typename ResultType>
+class TFuture : public Fly3DPrivateFuture::TFutureBase<ResultType>
+{
+	typedef Fly3DPrivateFuture::TFutureBase<ResultType> Super;
+
+	friend class TPromise<ResultType>;
+
+	template <typename OtherType>
+	friend class Fly3DPrivateFuture::TFutureBase;
+
+	template <typename FuncType>
+	friend TFuture<typename Fly3DPrivateFuture::TContinuationResult<typename TDecay<FuncType>::Type, void>::Type> Async(FuncType&& func);
+
+	template <typename OtherType>
+	friend TFuture<void> WhenAll(const TArray<TFuture<OtherType>>& futures);
+
+	template <typename OtherType>
+	friend TFuture<int32> WhenAny(const TArray<TFuture<OtherType>>& futures);
+
+public:
+
+	TFuture()
+	{
+
+	}
+
+	TFuture(TFuture&& other)
+		: Super(MoveTemp(other))
+	{
+
+	}
+
+	TFuture& operator=(TFuture&& other)
+	{
+		Super::MoveFrom(MoveTemp(other));
+		return *this;
+	}
+
+	/** Waits for the result, which stays owned by the future. */
+	const ResultType& Get() const
+	{
+		Super::Wait();
+		return Super::m_State->GetResult();
+	}
+
+private:
+
+	explicit TFuture(const TRefCountPtr<Fly3DPrivateFuture::TFutureState<ResultType>>& state)
+		: Super(state)
+	{
+
+	}
+};
+
+template <>
+class TFuture<void> : public Fly3DPrivateFuture::TFutureBase<void>
+{
+	typedef Fly3DPrivateFuture::TFutureBase<void> Super;
+
+	friend class TPromise<void>;
+
+	template <typename OtherType>
+	friend class Fly3DPrivateFuture::TFutureBase;
+
+	template <typename FuncType>
+	friend TFuture<typename Fly3DPrivateFuture::TContinuationResult<typename TDecay<FuncType>::Type, void>::Type> Async(FuncType&& func);
+
+	template <typename OtherType>
+	friend TFuture<void> WhenAll(const TArray<TFuture<OtherType>>& futures);
+
+	template <typename OtherType>
+	friend TFuture<int32> WhenAny(const TArray<TFuture<OtherType>>& futures);
+
+public:
+
+	TFuture()
+	{
+
+	}
+
+	TFuture(TFuture&& other)
+		: Super(MoveTemp(other))
+	{
+
+	}
+
+	TFuture& operator=(TFuture&& other)
+	{
+		Super::MoveFrom(MoveTemp(other));
+		return *this;
+	}
+
+	FORCE_INLINE void Get() const
+	{
+		Super::Wait();
+	}
+
+private:
+
+	explicit TFuture(const TRefCountPtr<Fly3DPrivateFuture::TFutureState<void>>& state)
+		: Super(state)
+	{
+
+	}
+};
+
+/** Sets the result of the future it hands out, once, from any thread. Must be set before it is destroyed. */
+template <typename ResultType>
+class TPromise : public Noncopyable
+{
+public:
+
+	TPromise()
+		: m_State(FLY3D_NEW(Fly3DPrivateFuture::TFutureState<ResultType>, kMemTypeJob)())
+		, m_IsFutureRetrieved(false)
+	{
+
+	}
+
+	TPromise(TPromise&& other)
+		: m_State(MoveTemp(other.m_State))
+		, m_IsFutureRetrieved(other.m_IsFutureRetrieved)
+	{
+
+	}
+
+	~TPromise()
+	{
+		AssertMsg(!m_State.IsValid() || m_State->IsReady(), "TPromise destroyed without a result, its future would never be ready\n");
+	}
+
+	TFuture<ResultType> GetFuture()
+	{
+		AssertMsg(!m_IsFutureRetrieved, "The future of a promise can only be retrieved once\n");
+
+		m_IsFutureRetrieved = true;
+		return TFuture<ResultType>(m_State);
+	}
+
+	/** Constructs the result from args and queues the continuations. */
+	template <typename... ArgTypes>
+	FORCE_INLINE void SetValue(ArgTypes&&... args)
+	{
+		m_State->SetResult(Forward<ArgTypes>(args)...);
+	}
+
+private:
+
+	TRefCountPtr<Fly3DPrivateFuture::TFutureState<ResultType>> m_State;
+	bool                                                      m_IsFutureRetrieved;
+};
+
+/** Runs func as a job and returns the future of what it returns. */
+template <typename FuncType>
+TFuture<typename Fly3DPrivateFuture::TContinuationResult<typename TDecay<FuncType>::Type, void>::Type> Async(FuncType&& func)
+{
+	typedef typename TDecay<FuncType>::Type                                               DecayedFuncType;
+	typedef typename Fly3DPrivateFuture::TContinuationResult<DecayedFuncType, void>::Type ResultType;
+
+	TRefCountPtr<Fly3DPrivateFuture::TFutureState<ResultType>> state(FLY3D_NEW(Fly3DPrivateFuture::TFutureState<ResultType>, kMemTypeJob)());
+	FJobSystem::Run(Fly3DPrivateFuture::TAsyncJob<DecayedFuncType, ResultType>(DecayedFuncType(Forward<FuncType>(func)), state));
+
+	return TFuture<ResultType>(state);
+}
+
+/**
+* Ready once all futures are. The futures stay valid and their results can be read after. Then on one of them still
+* consumes it as usual: the future becomes invalid and its result is moved into the continuation.
+*/
+template <typename ResultType>
+TFuture<void> WhenAll(const TArray<TFuture<ResultType>>& futures)
+{
+	TRefCountPtr<Fly3DPrivateFuture::FWhenAllState> state(FLY3D_NEW(Fly3DPrivateFuture::FWhenAllState, kMemTypeJob)(futures.Num()));
+
+	if (futures.Num() == 0)
+	{
+		state->SetResult();
+	}
+
+	for (const TFuture<ResultType>& future : futures)
+	{
+		AssertMsg(future.IsValid(), "WhenAll given a future that is not valid\n");
+
+		TRefCountPtr<Fly3DPrivateFuture::FWhenAllState> stateRef(state);
+		future.m_State->AddContinuation([stateRef]() { stateRef->OnFutureReady(); });
+	}
+
+	return TFuture<void>(TRefCountPtr<Fly3DPrivateFuture::TFutureState<void>>(state));
+}
+
+/** Ready with the index of the first of futures that is. The futures stay valid, see WhenAll about Then. */
+template <typename ResultType>
+TFuture<int32> WhenAny(const TArray<TFuture<ResultType>>& futures)
+{
+	AssertMsg(futures.Num() > 0, "WhenAny needs at least one future\n");
+
+	TRefCountPtr<Fly3DPrivateFuture::FWhenAnyState> state(FLY3D_NEW(Fly3DPrivateFuture::FWhenAnyState, kMemTypeJob)());
+
+	for (int32 index = 0; index < futures.Num(); ++index)
+	{
+		AssertMsg(futures[index].IsValid(), "WhenAny given a future that is not valid\n");
+
+		TRefCountPtr<Fly3DPrivateFuture::FWhenAnyState> stateRef(state);
+		futures[index].m_State->AddContinuation([stateRef, index]() { stateRef->OnFutureReady(index); });
+	}
+
+	return TFuture<int32>(TRefCountPtr<Fly3DPrivateFuture::TFutureState<int32>>(state));
+}
\ No newline at end of file
@@ -0,0 +1,672 @@
+﻿#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/WorkStealingDeque.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+
+#if JOB_SYSTEM_USE_FIBERS
+#include "Runtime/Core/PlatformFiber.h"
+#include "Runtime/Core/Containers/MpmcQueue.h"
+#endif
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Fly3DPrivateJobs
+{
+	enum
+	{
+		/** Rounds of looking for work with a pause in between before a worker goes to sleep. */
+		IDLE_SPIN_COUNT = 64,
+	};
+
+	struct FJob
+	{
+		TUniqueFunction<void()> Task;
+		FJobCounter*            Counter;
+		volatile int32          IsPending;
+	};
+
+#if JOB_SYSTEM_USE_FIBERS
+	/** A fiber of the pool, or the one a thread was converted into, which only ever runs on that thread. */
+	struct FJobFiber
+	{
+		FFiberContext* Context;
+		FJobFiber*     NextWaiter;
+		int32          PinnedThread;
+	};
+#endif
+
+	/** A thread's deque and the ring its jobs are taken from, only the owning thread allocates from it. */
+	struct FJobThread
+	{
+		FJobThread()
+			: Deque(FJobSystem::MAX_JOBS_PER_THREAD)
+			, NextJob(0)
+			, RandomState(0)
+#if JOB_SYSTEM_USE_FIBERS
+			, CurrentFiber(nullptr)
+			, PinnedReady(nullptr)
+			, PendingUnlock(nullptr)
+			, PendingFree(nullptr)
+			, PendingReady(nullptr)
+#endif
+		{
+			Jobs = (FJob*)FLY3D_MALLOC_ALIGNED(sizeof(FJob) * FJobSystem::MAX_JOBS_PER_THREAD, alignof(FJob), kMemTypeJob);
+			for (int32 index = 0; index < FJobSystem::MAX_JOBS_PER_THREAD; ++index)
+			{
+				FJob* job = new (Jobs + index) FJob();
+				job->Counter   = nullptr;
+				job->IsPending = 0;
+			}
+		}
+
+		~FJobThread()
+		{
+			for (int32 index = 0; index < FJobSystem::MAX_JOBS_PER_THREAD; ++index)
+			{
+				Jobs[index].~FJob();
+			}
+
+			FLY3D_FREE(Jobs);
+		}
+
+		TWorkStealingDeque<FJob> Deque;
+		FJob*                    Jobs;
+		uint32                   NextJob;
+		uint32                   RandomState;
+
+#if JOB_SYSTEM_USE_FIBERS
+		FJobFiber          ThreadFiber;
+		FJobFiber*         CurrentFiber;
+
+		/** ThreadFiber once it may resume. */
+		FJobFiber* volatile PinnedReady;
+
+		/** Left by a switch for the fiber switched to, the switching fiber can not do it before its state is saved. */
+		volatile int32*    PendingUnlock;
+		FJobFiber*         PendingFree;
+		FJobFiber*         PendingReady;
+#endif
+	};
+
+	static thread_local int32 s_ThreadIndex = INDEX_NONE;
+
+	/** A fiber may continue on another thread after a switch, where a thread local address cached before it is wrong. */
+	static FORCE_NOINLINE int32 GetThreadIndex()
+	{
+		return s_ThreadIndex;
+	}
+
+#if JOB_SYSTEM_USE_FIBERS
+	static FORCE_INLINE void LockWaiters(volatile int32* lock)
+	{
+		while (FPlatformAtomics::InterlockedCompareExchange(lock, 1, 0, EMemoryOrder::Acquire) != 0)
+		{
+			FPlatformAtomics::Pause();
+		}
+	}
+#endif
+
+	class FJobScheduler : public Noncopyable
+	{
+	public:
+
+		explicit FJobScheduler(int32 numWorkers)
+			: m_NumThreads(numWorkers + 1)
+			, m_IsStopping(0)
+			, m_NumSleeping(0)
+#if JOB_SYSTEM_USE_FIBERS
+			, m_FreeFibers(FJobSystem::NUM_FIBERS)
+			, m_ReadyFibers(FJobSystem::NUM_FIBERS)
+#endif
+		{
+			m_Threads = (FJobThread*)FLY3D_MALLOC_ALIGNED(sizeof(FJobThread) * m_NumThreads, PLATFORM_CACHE_LINE_SIZE, kMemTypeJob);
+			for (int32 index = 0; index < m_NumThreads; ++index)
+			{
+				new (m_Threads + index) FJobThread();
+				m_Threads[index].RandomState = 0x9E3779B9u * (uint32)(index + 1);
+			}
+
+			s_ThreadIndex = 0;
+
+#if JOB_SYSTEM_USE_FIBERS
+			m_Fibers = (FJobFiber*)FLY3D_MALLOC(sizeof(FJobFiber) * FJobSystem::NUM_FIBERS, kMemTypeJob);
+			for (int32 index = 0; index < FJobSystem::NUM_FIBERS; ++index)
+			{
+				m_Fibers[index].Context      = FPlatformFiber::Create(FJobSystem::FIBER_STACK_SIZE, &FJobScheduler::FiberMain, this);
+				m_Fibers[index].NextWaiter   = nullptr;
+				m_Fibers[index].PinnedThread = INDEX_NONE;
+				m_FreeFibers.Push(&m_Fibers[index]);
+			}
+
+			ConvertThreadToFiber(0);
+#endif
+
+			m_Workers.Reserve(numWorkers);
+			for (int32 index = 1; index < m_NumThreads; ++index)
+			{
+				m_Workers.Emplace([this, index]() { WorkerMain(index); });
+			}
+		}
+
+		~FJobScheduler()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				FPlatformAtomics::AtomicStore(&m_IsStopping, 1);
+			}
+			m_WakeUp.notify_all();
+
+			for (int32 index = 0; index < m_Workers.Num(); ++index)
+			{
+				m_Workers[index].join();
+			}
+
+#if JOB_SYSTEM_USE_FIBERS
+			FPlatformFiber::ConvertFiberToThread(m_Threads[0].ThreadFiber.Context);
+
+			AssertMsg(m_FreeFibers.Num() == FJobSystem::NUM_FIBERS, "Job system shut down while jobs still wait\n");
+			for (int32 index = 0; index < FJobSystem::NUM_FIBERS; ++index)
+			{
+				FPlatformFiber::Delete(m_Fibers[index].Context);
+			}
+
+			FLY3D_FREE(m_Fibers);
+#endif
+
+			s_ThreadIndex = INDEX_NONE;
+
+			for (int32 index = 0; index < m_NumThreads; ++index)
+			{
+				m_Threads[index].~FJobThread();
+			}
+
+			FLY3D_FREE(m_Threads);
+		}
+
+		FORCE_INLINE int32 GetNumWorkers() const
+		{
+			return m_NumThreads - 1;
+		}
+
+		void Submit(int32 threadIndex, TUniqueFunction<void()>&& task, FJobCounter* counter)
+		{
+			FJob* job = GetNextJob(threadIndex);
+
+			// The ring wrapped onto a job that has not run yet, work until it has. A job run meanwhile may wait and
+			// bring this fiber back on another thread, whose ring is used then.
+			while (FPlatformAtomics::AtomicRead(&job->IsPending, EMemoryOrder::Acquire))
+			{
+				if (!TryExecuteOne(threadIndex))
+				{
+					FPlatformAtomics::Pause();
+				}
+
+				threadIndex = GetThreadIndex();
+				job         = GetNextJob(threadIndex);
+			}
+
+			FJobThread& thread = m_Threads[threadIndex];
+			thread.NextJob += 1;
+
+			job->Task      = MoveTemp(task);
+			job->Counter   = counter;
+			job->IsPending = 1;
+
+			// The deque holds as many jobs as the ring, so a full deque means a pending job in the ring.
+			const bool pushed = thread.Deque.Push(job);
+			Assert(pushed);
+
+			WakeWorker();
+		}
+
+		bool TryExecuteOne(int32 threadIndex)
+		{
+			FJob* job = FindJob(threadIndex);
+			if (job == nullptr)
+			{
+				return false;
+			}
+
+			Execute(job);
+			return true;
+		}
+
+#if JOB_SYSTEM_USE_FIBERS
+		/** Parks the running fiber on counter, false if the pool has no fiber to continue with. */
+		bool WaitOnFiber(int32 threadIndex, const FJobCounter& counter)
+		{
+			FJobFiber* next = nullptr;
+			if (!m_FreeFibers.Pop(next))
+			{
+				return false;
+			}
+
+			LockWaiters(&counter.m_WaitLock);
+
+			if (FPlatformAtomics::AtomicRead(&counter.m_Count, EMemoryOrder::Acquire) == 0)
+			{
+				FPlatformAtomics::AtomicStore(&counter.m_WaitLock, 0, EMemoryOrder::Release);
+				m_FreeFibers.Push(next);
+				return true;
+			}
+
+			FJobFiber* current = m_Threads[threadIndex].CurrentFiber;
+			current->NextWaiter = counter.m_Waiters;
+			counter.m_Waiters   = current;
+
+			// next unlocks, a job finishing the counter before this fiber is saved would resume it too early.
+			SwitchTo(threadIndex, next, &counter.m_WaitLock, nullptr, nullptr);
+			return true;
+		}
+
+		/** Continues with a fiber whose counter finished, the running fiber becomes ready in turn. */
+		bool YieldToReadyFiber(int32 threadIndex)
+		{
+			FJobFiber* ready = PopReadyFiber(threadIndex);
+			if (ready == nullptr)
+			{
+				return false;
+			}
+
+			SwitchTo(threadIndex, ready, nullptr, nullptr, m_Threads[threadIndex].CurrentFiber);
+			return true;
+		}
+#endif
+
+	private:
+
+		void WorkerMain(int32 threadIndex)
+		{
+			s_ThreadIndex = threadIndex;
+
+#if JOB_SYSTEM_USE_FIBERS
+			ConvertThreadToFiber(threadIndex);
+
+			FJobFiber* fiber = nullptr;
+			const bool popped = m_FreeFibers.Pop(fiber);
+			Assert(popped);
+
+			// Comes back once the pool fiber saw the scheduler stop.
+			SwitchTo(threadIndex, fiber, nullptr, nullptr, nullptr);
+
+			FPlatformFiber::ConvertFiberToThread(m_Threads[threadIndex].ThreadFiber.Context);
+#else
+			WorkLoop();
+#endif
+		}
+
+		/** Executes jobs until the scheduler stops. With fibers it runs on pool fibers and the thread may change. */
+		void WorkLoop()
+		{
+			int32 spin = 0;
+
+			while (true)
+			{
+				const int32 threadIndex = GetThreadIndex();
+
+#if JOB_SYSTEM_USE_FIBERS
+				if (ResumeReadyFiber(threadIndex))
+				{
+					spin = 0;
+					continue;
+				}
+#endif
+
+				if (TryExecuteOne(threadIndex))
+				{
+					spin = 0;
+					continue;
+				}
+
+				FPlatformAtomics::Pause();
+
+				// The thread that called Startup only gets here while its own fiber waits, it must not sleep.
+				if (threadIndex == 0 || ++spin < IDLE_SPIN_COUNT)
+				{
+					continue;
+				}
+
+				spin = 0;
+
+				std::unique_lock<std::mutex> lock(m_SleepMutex);
+				if (FPlatformAtomics::AtomicRead_Relaxed(&m_IsStopping))
+				{
+					break;
+				}
+
+				// Announce the sleep before the last look, a thread pushing after that look sees it in WakeWorker.
+				FPlatformAtomics::InterlockedIncrement(&m_NumSleeping);
+				if (!HasQueuedJobs())
+				{
+					m_WakeUp.wait(lock);
+				}
+				FPlatformAtomics::InterlockedDecrement(&m_NumSleeping);
+			}
+		}
+
+		FORCE_INLINE FJob* GetNextJob(int32 threadIndex)
+		{
+			FJobThread& thread = m_Threads[threadIndex];
+			return &thread.Jobs[thread.NextJob & (FJobSystem::MAX_JOBS_PER_THREAD - 1)];
+		}
+
+		FJob* FindJob(int32 threadIndex)
+		{
+			FJobThread& thread = m_Threads[threadIndex];
+
+			FJob* job = thread.Deque.Pop();
+			if (job)
+			{
+				return job;
+			}
+
+			// Start at a random victim so thieves spread out instead of all hitting the same deque.
+			thread.RandomState ^= thread.RandomState << 13;
+			thread.RandomState ^= thread.RandomState >> 17;
+			thread.RandomState ^= thread.RandomState << 5;
+
+			const int32 first = (int32)(thread.RandomState % (uint32)m_NumThreads);
+			for (int32 offset = 0; offset < m_NumThreads; ++offset)
+			{
+				const int32 victim = (first + offset) % m_NumThreads;
+				if (victim != threadIndex)
+				{
+					job = m_Threads[victim].Deque.Steal();
+					if (job)
+					{
+						return job;
+					}
+				}
+			}
+
+			return nullptr;
+		}
+
+		void Execute(FJob* job)
+		{
+			job->Task();
+
+			// Captures are released before the counter signals, waiters may own what they reference.
+			job->Task = nullptr;
+
+			if (job->Counter)
+			{
+#if JOB_SYSTEM_USE_FIBERS
+				FinishCount(*job->Counter);
+#else
+				FPlatformAtomics::InterlockedDecrement(&job->Counter->m_Count, EMemoryOrder::AcquireRelease);
+#endif
+			}
+
+			FPlatformAtomics::AtomicStore(&job->IsPending, 0, EMemoryOrder::Release);
+		}
+
+		bool HasQueuedJobs() const
+		{
+#if JOB_SYSTEM_USE_FIBERS
+			if (!m_ReadyFibers.IsEmpty())
+			{
+				return true;
+			}
+#endif
+
+			for (int32 index = 0; index < m_NumThreads; ++index)
+			{
+				if (!m_Threads[index].Deque.IsEmpty())
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void WakeWorker()
+		{
+			// A full barrier between the push and this read, pairs with the increment in WorkLoop.
+			if (FPlatformAtomics::InterlockedAdd(&m_NumSleeping, 0) > 0)
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				m_WakeUp.notify_one();
+			}
+		}
+
+#if JOB_SYSTEM_USE_FIBERS
+		static void FiberMain(void* arg)
+		{
+			FJobScheduler* scheduler = (FJobScheduler*)arg;
+
+			scheduler->FinishSwitch();
+			scheduler->WorkLoop();
+
+			// Stopping, back to the fiber the worker thread was converted into so that it can exit.
+			const int32 threadIndex = GetThreadIndex();
+			FJobThread& thread      = scheduler->m_Threads[threadIndex];
+			scheduler->SwitchTo(threadIndex, &thread.ThreadFiber, nullptr, thread.CurrentFiber, nullptr);
+		}
+
+		void ConvertThreadToFiber(int32 threadIndex)
+		{
+			FJobThread& thread = m_Threads[threadIndex];
+			thread.ThreadFiber.Context      = FPlatformFiber::ConvertThreadToFiber();
+			thread.ThreadFiber.NextWaiter   = nullptr;
+			thread.ThreadFiber.PinnedThread = threadIndex;
+			thread.CurrentFiber             = &thread.ThreadFiber;
+		}
+
+		/** Switches the running fiber to target, then unlocks, frees or readies as the fiber switched to. */
+		void SwitchTo(int32 threadIndex, FJobFiber* target, volatile int32* unlock, FJobFiber* free, FJobFiber* ready)
+		{
+			FJobThread& thread  = m_Threads[threadIndex];
+			FJobFiber*  current = thread.CurrentFiber;
+
+			thread.PendingUnlock = unlock;
+			thread.PendingFree   = free;
+			thread.PendingReady  = ready;
+			thread.CurrentFiber  = target;
+
+			FPlatformFiber::Switch(current->Context, target->Context);
+
+			FinishSwitch();
+		}
+
+		void FinishSwitch()
+		{
+			FJobThread& thread = m_Threads[GetThreadIndex()];
+
+			if (thread.PendingUnlock)
+			{
+				FPlatformAtomics::AtomicStore(thread.PendingUnlock, 0, EMemoryOrder::Release);
+				thread.PendingUnlock = nullptr;
+			}
+
+			if (thread.PendingFree)
+			{
+				m_FreeFibers.Push(thread.PendingFree);
+				thread.PendingFree = nullptr;
+			}
+
+			if (thread.PendingReady)
+			{
+				MakeReady(thread.PendingReady);
+				thread.PendingReady = nullptr;
+			}
+		}
+
+		void FinishCount(FJobCounter& counter)
+		{
+			LockWaiters(&counter.m_WaitLock);
+
+			FJobFiber* waiters = nullptr;
+			if (FPlatformAtomics::InterlockedDecrement(&counter.m_Count, EMemoryOrder::AcquireRelease) == 0)
+			{
+				waiters           = counter.m_Waiters;
+				counter.m_Waiters = nullptr;
+			}
+
+			// The counter may be gone right after the unlock.
+			FPlatformAtomics::AtomicStore(&counter.m_WaitLock, 0, EMemoryOrder::Release);
+
+			while (waiters)
+			{
+				FJobFiber* next = waiters->NextWaiter;
+				MakeReady(waiters);
+				waiters = next;
+			}
+		}
+
+		void MakeReady(FJobFiber* fiber)
+		{
+			// Only the thread that called Startup waits on its own fiber, and that thread never sleeps.
+			if (fiber->PinnedThread != INDEX_NONE)
+			{
+				FPlatformAtomics::AtomicStorePtr((void* volatile*)&m_Threads[fiber->PinnedThread].PinnedReady, fiber, EMemoryOrder::Release);
+				return;
+			}
+
+			const bool pushed = m_ReadyFibers.Push(fiber);
+			Assert(pushed);
+
+			WakeWorker();
+		}
+
+		FJobFiber* PopReadyFiber(int32 threadIndex)
+		{
+			FJobThread& thread = m_Threads[threadIndex];
+
+			FJobFiber* fiber = (FJobFiber*)FPlatformAtomics::AtomicReadPtr((void* volatile const*)&thread.PinnedReady, EMemoryOrder::Acquire);
+			if (fiber)
+			{
+				thread.PinnedReady = nullptr;
+				return fiber;
+			}
+
+			return m_ReadyFibers.Pop(fiber) ? fiber : nullptr;
+		}
+
+		/** From the work loop, which runs on a pool fiber that goes back to the pool. */
+		bool ResumeReadyFiber(int32 threadIndex)
+		{
+			FJobFiber* ready = PopReadyFiber(threadIndex);
+			if (ready == nullptr)
+			{
+				return false;
+			}
+
+			SwitchTo(threadIndex, ready, nullptr, m_Threads[threadIndex].CurrentFiber, nullptr);
+			return true;
+		}
+#endif
+
+	private:
+
+		FJobThread*         m_Threads;
+		int32               m_NumThreads;
+		TArray<std::thread> m_Workers;
+
+		volatile int32          m_IsStopping;
+		volatile int32          m_NumSleeping;
+		std::mutex              m_SleepMutex;
+		std::condition_variable m_WakeUp;
+
+#if JOB_SYSTEM_USE_FIBERS
+		FJobFiber*              m_Fibers;
+		TMpmcQueue<FJobFiber*>  m_FreeFibers;
+		TMpmcQueue<FJobFiber*>  m_ReadyFibers;
+#endif
+	};
+
+	static FJobScheduler* s_Scheduler = nullptr;
+}
+
+void FJobSystem::Startup(int32 numWorkers)
+{
+	AssertMsg(Fly3DPrivateJobs::s_Scheduler == nullptr, "Job system is already running\n");
+
+	if (numWorkers < 0)
+	{
+		const int32 numHardwareThreads = (int32)std::thread::hardware_concurrency();
+		numWorkers = numHardwareThreads > 1 ? numHardwareThreads - 1 : 0;
+	}
+
+	numWorkers = numWorkers < MAX_WORKERS ? numWorkers : MAX_WORKERS;
+
+	Fly3DPrivateJobs::s_Scheduler = FLY3D_NEW(Fly3DPrivateJobs::FJobScheduler, kMemTypeJob)(numWorkers);
+}
+
+void FJobSystem::Shutdown()
+{
+	FLY3D_DELETE(Fly3DPrivateJobs::s_Scheduler);
+}
+
+bool FJobSystem::IsRunning()
+{
+	return Fly3DPrivateJobs::s_Scheduler != nullptr;
+}
+
+int32 FJobSystem::GetNumWorkers()
+{
+	return Fly3DPrivateJobs::s_Scheduler ? Fly3DPrivateJobs::s_Scheduler->GetNumWorkers() : 0;
+}
+
+int32 FJobSystem::GetCurrentThreadIndex()
+{
+	return Fly3DPrivateJobs::s_ThreadIndex;
+}
+
+void FJobSystem::Run(TUniqueFunction<void()>&& task, FJobCounter* counter)
+{
+	const int32 threadIndex = Fly3DPrivateJobs::s_ThreadIndex;
+
+	if (Fly3DPrivateJobs::s_Scheduler == nullptr || threadIndex == INDEX_NONE)
+	{
+		task();
+		return;
+	}
+
+	if (counter)
+	{
+		FPlatformAtomics::InterlockedIncrement(&counter->m_Count, EMemoryOrder::Relaxed);
+	}
+
+	Fly3DPrivateJobs::s_Scheduler->Submit(threadIndex, MoveTemp(task), counter);
+}
+
+void FJobSystem::Wait(const FJobCounter& counter)
+{
+#if JOB_SYSTEM_USE_FIBERS
+	const int32 threadIndex = Fly3DPrivateJobs::s_ThreadIndex;
+	if (Fly3DPrivateJobs::s_Scheduler != nullptr && threadIndex != INDEX_NONE && !counter.IsDone() && Fly3DPrivateJobs::s_Scheduler->WaitOnFiber(threadIndex, counter))
+	{
+		return;
+	}
+#endif
+
+	while (!counter.IsDone())
+	{
+		if (!TryExecuteOne())
+		{
+			FPlatformAtomics::Pause();
+		}
+	}
+}
+
+bool FJobSystem::TryExecuteOne()
+{
+	const int32 threadIndex = Fly3DPrivateJobs::GetThreadIndex();
+	if (Fly3DPrivateJobs::s_Scheduler == nullptr || threadIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+#if JOB_SYSTEM_USE_FIBERS
+	if (Fly3DPrivateJobs::s_Scheduler->YieldToReadyFiber(threadIndex))
+	{
+		return true;
+	}
+#endif
+
+	return Fly3DPrivateJobs::s_Scheduler->TryExecuteOne(threadIndex);
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Template/Function.h"
+#include "Runtime/Template/Noncopyable.h"
+
+namespace Fly3DPrivateJobs
+{
+	class FJobScheduler;
+	struct FJobFiber;
+}
+
+/** Number of unfinished jobs started with it. Must outlive those jobs, wait for it with FJobSystem::Wait. */
+class FJobCounter : public Noncopyable
+{
+	friend class FJobSystem;
+	friend class Fly3DPrivateJobs::FJobScheduler;
+
+public:
+
+	FJobCounter()
+		: m_Count(0)
+#if JOB_SYSTEM_USE_FIBERS
+		, m_WaitLock(0)
+		, m_Waiters(nullptr)
+#endif
+	{
+
+	}
+
+	~FJobCounter()
+	{
+		AssertMsg(IsDone(), "FJobCounter destroyed while jobs still reference it\n");
+	}
+
+	/** Acquire, so everything the finished jobs wrote is visible once this returns true. */
+	FORCE_INLINE bool IsDone() const
+	{
+#if JOB_SYSTEM_USE_FIBERS
+		// The last job holds the lock until it is done with the waiters, the counter may only go away after that.
+		return FPlatformAtomics::AtomicRead(&m_Count, EMemoryOrder::Acquire) == 0 && FPlatformAtomics::AtomicRead(&m_WaitLock, EMemoryOrder::Acquire) == 0;
+#else
+		return FPlatformAtomics::AtomicRead(&m_Count, EMemoryOrder::Acquire) == 0;
+#endif
+	}
+
+private:
+
+	volatile int32 m_Count;
+
+#if JOB_SYSTEM_USE_FIBERS
+	/** Fibers parked in FJobSystem::Wait, resumed by the job that brings the count to zero. */
+	mutable volatile int32               m_WaitLock;
+	mutable Fly3DPrivateJobs::FJobFiber* m_Waiters;
+#endif
+};
+
+/**
+* Work-stealing job system. The thread that calls Startup and every worker own a Chase-Lev deque; a job is
+* pushed on the deque of the thread that runs it and idle threads steal the oldest jobs of the others. Workers
+* that find nothing to do spin briefly and then sleep until new work is pushed.
+*
+* Waiting never blocks a thread: Wait keeps executing queued jobs until the counter drops to zero, so jobs may
+* start and wait for sub-jobs. Jobs can only be queued from the job system threads; on any other thread, and
+* before Startup or after Shutdown, Run executes the task immediately.
+*
+* With JOB_SYSTEM_USE_FIBERS every thread runs jobs on fibers from a shared pool. Wait then parks the fiber of
+* the waiting job until the counter drops to zero and the thread carries on with another fiber, so a chain of
+* waiting jobs holds neither threads nor stack depth. A parked job may resume on another thread, so a job must not
+* hold thread_local state across Wait: a FMemStack& from FMemStack::Get() or a FMemMark would then belong to another
+* thread, and a flag such as the render thread's s_IsRenderThread may no longer describe the running thread. Look
+* them up again after Wait returns. When the pool is exhausted Wait falls back to executing jobs.
+*/
+class FJobSystem
+{
+public:
+
+	enum
+	{
+		MAX_WORKERS = 63,
+
+		/** Jobs one thread may have queued and not yet finished. Past that Run helps out until a slot frees up. */
+		MAX_JOBS_PER_THREAD = 4096,
+
+		/** Fibers shared by all threads with JOB_SYSTEM_USE_FIBERS: one per running thread plus one per waiting job. */
+		NUM_FIBERS = 128,
+
+		FIBER_STACK_SIZE = 64 * 1024,
+	};
+
+public:
+
+	/** Starts numWorkers worker threads, one less than the number of hardware threads if negative. */
+	static void Startup(int32 numWorkers = -1);
+
+	/** Stops the workers. All jobs must have finished. */
+	static void Shutdown();
+
+	static bool IsRunning();
+
+	static int32 GetNumWorkers();
+
+	/** 0 on the thread that called Startup, 1 to GetNumWorkers() on the workers and INDEX_NONE on any other thread. */
+	static int32 GetCurrentThreadIndex();
+
+	/** Queues task, counter (optional) is incremented now and decremented once the task returned. */
+	static void Run(TUniqueFunction<void()>&& task, FJobCounter* counter = nullptr);
+
+	/** Executes queued jobs until counter drops to zero. With fibers the caller may return on another thread. */
+	static void Wait(const FJobCounter& counter);
+
+	/**
+	* Executes one queued job if there is any, for threads that wait on something other than a FJobCounter. With
+	* fibers it may resume a job whose counter finished instead.
+	*/
+	static bool TryExecuteOne();
+};
\ No newline at end of file
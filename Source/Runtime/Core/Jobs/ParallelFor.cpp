@@ -0,0 +1,72 @@
+﻿#include "Runtime/Core/Jobs/ParallelFor.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+namespace Fly3DPrivateParallelFor
+{
+	struct FState
+	{
+		volatile int32            Next;
+		int32                     Num;
+		int32                     MinBatchSize;
+		int32                     NumThreads;
+		TFunctionRef<void(int32)> Body;
+	};
+
+	static void ProcessBatches(FState& state)
+	{
+		while (true)
+		{
+			const int32 start = FPlatformAtomics::AtomicRead_Relaxed(&state.Next);
+			if (start >= state.Num)
+			{
+				return;
+			}
+
+			const int32 guidedSize = (state.Num - start) / (state.NumThreads * 2);
+			const int32 batchSize  = guidedSize > state.MinBatchSize ? guidedSize : state.MinBatchSize;
+			const int32 end        = state.Num - start > batchSize ? start + batchSize : state.Num;
+
+			if (FPlatformAtomics::InterlockedCompareExchange(&state.Next, end, start, EMemoryOrder::Relaxed) != start)
+			{
+				continue;
+			}
+
+			for (int32 index = start; index < end; ++index)
+			{
+				state.Body(index);
+			}
+		}
+	}
+}
+
+void ParallelFor(int32 num, TFunctionRef<void(int32)> body, int32 minBatchSize)
+{
+	minBatchSize = minBatchSize > 1 ? minBatchSize : 1;
+
+	const int32 numThreads = FJobSystem::GetNumWorkers() + 1;
+	if (num <= minBatchSize || numThreads == 1 || FJobSystem::GetCurrentThreadIndex() < 0)
+	{
+		for (int32 index = 0; index < num; ++index)
+		{
+			body(index);
+		}
+
+		return;
+	}
+
+	Fly3DPrivateParallelFor::FState state = { 0, num, minBatchSize, numThreads, body };
+
+	// Helpers beyond the number of batches would only fight over the cursor.
+	const int32 numBatches = (num + minBatchSize - 1) / minBatchSize;
+	const int32 numHelpers = numBatches - 1 < numThreads - 1 ? numBatches - 1 : numThreads - 1;
+
+	FJobCounter counter;
+	for (int32 helper = 0; helper < numHelpers; ++helper)
+	{
+		FJobSystem::Run([&state]() { Fly3DPrivateParallelFor::ProcessBatches(state); }, &counter);
+	}
+
+	Fly3DPrivateParallelFor::ProcessBatches(state);
+	FJobSystem::Wait(counter);
+}
\ No newline at end of file
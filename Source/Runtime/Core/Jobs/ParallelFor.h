@@ -0,0 +1,12 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/Function.h"
+
+/**
+* Calls body(index) for every index in [0, num) on the job system threads and returns once all calls finished.
+* The threads take batches off a shared cursor, sized to a fraction of what is left: big batches while there
+* is plenty of work keep the overhead low, small ones at the end even out iterations of uneven cost. No batch
+* is smaller than minBatchSize, raise it for cheap bodies so that the cursor does not become the bottleneck.
+*/
+void ParallelFor(int32 num, TFunctionRef<void(int32)> body, int32 minBatchSize = 1);
\ No newline at end of file
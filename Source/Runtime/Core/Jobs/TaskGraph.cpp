@@ -0,0 +1,209 @@
+﻿#include "Runtime/Core/Jobs/TaskGraph.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/PlatformTime.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+
+FTaskGraph::FTaskGraph()
+	: m_IsCompiled(false)
+	, m_MainThreadTasks(nullptr)
+	, m_NumUnfinished(0)
+	, m_CriticalPathTime(0.0)
+	, m_ExecuteTime(0.0)
+{
+
+}
+
+FTaskGraph::~FTaskGraph()
+{
+	FLY3D_DELETE(m_MainThreadTasks);
+}
+
+FTaskGraph::FTaskHandle FTaskGraph::AddTask(FName name, TFunction<void()>&& task, ETaskThread thread)
+{
+	FTaskNode& node = m_Nodes[m_Nodes.AddDefaulted()];
+	node.Name                    = name;
+	node.Task                    = MoveTemp(task);
+	node.Thread                  = thread;
+	node.NumPendingPrerequisites = 0;
+	node.StartTime               = 0.0;
+	node.EndTime                 = 0.0;
+
+	m_IsCompiled = false;
+	return m_Nodes.Num() - 1;
+}
+
+void FTaskGraph::AddPrerequisite(FTaskHandle task, FTaskHandle prerequisite)
+{
+	Assert(task >= 0 && task < m_Nodes.Num() && prerequisite >= 0 && prerequisite < m_Nodes.Num() && task != prerequisite);
+
+	m_Nodes[task].Prerequisites.AddUnique(prerequisite);
+	m_Nodes[prerequisite].Dependents.AddUnique(task);
+
+	m_IsCompiled = false;
+}
+
+void FTaskGraph::Compile()
+{
+	const int32 numTasks = m_Nodes.Num();
+
+	// Kahn's algorithm, NumPendingPrerequisites doubles as the in-degree.
+	m_SortedTasks.Reset();
+	m_SortedTasks.Reserve(numTasks);
+
+	for (FTaskHandle task = 0; task < numTasks; ++task)
+	{
+		m_Nodes[task].NumPendingPrerequisites = m_Nodes[task].Prerequisites.Num();
+		if (m_Nodes[task].NumPendingPrerequisites == 0)
+		{
+			m_SortedTasks.Add(task);
+		}
+	}
+
+	for (int32 index = 0; index < m_SortedTasks.Num(); ++index)
+	{
+		const TArray<FTaskHandle>& dependents = m_Nodes[m_SortedTasks[index]].Dependents;
+		for (int32 dependent = 0; dependent < dependents.Num(); ++dependent)
+		{
+			if (--m_Nodes[dependents[dependent]].NumPendingPrerequisites == 0)
+			{
+				m_SortedTasks.Add(dependents[dependent]);
+			}
+		}
+	}
+
+	AssertMsg(m_SortedTasks.Num() == numTasks, "Task graph has a cycle\n");
+
+	FLY3D_DELETE(m_MainThreadTasks);
+	m_MainThreadTasks = FLY3D_NEW(TMpmcQueue<FTaskHandle>, kMemTypeJob)(numTasks);
+
+	m_PathTimes.SetNumUninitialized(numTasks);
+	m_PathPrevious.SetNumUninitialized(numTasks);
+	m_CriticalPath.Reserve(numTasks);
+
+	m_IsCompiled = true;
+}
+
+void FTaskGraph::Execute()
+{
+	if (!m_IsCompiled)
+	{
+		Compile();
+	}
+
+	const int32 numTasks = m_Nodes.Num();
+	if (numTasks == 0)
+	{
+		return;
+	}
+
+	const double startTime = FPlatformTime::Seconds();
+
+	for (FTaskHandle task = 0; task < numTasks; ++task)
+	{
+		m_Nodes[task].NumPendingPrerequisites = m_Nodes[task].Prerequisites.Num();
+	}
+
+	FPlatformAtomics::AtomicStore(&m_NumUnfinished, numTasks, EMemoryOrder::Relaxed);
+
+	for (FTaskHandle task = 0; task < numTasks; ++task)
+	{
+		if (m_Nodes[task].Prerequisites.Num() == 0)
+		{
+			Dispatch(task);
+		}
+	}
+
+	while (FPlatformAtomics::AtomicRead(&m_NumUnfinished, EMemoryOrder::Acquire) != 0)
+	{
+		FTaskHandle task;
+		if (m_MainThreadTasks->Pop(task))
+		{
+			RunTask(task);
+		}
+		else if (!FJobSystem::TryExecuteOne())
+		{
+			FPlatformAtomics::Pause();
+		}
+	}
+
+	UpdateCriticalPath(startTime);
+}
+
+void FTaskGraph::Dispatch(FTaskHandle task)
+{
+	// Without workers everything runs on the thread in Execute.
+	if (m_Nodes[task].Thread == ETaskThread::Main || FJobSystem::GetNumWorkers() == 0)
+	{
+		const bool pushed = m_MainThreadTasks->Push(task);
+		Assert(pushed);
+		return;
+	}
+
+	FJobSystem::Run([this, task]() { RunTask(task); });
+}
+
+void FTaskGraph::RunTask(FTaskHandle task)
+{
+	FTaskNode& node = m_Nodes[task];
+
+	node.StartTime = FPlatformTime::Seconds();
+	node.Task();
+	node.EndTime = FPlatformTime::Seconds();
+
+	for (int32 index = 0; index < node.Dependents.Num(); ++index)
+	{
+		const FTaskHandle dependent = node.Dependents[index];
+		if (FPlatformAtomics::InterlockedDecrement(&m_Nodes[dependent].NumPendingPrerequisites, EMemoryOrder::AcquireRelease) == 0)
+		{
+			Dispatch(dependent);
+		}
+	}
+
+	FPlatformAtomics::InterlockedDecrement(&m_NumUnfinished, EMemoryOrder::AcquireRelease);
+}
+
+void FTaskGraph::UpdateCriticalPath(double startTime)
+{
+	FTaskHandle last = INDEX_NONE;
+	double      endTime = startTime;
+
+	// Longest chain ending at each task, prerequisites are visited first thanks to the sort.
+	for (int32 index = 0; index < m_SortedTasks.Num(); ++index)
+	{
+		const FTaskHandle task = m_SortedTasks[index];
+		const FTaskNode&  node = m_Nodes[task];
+
+		FTaskHandle previous = INDEX_NONE;
+		double      longest  = 0.0;
+
+		for (int32 prerequisite = 0; prerequisite < node.Prerequisites.Num(); ++prerequisite)
+		{
+			const FTaskHandle candidate = node.Prerequisites[prerequisite];
+			if (previous == INDEX_NONE || m_PathTimes[candidate] > longest)
+			{
+				previous = candidate;
+				longest  = m_PathTimes[candidate];
+			}
+		}
+
+		m_PathTimes[task]    = longest + (node.EndTime - node.StartTime);
+		m_PathPrevious[task] = previous;
+
+		if (last == INDEX_NONE || m_PathTimes[task] > m_PathTimes[last])
+		{
+			last = task;
+		}
+
+		endTime = node.EndTime > endTime ? node.EndTime : endTime;
+	}
+
+	m_CriticalPath.Reset();
+	for (FTaskHandle task = last; task != INDEX_NONE; task = m_PathPrevious[task])
+	{
+		m_CriticalPath.Insert(task, 0);
+	}
+
+	m_CriticalPathTime = m_PathTimes[last];
+	m_ExecuteTime      = endTime - startTime;
+}
\ No newline at end of file
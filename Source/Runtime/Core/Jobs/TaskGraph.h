@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/Name.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/MpmcQueue.h"
+#include "Runtime/Template/Function.h"
+#include "Runtime/Template/Noncopyable.h"
+
+enum class ETaskThread
+{
+	/** Any job system thread. */
+	Any,
+
+	/** The thread that calls Execute, for work bound to it such as the window message pump. */
+	Main,
+};
+
+/**
+* A set of tasks with prerequisites, built once and executed as a whole every frame. A task is dispatched to
+* the job system as soon as its last prerequisite finished, so independent tasks overlap while each chain stays
+* in order. Executing allocates nothing: the per-frame state lives in the nodes and is reset at the start.
+*
+* Every task is timed, which gives the critical path of the last execution: the chain of dependent tasks whose
+* durations add up to the longest time, the part of the frame that more threads cannot shorten.
+*/
+class FTaskGraph : public Noncopyable
+{
+public:
+
+	typedef int32 FTaskHandle;
+
+public:
+
+	FTaskGraph();
+
+	~FTaskGraph();
+
+	FTaskHandle AddTask(FName name, TFunction<void()>&& task, ETaskThread thread = ETaskThread::Any);
+
+	/** task will not start before prerequisite finished. */
+	void AddPrerequisite(FTaskHandle task, FTaskHandle prerequisite);
+
+	/** Runs every task once and returns when all finished. The graph must not change meanwhile. */
+	void Execute();
+
+	FORCE_INLINE int32 NumTasks() const
+	{
+		return m_Nodes.Num();
+	}
+
+	FORCE_INLINE FName GetTaskName(FTaskHandle task) const
+	{
+		return m_Nodes[task].Name;
+	}
+
+	/** Seconds the task took in the last Execute. */
+	FORCE_INLINE double GetTaskDuration(FTaskHandle task) const
+	{
+		return m_Nodes[task].EndTime - m_Nodes[task].StartTime;
+	}
+
+	/** Seconds from the start of the last Execute to the end of its last task. */
+	FORCE_INLINE double GetExecuteTime() const
+	{
+		return m_ExecuteTime;
+	}
+
+	/** Tasks of the longest chain of the last Execute, first to last. */
+	FORCE_INLINE const TArray<FTaskHandle>& GetCriticalPath() const
+	{
+		return m_CriticalPath;
+	}
+
+	/** Sum of the task durations along the critical path. */
+	FORCE_INLINE double GetCriticalPathTime() const
+	{
+		return m_CriticalPathTime;
+	}
+
+private:
+
+	struct FTaskNode
+	{
+		FName                Name;
+		TFunction<void()>    Task;
+		ETaskThread          Thread;
+		TArray<FTaskHandle>  Prerequisites;
+		TArray<FTaskHandle>  Dependents;
+		volatile int32       NumPendingPrerequisites;
+		double               StartTime;
+		double               EndTime;
+	};
+
+	/** Sorts the tasks so that every task comes after its prerequisites, asserts that there is no cycle. */
+	void Compile();
+
+	void Dispatch(FTaskHandle task);
+
+	void RunTask(FTaskHandle task);
+
+	void UpdateCriticalPath(double startTime);
+
+private:
+
+	TArray<FTaskNode>   m_Nodes;
+	TArray<FTaskHandle> m_SortedTasks;
+	bool                m_IsCompiled;
+
+	/** Ready tasks that have to run on the thread in Execute. */
+	TMpmcQueue<FTaskHandle>* m_MainThreadTasks;
+
+	volatile int32 m_NumUnfinished;
+
+	/** Per task scratch of UpdateCriticalPath, sized at compile time. */
+	TArray<double>      m_PathTimes;
+	TArray<FTaskHandle> m_PathPrevious;
+
+	TArray<FTaskHandle> m_CriticalPath;
+	double              m_CriticalPathTime;
+	double              m_ExecuteTime;
+};
\ No newline at end of file
@@ -0,0 +1,473 @@
+﻿#include "Runtime/Core/Name.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Core/String/StringConv.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+
+#include <new>
+#include <stddef.h>
+#include <string.h>
+
+namespace Fly3DPrivateName
+{
+	enum
+	{
+		// An entry handle is a block index and an offset in units of EntryStride inside that block.
+		BlockOffsetBits = 16,
+		BlockBits       = 13,
+		MaxBlocks       = 1 << BlockBits,
+		EntryStride     = alignof(FNameEntry),
+		BlockSizeBytes  = EntryStride << BlockOffsetBits,
+
+		// A hash slot stores the entry handle with the top bits of the probe hash, so most mismatches
+		// are rejected without reading the entry.
+		SlotHandleBits  = BlockOffsetBits + BlockBits,
+		SlotHandleMask  = (1u << SlotHandleBits) - 1,
+
+		ShardBits       = 4,
+		NumShards       = 1 << ShardBits,
+		InitialSlots    = 256,
+	};
+
+	static_assert(SlotHandleBits <= 29, "Slots need spare bits for the hash tag");
+
+	FORCE_INLINE uint32 ToLowerAscii(uint32 c)
+	{
+		return (c - 'A' < 26u) ? c + ('a' - 'A') : c;
+	}
+
+	/** Narrow names reach the pool only when they are pure ASCII, see FindOrAddUTF8. */
+	FORCE_INLINE uint32 CodeUnit(ANSICHAR c)
+	{
+		return (uint8)c;
+	}
+
+	FORCE_INLINE uint32 CodeUnit(WIDECHAR c)
+	{
+		return (uint32)c;
+	}
+
+	template <typename CharType>
+	FORCE_INLINE uint64 HashName(const CharType* str, uint32 len)
+	{
+		uint64 hash = 0xcbf29ce484222325ull;
+		for (uint32 index = 0; index < len; ++index)
+		{
+			hash ^= ToLowerAscii(CodeUnit(str[index]));
+			hash *= 0x100000001b3ull;
+		}
+
+		return hash ^ (hash >> 29);
+	}
+
+	template <typename CharType>
+	FORCE_INLINE bool IsPureAnsi(const CharType* str, uint32 len)
+	{
+		for (uint32 index = 0; index < len; ++index)
+		{
+			if (CodeUnit(str[index]) > 0x7F)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename CharTypeA, typename CharTypeB>
+	FORCE_INLINE bool EqualsNoCase(const CharTypeA* a, const CharTypeB* b, uint32 len)
+	{
+		for (uint32 index = 0; index < len; ++index)
+		{
+			if (ToLowerAscii(CodeUnit(a[index])) != ToLowerAscii(CodeUnit(b[index])))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename CharType>
+	FORCE_INLINE bool EntryEquals(const FNameEntry* entry, const CharType* str, uint32 len)
+	{
+		if (entry->m_Len != len)
+		{
+			return false;
+		}
+
+		return entry->m_IsWide ? EqualsNoCase(entry->m_WideName, str, len) : EqualsNoCase(entry->m_AnsiName, str, len);
+	}
+
+	template <typename CharType>
+	FORCE_INLINE uint32 StringLength(const CharType* str)
+	{
+		uint32 len = 0;
+		while (str[len])
+		{
+			++len;
+		}
+
+		return len;
+	}
+
+	struct FSlotTable
+	{
+		uint32          Mask;
+		volatile int32  Slots[1];
+	};
+
+	struct FNameShard
+	{
+		FNameShard()
+			: NumUsed(0)
+			, Table(nullptr)
+		{
+
+		}
+
+		/** Insert-side lock, lookups probe the table without it. */
+		FMutex                Lock;
+		uint32                NumUsed;
+		FSlotTable* volatile  Table;
+
+		uint8 Pad[PLATFORM_CACHE_LINE_SIZE - sizeof(FMutex) - sizeof(uint32) - sizeof(FSlotTable*)];
+	};
+
+	class FNamePool
+	{
+	public:
+
+		FNamePool()
+			: m_NumNames(0)
+			, m_CurrentBlock(0)
+			, m_CurrentOffset(0)
+		{
+			memset(m_Blocks, 0, sizeof(m_Blocks));
+
+			for (uint32 index = 0; index < NumShards; ++index)
+			{
+				m_Shards[index].Table = AllocateTable(InitialSlots);
+			}
+
+			// NAME_None is handle 0 and never goes in the hash table, lookups of "None" are special cased.
+			const uint32 noneHandle = AllocateEntry("None", 4, 0);
+			Assert(noneHandle == NAME_None);
+		}
+
+		FORCE_INLINE const FNameEntry* Resolve(uint32 handle) const
+		{
+			return (const FNameEntry*)(m_Blocks[handle >> BlockOffsetBits] + (handle & ((1u << BlockOffsetBits) - 1)) * EntryStride);
+		}
+
+		FORCE_INLINE uint32 NumNames() const
+		{
+			return (uint32)FPlatformAtomics::AtomicRead_Relaxed(&m_NumNames);
+		}
+
+		template <typename CharType>
+		uint32 FindOrAdd(const CharType* str, uint32 len, EFindName findType)
+		{
+			AssertMsg(len < NAME_SIZE, "FName is too long: %u characters\n", len);
+
+			// Entries are sized for NAME_SIZE, keep release builds inside the entry block too.
+			if (len >= NAME_SIZE)
+			{
+				len = NAME_SIZE - 1;
+			}
+
+			if (len == 0 || (len == 4 && EqualsNoCase(str, "none", 4)))
+			{
+				return NAME_None;
+			}
+
+			const uint64 hash      = HashName(str, len);
+			const uint32 probeHash = (uint32)hash;
+			FNameShard&  shard     = m_Shards[hash >> (64 - ShardBits)];
+
+			uint32 handle = Probe(GetTable(shard), probeHash, str, len);
+			if (handle != NAME_None || findType == FNAME_Find)
+			{
+				return handle;
+			}
+
+			TScopeLock<FMutex> lock(shard.Lock);
+
+			// Another thread may have added it or grown the table since the unlocked probe.
+			handle = Probe(shard.Table, probeHash, str, len);
+			if (handle != NAME_None)
+			{
+				return handle;
+			}
+
+			handle = AllocateEntry(str, len, probeHash);
+
+			if ((shard.NumUsed + 1) * 4 > (shard.Table->Mask + 1) * 3)
+			{
+				Grow(shard);
+			}
+
+			Insert(shard.Table, probeHash, handle);
+			shard.NumUsed += 1;
+
+			return handle;
+		}
+
+	private:
+
+		/** Tables are filled before they are published, see Grow. */
+		FORCE_INLINE static const FSlotTable* GetTable(const FNameShard& shard)
+		{
+			return (const FSlotTable*)FPlatformAtomics::AtomicReadPtr((void* volatile const*)&shard.Table, EMemoryOrder::Acquire);
+		}
+
+		FORCE_INLINE static int32 MakeSlot(uint32 probeHash, uint32 handle)
+		{
+			return (int32)((probeHash & ~(uint32)SlotHandleMask) | handle);
+		}
+
+		template <typename CharType>
+		uint32 Probe(const FSlotTable* table, uint32 probeHash, const CharType* str, uint32 len) const
+		{
+			const uint32 tag = probeHash & ~(uint32)SlotHandleMask;
+
+			for (uint32 index = probeHash & table->Mask; ; index = (index + 1) & table->Mask)
+			{
+				// Acquire pairs with the release store in Insert, so the entry written before the slot was published is visible.
+				const uint32 slot = (uint32)FPlatformAtomics::AtomicRead(&table->Slots[index], EMemoryOrder::Acquire);
+				if (slot == 0)
+				{
+					return NAME_None;
+				}
+
+				if ((slot & ~(uint32)SlotHandleMask) == tag && EntryEquals(Resolve(slot & SlotHandleMask), str, len))
+				{
+					return slot & SlotHandleMask;
+				}
+			}
+		}
+
+		static void Insert(FSlotTable* table, uint32 probeHash, uint32 handle)
+		{
+			uint32 index = probeHash & table->Mask;
+			while (table->Slots[index] != 0)
+			{
+				index = (index + 1) & table->Mask;
+			}
+
+			FPlatformAtomics::AtomicStore(&table->Slots[index], MakeSlot(probeHash, handle), EMemoryOrder::Release);
+		}
+
+		static FSlotTable* AllocateTable(uint32 numSlots)
+		{
+			const size_t size  = offsetof(FSlotTable, Slots) + numSlots * sizeof(int32);
+			FSlotTable*  table = (FSlotTable*)FLY3D_MALLOC(size, kMemTypeName);
+			memset(table, 0, size);
+			table->Mask = numSlots - 1;
+
+			return table;
+		}
+
+		/**
+		* Lock-free readers may still be probing the old table, so it is never freed. It stays valid, it only
+		* misses names added after the switch, and those misses fall through to the locked path.
+		*/
+		void Grow(FNameShard& shard)
+		{
+			const FSlotTable* oldTable = shard.Table;
+			FSlotTable*       newTable = AllocateTable((oldTable->Mask + 1) * 2);
+
+			for (uint32 index = 0; index <= oldTable->Mask; ++index)
+			{
+				const uint32 slot = (uint32)oldTable->Slots[index];
+				if (slot != 0)
+				{
+					const uint32 handle = slot & SlotHandleMask;
+					Insert(newTable, Resolve(handle)->m_ProbeHash, handle);
+				}
+			}
+
+			FPlatformAtomics::AtomicStorePtr((void* volatile*)&shard.Table, newTable, EMemoryOrder::Release);
+		}
+
+		template <typename CharType>
+		uint32 AllocateEntry(const CharType* str, uint32 len, uint32 probeHash)
+		{
+			const bool   isWide = !IsPureAnsi(str, len);
+			const uint32 size   = FNameEntry::GetSize(len, isWide);
+
+			TScopeLock<FMutex> lock(m_EntryLock);
+
+			if (m_Blocks[m_CurrentBlock] == nullptr || m_CurrentOffset + size > (uint32)BlockSizeBytes)
+			{
+				if (m_Blocks[m_CurrentBlock] != nullptr)
+				{
+					m_CurrentBlock += 1;
+					m_CurrentOffset = 0;
+					AssertMsg(m_CurrentBlock < (uint32)MaxBlocks, "FName pool is full\n");
+				}
+
+				m_Blocks[m_CurrentBlock] = (uint8*)FLY3D_MALLOC_ALIGNED(BlockSizeBytes, EntryStride, kMemTypeName);
+			}
+
+			const uint32 handle = (m_CurrentBlock << BlockOffsetBits) | (m_CurrentOffset / EntryStride);
+
+			FNameEntry* entry  = (FNameEntry*)(m_Blocks[m_CurrentBlock] + m_CurrentOffset);
+			entry->m_ProbeHash = probeHash;
+			entry->m_IsWide    = isWide;
+			entry->m_Len       = len;
+
+			for (uint32 index = 0; index < len; ++index)
+			{
+				if (isWide)
+				{
+					entry->m_WideName[index] = (WIDECHAR)CodeUnit(str[index]);
+				}
+				else
+				{
+					entry->m_AnsiName[index] = (ANSICHAR)CodeUnit(str[index]);
+				}
+			}
+
+			m_CurrentOffset += size;
+			FPlatformAtomics::InterlockedIncrement(&m_NumNames, EMemoryOrder::Relaxed);
+
+			return handle;
+		}
+
+	private:
+
+		FNameShard     m_Shards[NumShards];
+
+		FMutex         m_EntryLock;
+		volatile int32 m_NumNames;
+		uint32         m_CurrentBlock;
+		uint32         m_CurrentOffset;
+		uint8*         m_Blocks[MaxBlocks];
+	};
+
+	/** Lives for the whole process, names held by static objects stay valid during shutdown. */
+	static FNamePool& GetNamePool()
+	{
+		static FNamePool* pool = new (FLY3D_MALLOC_ALIGNED(sizeof(FNamePool), alignof(FNamePool), kMemTypeName)) FNamePool();
+		return *pool;
+	}
+
+	/** Narrow names are UTF-8. Anything outside ASCII is decoded first so it matches the same name built from WIDECHAR. */
+	static uint32 FindOrAddUTF8(const ANSICHAR* str, uint32 len, EFindName findType)
+	{
+		if (IsPureAnsi(str, len))
+		{
+			return GetNamePool().FindOrAdd(str, len, findType);
+		}
+
+		FUTF8ToTCHAR wideName(str, (int32)len);
+		return GetNamePool().FindOrAdd(wideName.Get(), (uint32)wideName.Length(), findType);
+	}
+
+	template <typename CharTypeA, typename CharTypeB>
+	int32 CompareNoCase(const CharTypeA* a, uint32 lenA, const CharTypeB* b, uint32 lenB)
+	{
+		const uint32 len = lenA < lenB ? lenA : lenB;
+		for (uint32 index = 0; index < len; ++index)
+		{
+			const int32 diff = (int32)ToLowerAscii(CodeUnit(a[index])) - (int32)ToLowerAscii(CodeUnit(b[index]));
+			if (diff != 0)
+			{
+				return diff;
+			}
+		}
+
+		return (int32)lenA - (int32)lenB;
+	}
+
+	template <typename CharType>
+	int32 CompareEntry(const FNameEntry* entry, const CharType* str, uint32 len)
+	{
+		return entry->m_IsWide ? CompareNoCase(entry->m_WideName, entry->m_Len, str, len) : CompareNoCase(entry->m_AnsiName, entry->m_Len, str, len);
+	}
+
+	template <typename CharType>
+	uint32 CopyEntry(const FNameEntry* entry, CharType* out, uint32 outSize)
+	{
+		if (outSize == 0)
+		{
+			return 0;
+		}
+
+		const uint32 len = entry->m_Len < outSize - 1 ? entry->m_Len : outSize - 1;
+		for (uint32 index = 0; index < len; ++index)
+		{
+			const uint32 c = entry->m_IsWide ? CodeUnit(entry->m_WideName[index]) : CodeUnit(entry->m_AnsiName[index]);
+			out[index] = (sizeof(CharType) == 1 && c > 0x7F) ? (CharType)'?' : (CharType)c;
+		}
+
+		out[len] = 0;
+		return len;
+	}
+}
+
+uint32 FNameEntry::GetSize(uint32 len, bool isWide)
+{
+	const uint32 size = (uint32)offsetof(FNameEntry, m_AnsiName) + len * (isWide ? sizeof(WIDECHAR) : sizeof(ANSICHAR));
+	return (size + Fly3DPrivateName::EntryStride - 1) & ~(uint32)(Fly3DPrivateName::EntryStride - 1);
+}
+
+uint32 FNameEntry::GetPlainString(ANSICHAR* out, uint32 outSize) const
+{
+	return Fly3DPrivateName::CopyEntry(this, out, outSize);
+}
+
+uint32 FNameEntry::GetPlainString(WIDECHAR* out, uint32 outSize) const
+{
+	return Fly3DPrivateName::CopyEntry(this, out, outSize);
+}
+
+FName::FName(const ANSICHAR* name, EFindName findType)
+	: m_Index(name ? Fly3DPrivateName::FindOrAddUTF8(name, Fly3DPrivateName::StringLength(name), findType) : NAME_None)
+{
+
+}
+
+FName::FName(const WIDECHAR* name, EFindName findType)
+	: m_Index(name ? Fly3DPrivateName::GetNamePool().FindOrAdd(name, Fly3DPrivateName::StringLength(name), findType) : NAME_None)
+{
+
+}
+
+FName::FName(const ANSICHAR* name, uint32 len, EFindName findType)
+	: m_Index(Fly3DPrivateName::FindOrAddUTF8(name, len, findType))
+{
+
+}
+
+FName::FName(const WIDECHAR* name, uint32 len, EFindName findType)
+	: m_Index(Fly3DPrivateName::GetNamePool().FindOrAdd(name, len, findType))
+{
+
+}
+
+const FNameEntry* FName::GetEntry() const
+{
+	return Fly3DPrivateName::GetNamePool().Resolve(m_Index);
+}
+
+int32 FName::Compare(const FName& other) const
+{
+	if (m_Index == other.m_Index)
+	{
+		return 0;
+	}
+
+	const FNameEntry* entry = GetEntry();
+	const FNameEntry* otherEntry = other.GetEntry();
+
+	return otherEntry->m_IsWide
+		? Fly3DPrivateName::CompareEntry(entry, otherEntry->m_WideName, otherEntry->m_Len)
+		: Fly3DPrivateName::CompareEntry(entry, otherEntry->m_AnsiName, otherEntry->m_Len);
+}
+
+uint32 FName::GetNumNames()
+{
+	return Fly3DPrivateName::GetNamePool().NumNames();
+}
\ No newline at end of file
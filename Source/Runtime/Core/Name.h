@@ -0,0 +1,186 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/TypeTraits.h"
+
+enum
+{
+	NAME_SIZE = 1024,
+};
+
+enum EName
+{
+	NAME_None = 0,
+};
+
+enum EFindName
+{
+	/** Returns NAME_None if the string has not been interned yet. */
+	FNAME_Find,
+
+	/** Interns the string if it has not been seen before. */
+	FNAME_Add,
+};
+
+/**
+* A string stored in the name pool. Names made only of 7-bit characters are stored as ANSICHAR whatever
+* they were created from, everything else as WIDECHAR. Entries are never freed or moved.
+*/
+struct FNameEntry
+{
+	/** Case-insensitive hash, used to rehash the table without touching the characters. */
+	uint32 m_ProbeHash;
+	uint16 m_IsWide : 1;
+	uint16 m_Len    : 15;
+
+	union
+	{
+		ANSICHAR m_AnsiName[NAME_SIZE];
+		WIDECHAR m_WideName[NAME_SIZE];
+	};
+
+	FORCE_INLINE bool IsWide() const
+	{
+		return m_IsWide;
+	}
+
+	FORCE_INLINE uint32 GetNameLength() const
+	{
+		return m_Len;
+	}
+
+	FORCE_INLINE const ANSICHAR* GetAnsiName() const
+	{
+		Assert(!m_IsWide);
+		return m_AnsiName;
+	}
+
+	FORCE_INLINE const WIDECHAR* GetWideName() const
+	{
+		Assert(m_IsWide);
+		return m_WideName;
+	}
+
+	/** Copies the name into out, null terminated. Wide characters that do not fit an ANSICHAR become '?'. */
+	uint32 GetPlainString(ANSICHAR* out, uint32 outSize) const;
+
+	uint32 GetPlainString(WIDECHAR* out, uint32 outSize) const;
+
+	/** Size of an entry holding len characters, header included. */
+	static uint32 GetSize(uint32 len, bool isWide);
+};
+
+/**
+* Interned, case-insensitive string handle. The string lives once in a global pool and the handle is a 32 bit
+* index into it, so copying, hashing and comparing names are all integer operations. The first spelling
+* interned is the one kept for display.
+*
+* Lookups of existing names take no locks. Inserts lock one of the pool's shards, picked by the string's hash.
+*/
+class FName
+{
+public:
+
+	FORCE_INLINE FName()
+		: m_Index(NAME_None)
+	{
+
+	}
+
+	FORCE_INLINE FName(EName name)
+		: m_Index((uint32)name)
+	{
+
+	}
+
+	/** Narrow names are decoded as UTF-8. */
+	FName(const ANSICHAR* name, EFindName findType = FNAME_Add);
+
+	FName(const WIDECHAR* name, EFindName findType = FNAME_Add);
+
+	FName(const ANSICHAR* name, uint32 len, EFindName findType = FNAME_Add);
+
+	FName(const WIDECHAR* name, uint32 len, EFindName findType = FNAME_Add);
+
+	FORCE_INLINE uint32 GetIndex() const
+	{
+		return m_Index;
+	}
+
+	FORCE_INLINE bool IsNone() const
+	{
+		return m_Index == NAME_None;
+	}
+
+	FORCE_INLINE bool operator==(const FName& other) const
+	{
+		return m_Index == other.m_Index;
+	}
+
+	FORCE_INLINE bool operator!=(const FName& other) const
+	{
+		return m_Index != other.m_Index;
+	}
+
+	FORCE_INLINE bool operator==(EName name) const
+	{
+		return m_Index == (uint32)name;
+	}
+
+	FORCE_INLINE bool operator!=(EName name) const
+	{
+		return m_Index != (uint32)name;
+	}
+
+	/** Orders by index. Stable for the lifetime of the process but not alphabetical. */
+	FORCE_INLINE bool FastLess(const FName& other) const
+	{
+		return m_Index < other.m_Index;
+	}
+
+	/** Case-insensitive alphabetical comparison, returns <0, 0 or >0. */
+	int32 Compare(const FName& other) const;
+
+	FORCE_INLINE bool LexicalLess(const FName& other) const
+	{
+		return Compare(other) < 0;
+	}
+
+	const FNameEntry* GetEntry() const;
+
+	FORCE_INLINE uint32 GetStringLength() const
+	{
+		return GetEntry()->GetNameLength();
+	}
+
+	FORCE_INLINE uint32 ToString(ANSICHAR* out, uint32 outSize) const
+	{
+		return GetEntry()->GetPlainString(out, outSize);
+	}
+
+	FORCE_INLINE uint32 ToString(WIDECHAR* out, uint32 outSize) const
+	{
+		return GetEntry()->GetPlainString(out, outSize);
+	}
+
+	/** Number of distinct names interned so far, NAME_None included. */
+	static uint32 GetNumNames();
+
+private:
+
+	uint32 m_Index;
+};
+
+FORCE_INLINE uint32 GetTypeHash(const FName& name)
+{
+	return name.GetIndex();
+}
+
+template<>
+struct TIsZeroConstructType<FName>
+{
+	enum
+	{
+		Value = true
+	};
+};
\ No newline at end of file
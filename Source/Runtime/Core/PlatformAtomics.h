@@ -2,9 +2,48 @@
 
 #include "Runtime/Platform/Platform.h"
 
+#if defined(_MSC_VER)
 #include <Windows.h>
-#include <atomic>
+#include <intrin.h>
+#else
+#include <sched.h>
+#endif
+
+/**
+* Ordering of an atomic operation relative to the surrounding memory accesses, as in std::memory_order.
+* Relaxed only makes the operation itself atomic, Acquire keeps later accesses from moving before a load,
+* Release keeps earlier accesses from moving after a store, and SequentiallyConsistent is a full barrier.
+*/
+enum class EMemoryOrder
+{
+	Relaxed,
+	Acquire,
+	Release,
+	AcquireRelease,
+	SequentiallyConsistent,
+};
 
+/** Operand of InterlockedCompareExchange128. */
+struct alignas(16) FInt128
+{
+	int64 Low;
+	int64 High;
+};
+
+#if defined(_MSC_VER)
+
+#if PLATFORM_64BITS
+#define PLATFORM_HAS_128BIT_ATOMICS 1
+#else
+#define PLATFORM_HAS_128BIT_ATOMICS 0
+#endif
+
+/**
+* Interlocked intrinsics are full barriers on x86 and x64, so read-modify-write operations ignore the order and leave
+* the parameter unnamed.
+* Plain volatile loads and stores already have acquire and release semantics under MSVC, which is what the
+* weaker orders of AtomicRead and AtomicStore compile to.
+*/
 class FPlatformAtomics
 {
 public:
@@ -13,29 +52,29 @@ public:
 	static_assert(sizeof(int32) == sizeof(long)      && alignof(int32) == alignof(long),      "int32 must be compatible with long");
 	static_assert(sizeof(int64) == sizeof(long long) && alignof(int64) == alignof(long long), "int64 must be compatible with long long");
 
-	static FORCE_INLINE int8 InterlockedIncrement(volatile int8* value)
+	static FORCE_INLINE int8 InterlockedIncrement(volatile int8* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
-		return (int8)_InterlockedExchangeAdd8((char*)value, 1) + 1;
+		return (int8)::_InterlockedExchangeAdd8((char*)value, 1) + 1;
 	}
 
-	static FORCE_INLINE int16 InterlockedIncrement(volatile int16* value)
+	static FORCE_INLINE int16 InterlockedIncrement(volatile int16* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
-		return (int16)_InterlockedIncrement16((short*)value);
+		return (int16)::_InterlockedIncrement16((short*)value);
 	}
 
-	static FORCE_INLINE int32 InterlockedIncrement(volatile int32* value)
+	static FORCE_INLINE int32 InterlockedIncrement(volatile int32* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
-		return (int32)_InterlockedIncrement((int32*)value);
+		return (int32)::_InterlockedIncrement((long*)value);
 	}
 
-	static FORCE_INLINE int64 InterlockedIncrement(volatile int64* value)
+	static FORCE_INLINE int64 InterlockedIncrement(volatile int64* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedIncrement64((long long*)value);
 #else
 		while (true)
 		{
-			int64 oldValue = *value;
+			const int64 oldValue = *value;
 			if (_InterlockedCompareExchange64(value, oldValue + 1, oldValue) == oldValue)
 			{
 				return oldValue + 1;
@@ -44,29 +83,29 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 InterlockedDecrement(volatile int8* value)
+	static FORCE_INLINE int8 InterlockedDecrement(volatile int8* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedExchangeAdd8((char*)value, -1) - 1;
 	}
 
-	static FORCE_INLINE int16 InterlockedDecrement(volatile int16* value)
+	static FORCE_INLINE int16 InterlockedDecrement(volatile int16* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedDecrement16((short*)value);
 	}
 
-	static FORCE_INLINE int32 InterlockedDecrement(volatile int32* value)
+	static FORCE_INLINE int32 InterlockedDecrement(volatile int32* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedDecrement((long*)value);
 	}
 
-	static FORCE_INLINE int64 InterlockedDecrement(volatile int64* value)
+	static FORCE_INLINE int64 InterlockedDecrement(volatile int64* value, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedDecrement64((long long*)value);
 #else
 		while (true)
 		{
-			int64 oldValue = *value;
+			const int64 oldValue = *value;
 			if (_InterlockedCompareExchange64(value, oldValue - 1, oldValue) == oldValue)
 			{
 				return oldValue - 1;
@@ -75,29 +114,29 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 InterlockedAdd(volatile int8* value, int8 amount)
+	static FORCE_INLINE int8 InterlockedAdd(volatile int8* value, int8 amount, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedExchangeAdd8((char*)value, (char)amount);
 	}
 
-	static FORCE_INLINE int16 InterlockedAdd(volatile int16* value, int16 amount)
+	static FORCE_INLINE int16 InterlockedAdd(volatile int16* value, int16 amount, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedExchangeAdd16((short*)value, (short)amount);
 	}
 
-	static FORCE_INLINE int32 InterlockedAdd(volatile int32* value, int32 amount)
+	static FORCE_INLINE int32 InterlockedAdd(volatile int32* value, int32 amount, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedExchangeAdd((long*)value, (long)amount);
 	}
 
-	static FORCE_INLINE int64 InterlockedAdd(volatile int64* value, int64 amount)
+	static FORCE_INLINE int64 InterlockedAdd(volatile int64* value, int64 amount, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedExchangeAdd64((int64*)value, (int64)amount);
 #else
 		while (true)
 		{
-			int64 oldValue = *value;
+			const int64 oldValue = *value;
 			if (_InterlockedCompareExchange64(value, oldValue + amount, oldValue) == oldValue)
 			{
 				return oldValue;
@@ -106,29 +145,29 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 InterlockedExchange(volatile int8* value, int8 exchange)
+	static FORCE_INLINE int8 InterlockedExchange(volatile int8* value, int8 exchange, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedExchange8((char*)value, (char)exchange);
 	}
 
-	static FORCE_INLINE int16 InterlockedExchange(volatile int16* value, int16 exchange)
+	static FORCE_INLINE int16 InterlockedExchange(volatile int16* value, int16 exchange, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedExchange16((short*)value, (short)exchange);
 	}
 
-	static FORCE_INLINE int32 InterlockedExchange(volatile int32* value, int32 exchange)
+	static FORCE_INLINE int32 InterlockedExchange(volatile int32* value, int32 exchange, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedExchange((long*)value, (long)exchange);
 	}
 
-	static FORCE_INLINE int64 InterlockedExchange(volatile int64* value, int64 exchange)
+	static FORCE_INLINE int64 InterlockedExchange(volatile int64* value, int64 exchange, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedExchange64((long long*)value, (long long)exchange);
 #else
 		while (true)
 		{
-			int64 oldValue = *value;
+			const int64 oldValue = *value;
 			if (_InterlockedCompareExchange64(value, exchange, oldValue) == oldValue)
 			{
 				return oldValue;
@@ -137,47 +176,60 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE void* InterlockedExchangePtr(void* volatile* dest, void* exchange)
+	static FORCE_INLINE void* InterlockedExchangePtr(void* volatile* dest, void* exchange, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return ::_InterlockedExchangePointer(dest, exchange);
 	}
 
-	static FORCE_INLINE int8 InterlockedCompareExchange(volatile int8* dest, int8 exchange, int8 comparand)
+	static FORCE_INLINE int8 InterlockedCompareExchange(volatile int8* dest, int8 exchange, int8 comparand, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedCompareExchange8((char*)dest, (char)exchange, (char)comparand);
 	}
 
-	static FORCE_INLINE int16 InterlockedCompareExchange(volatile int16* dest, int16 exchange, int16 comparand)
+	static FORCE_INLINE int16 InterlockedCompareExchange(volatile int16* dest, int16 exchange, int16 comparand, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedCompareExchange16((short*)dest, (short)exchange, (short)comparand);
 	}
 
-	static FORCE_INLINE int32 InterlockedCompareExchange(volatile int32* dest, int32 exchange, int32 comparand)
+	static FORCE_INLINE int32 InterlockedCompareExchange(volatile int32* dest, int32 exchange, int32 comparand, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedCompareExchange((long*)dest, (long)exchange, (long)comparand);
 	}
 
-	static FORCE_INLINE int64 InterlockedCompareExchange(volatile int64* dest, int64 exchange, int64 comparand)
+	static FORCE_INLINE int64 InterlockedCompareExchange(volatile int64* dest, int64 exchange, int64 comparand, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int64)::_InterlockedCompareExchange64(dest, exchange, comparand);
 	}
 
-	static FORCE_INLINE int8 InterlockedAnd(volatile int8* value, const int8 andValue)
+	static FORCE_INLINE void* InterlockedCompareExchangePointer(void* volatile* dest, void* exchange, void* comparand, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
+	{
+		return ::_InterlockedCompareExchangePointer(dest, exchange, comparand);
+	}
+
+#if PLATFORM_HAS_128BIT_ATOMICS
+	/** Returns true if dest equalled comparand and was replaced, comparand receives the previous value of dest either way. */
+	static FORCE_INLINE bool InterlockedCompareExchange128(volatile FInt128* dest, const FInt128& exchange, FInt128* comparand)
+	{
+		return ::_InterlockedCompareExchange128((volatile long long*)dest, exchange.High, exchange.Low, (long long*)comparand) == 1;
+	}
+#endif
+
+	static FORCE_INLINE int8 InterlockedAnd(volatile int8* value, const int8 andValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedAnd8((volatile char*)value, (char)andValue);
 	}
 
-	static FORCE_INLINE int16 InterlockedAnd(volatile int16* value, const int16 andValue)
+	static FORCE_INLINE int16 InterlockedAnd(volatile int16* value, const int16 andValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedAnd16((volatile short*)value, (short)andValue);
 	}
 
-	static FORCE_INLINE int32 InterlockedAnd(volatile int32* value, const int32 andValue)
+	static FORCE_INLINE int32 InterlockedAnd(volatile int32* value, const int32 andValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedAnd((volatile long*)value, (long)andValue);
 	}
 
-	static FORCE_INLINE int64 InterlockedAnd(volatile int64* value, const int64 andValue)
+	static FORCE_INLINE int64 InterlockedAnd(volatile int64* value, const int64 andValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedAnd64((volatile long long*)value, (long long)andValue);
@@ -193,22 +245,22 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 InterlockedOr(volatile int8* value, const int8 orValue)
+	static FORCE_INLINE int8 InterlockedOr(volatile int8* value, const int8 orValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedOr8((volatile char*)value, (char)orValue);
 	}
 
-	static FORCE_INLINE int16 InterlockedOr(volatile int16* value, const int16 orValue)
+	static FORCE_INLINE int16 InterlockedOr(volatile int16* value, const int16 orValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedOr16((volatile short*)value, (short)orValue);
 	}
 
-	static FORCE_INLINE int32 InterlockedOr(volatile int32* value, const int32 orValue)
+	static FORCE_INLINE int32 InterlockedOr(volatile int32* value, const int32 orValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int32)::_InterlockedOr((volatile long*)value, (long)orValue);
 	}
 
-	static FORCE_INLINE int64 InterlockedOr(volatile int64* value, const int64 orValue)
+	static FORCE_INLINE int64 InterlockedOr(volatile int64* value, const int64 orValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedOr64((volatile long long*)value, (long long)orValue);
@@ -224,22 +276,22 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 InterlockedXor(volatile int8* value, const int8 xorValue)
+	static FORCE_INLINE int8 InterlockedXor(volatile int8* value, const int8 xorValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int8)::_InterlockedXor8((volatile char*)value, (char)xorValue);
 	}
 
-	static FORCE_INLINE int16 InterlockedXor(volatile int16* value, const int16 xorValue)
+	static FORCE_INLINE int16 InterlockedXor(volatile int16* value, const int16 xorValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 		return (int16)::_InterlockedXor16((volatile short*)value, (short)xorValue);
 	}
 
-	static FORCE_INLINE int32 InterlockedXor(volatile int32* value, const int32 xorValue)
+	static FORCE_INLINE int32 InterlockedXor(volatile int32* value, const int32 xorValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
-		return (int32)::_InterlockedXor((volatile long*)value, (int32)xorValue);
+		return (int32)::_InterlockedXor((volatile long*)value, (long)xorValue);
 	}
 
-	static FORCE_INLINE int64 InterlockedXor(volatile int64* value, const int64 xorValue)
+	static FORCE_INLINE int64 InterlockedXor(volatile int64* value, const int64 xorValue, EMemoryOrder /*order*/ = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
 		return (int64)::_InterlockedXor64((volatile long long*)value, (long long)xorValue);
@@ -255,96 +307,533 @@ public:
 #endif
 	}
 
-	static FORCE_INLINE int8 AtomicRead(volatile const int8* src)
+	static FORCE_INLINE int8 AtomicRead(volatile const int8* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		return InterlockedCompareExchange((int8*)src, 0, 0);
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			return InterlockedCompareExchange((int8*)src, 0, 0);
+		}
+
+		return *src;
 	}
 
-	static FORCE_INLINE int16 AtomicRead(volatile const int16* src)
+	static FORCE_INLINE int16 AtomicRead(volatile const int16* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		return InterlockedCompareExchange((int16*)src, 0, 0);
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			return InterlockedCompareExchange((int16*)src, 0, 0);
+		}
+
+		return *src;
 	}
 
-	static FORCE_INLINE int32 AtomicRead(volatile const int32* src)
+	static FORCE_INLINE int32 AtomicRead(volatile const int32* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		return InterlockedCompareExchange((int32*)src, 0, 0);
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			return InterlockedCompareExchange((int32*)src, 0, 0);
+		}
+
+		return *src;
 	}
 
-	static FORCE_INLINE int64 AtomicRead(volatile const int64* src)
+	static FORCE_INLINE int64 AtomicRead(volatile const int64* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
+#if PLATFORM_64BITS
+		if (order != EMemoryOrder::SequentiallyConsistent)
+		{
+			return *src;
+		}
+#endif
+
 		return InterlockedCompareExchange((int64*)src, 0, 0);
 	}
 
-	static FORCE_INLINE int8 AtomicRead_Relaxed(volatile const int8* src)
+	static FORCE_INLINE void* AtomicReadPtr(void* volatile const* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			return InterlockedCompareExchangePointer((void* volatile*)src, nullptr, nullptr);
+		}
+
 		return *src;
 	}
 
+	static FORCE_INLINE int8 AtomicRead_Relaxed(volatile const int8* src)
+	{
+		return AtomicRead(src, EMemoryOrder::Relaxed);
+	}
+
 	static FORCE_INLINE int16 AtomicRead_Relaxed(volatile const int16* src)
 	{
-		return *src;
+		return AtomicRead(src, EMemoryOrder::Relaxed);
 	}
 
 	static FORCE_INLINE int32 AtomicRead_Relaxed(volatile const int32* src)
 	{
-		return *src;
+		return AtomicRead(src, EMemoryOrder::Relaxed);
 	}
 
 	static FORCE_INLINE int64 AtomicRead_Relaxed(volatile const int64* src)
+	{
+		return AtomicRead(src, EMemoryOrder::Relaxed);
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int8* src, int8 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			InterlockedExchange(src, val);
+		}
+		else
+		{
+			*src = val;
+		}
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int16* src, int16 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			InterlockedExchange(src, val);
+		}
+		else
+		{
+			*src = val;
+		}
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int32* src, int32 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			InterlockedExchange(src, val);
+		}
+		else
+		{
+			*src = val;
+		}
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int64* src, int64 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
 #if PLATFORM_64BITS
-		return *src;
+		if (order != EMemoryOrder::SequentiallyConsistent)
+		{
+			*src = val;
+			return;
+		}
+#endif
+
+		InterlockedExchange(src, val);
+	}
+
+	static FORCE_INLINE void AtomicStorePtr(void* volatile* dest, void* val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		if (order == EMemoryOrder::SequentiallyConsistent)
+		{
+			InterlockedExchangePtr(dest, val);
+		}
+		else
+		{
+			*dest = val;
+		}
+	}
+
+	static FORCE_INLINE void AtomicStoreRelaxed(volatile int8* src, int8 val)
+	{
+		AtomicStore(src, val, EMemoryOrder::Relaxed);
+	}
+
+	static FORCE_INLINE void AtomicStoreRelaxed(volatile int16* src, int16 val)
+	{
+		AtomicStore(src, val, EMemoryOrder::Relaxed);
+	}
+
+	static FORCE_INLINE void AtomicStoreRelaxed(volatile int32* src, int32 val)
+	{
+		AtomicStore(src, val, EMemoryOrder::Relaxed);
+	}
+
+	static FORCE_INLINE void AtomicStoreRelaxed(volatile int64* src, int64 val)
+	{
+		AtomicStore(src, val, EMemoryOrder::Relaxed);
+	}
+
+	static FORCE_INLINE void Pause()
+	{
+		YieldProcessor();
+	}
+
+	/** Gives the rest of the time slice to another ready thread, for spin loops that wait longer than a few pauses. */
+	static FORCE_INLINE void YieldThread()
+	{
+		::SwitchToThread();
+	}
+};
+
+#else
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define PLATFORM_HAS_128BIT_ATOMICS 1
 #else
-		return InterlockedCompareExchange((volatile int64*)src, 0, 0);
+#define PLATFORM_HAS_128BIT_ATOMICS 0
 #endif
+
+/**
+* GCC and Clang implementation over the __atomic builtins. When a call is inlined with a constant order, the builtin
+* emits the cheapest sequence for it, e.g. a plain mov for acquire loads and release stores on x64. FORCE_INLINE is
+* only a hint here, and a call that is not inlined passes a runtime order, which the builtins treat as seq_cst.
+*/
+class FPlatformAtomics
+{
+public:
+
+	static FORCE_INLINE int8 InterlockedIncrement(volatile int8* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_add_fetch(value, (int8)1, ToBuiltinOrder(order));
 	}
 
-	static FORCE_INLINE void AtomicStore(volatile int8* src, int8 val)
+	static FORCE_INLINE int16 InterlockedIncrement(volatile int16* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		InterlockedExchange(src, val);
+		return __atomic_add_fetch(value, (int16)1, ToBuiltinOrder(order));
 	}
 
-	static FORCE_INLINE void AtomicStore(volatile int16* src, int16 val)
+	static FORCE_INLINE int32 InterlockedIncrement(volatile int32* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		InterlockedExchange(src, val);
+		return __atomic_add_fetch(value, (int32)1, ToBuiltinOrder(order));
 	}
 
-	static FORCE_INLINE void AtomicStore(volatile int32* src, int32 val)
+	static FORCE_INLINE int64 InterlockedIncrement(volatile int64* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		InterlockedExchange(src, val);
+		return __atomic_add_fetch(value, (int64)1, ToBuiltinOrder(order));
 	}
 
-	static FORCE_INLINE void AtomicStore(volatile int64* src, int64 val)
+	static FORCE_INLINE int8 InterlockedDecrement(volatile int8* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
 	{
-		InterlockedExchange(src, val);
+		return __atomic_sub_fetch(value, (int8)1, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedDecrement(volatile int16* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_sub_fetch(value, (int16)1, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedDecrement(volatile int32* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_sub_fetch(value, (int32)1, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedDecrement(volatile int64* value, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_sub_fetch(value, (int64)1, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 InterlockedAdd(volatile int8* value, int8 amount, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_add(value, amount, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedAdd(volatile int16* value, int16 amount, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_add(value, amount, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedAdd(volatile int32* value, int32 amount, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_add(value, amount, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedAdd(volatile int64* value, int64 amount, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_add(value, amount, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 InterlockedExchange(volatile int8* value, int8 exchange, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(value, exchange, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedExchange(volatile int16* value, int16 exchange, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(value, exchange, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedExchange(volatile int32* value, int32 exchange, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(value, exchange, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedExchange(volatile int64* value, int64 exchange, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(value, exchange, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void* InterlockedExchangePtr(void* volatile* dest, void* exchange, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_exchange_n(dest, exchange, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 InterlockedCompareExchange(volatile int8* dest, int8 exchange, int8 comparand, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_compare_exchange_n(dest, &comparand, exchange, false, ToBuiltinOrder(order), ToBuiltinFailureOrder(order));
+		return comparand;
+	}
+
+	static FORCE_INLINE int16 InterlockedCompareExchange(volatile int16* dest, int16 exchange, int16 comparand, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_compare_exchange_n(dest, &comparand, exchange, false, ToBuiltinOrder(order), ToBuiltinFailureOrder(order));
+		return comparand;
+	}
+
+	static FORCE_INLINE int32 InterlockedCompareExchange(volatile int32* dest, int32 exchange, int32 comparand, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_compare_exchange_n(dest, &comparand, exchange, false, ToBuiltinOrder(order), ToBuiltinFailureOrder(order));
+		return comparand;
+	}
+
+	static FORCE_INLINE int64 InterlockedCompareExchange(volatile int64* dest, int64 exchange, int64 comparand, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_compare_exchange_n(dest, &comparand, exchange, false, ToBuiltinOrder(order), ToBuiltinFailureOrder(order));
+		return comparand;
+	}
+
+	static FORCE_INLINE void* InterlockedCompareExchangePointer(void* volatile* dest, void* exchange, void* comparand, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_compare_exchange_n(dest, &comparand, exchange, false, ToBuiltinOrder(order), ToBuiltinFailureOrder(order));
+		return comparand;
+	}
+
+#if PLATFORM_HAS_128BIT_ATOMICS
+	/** Returns true if dest equalled comparand and was replaced, comparand receives the previous value of dest either way. */
+	static FORCE_INLINE bool InterlockedCompareExchange128(volatile FInt128* dest, const FInt128& exchange, FInt128* comparand)
+	{
+		// The __sync form inlines cmpxchg16b, the __atomic one goes through libatomic.
+		const __int128 expected = (__int128)(((unsigned __int128)(uint64)comparand->High << 64) | (uint64)comparand->Low);
+		const __int128 desired  = (__int128)(((unsigned __int128)(uint64)exchange.High << 64)  | (uint64)exchange.Low);
+		const __int128 previous = __sync_val_compare_and_swap((volatile __int128*)dest, expected, desired);
+
+		comparand->Low  = (int64)previous;
+		comparand->High = (int64)((unsigned __int128)previous >> 64);
+		return previous == expected;
+	}
+#endif
+
+	static FORCE_INLINE int8 InterlockedAnd(volatile int8* value, const int8 andValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_and(value, andValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedAnd(volatile int16* value, const int16 andValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_and(value, andValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedAnd(volatile int32* value, const int32 andValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_and(value, andValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedAnd(volatile int64* value, const int64 andValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_and(value, andValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 InterlockedOr(volatile int8* value, const int8 orValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_or(value, orValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedOr(volatile int16* value, const int16 orValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_or(value, orValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedOr(volatile int32* value, const int32 orValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_or(value, orValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedOr(volatile int64* value, const int64 orValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_or(value, orValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 InterlockedXor(volatile int8* value, const int8 xorValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_xor(value, xorValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 InterlockedXor(volatile int16* value, const int16 xorValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_xor(value, xorValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 InterlockedXor(volatile int32* value, const int32 xorValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_xor(value, xorValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 InterlockedXor(volatile int64* value, const int64 xorValue, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_fetch_xor(value, xorValue, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 AtomicRead(volatile const int8* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int16 AtomicRead(volatile const int16* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int32 AtomicRead(volatile const int32* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int64 AtomicRead(volatile const int64* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void* AtomicReadPtr(void* volatile const* src, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		return __atomic_load_n(src, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE int8 AtomicRead_Relaxed(volatile const int8* src)
+	{
+		return __atomic_load_n(src, __ATOMIC_RELAXED);
+	}
+
+	static FORCE_INLINE int16 AtomicRead_Relaxed(volatile const int16* src)
+	{
+		return __atomic_load_n(src, __ATOMIC_RELAXED);
+	}
+
+	static FORCE_INLINE int32 AtomicRead_Relaxed(volatile const int32* src)
+	{
+		return __atomic_load_n(src, __ATOMIC_RELAXED);
+	}
+
+	static FORCE_INLINE int64 AtomicRead_Relaxed(volatile const int64* src)
+	{
+		return __atomic_load_n(src, __ATOMIC_RELAXED);
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int8* src, int8 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(src, val, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int16* src, int16 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(src, val, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int32* src, int32 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(src, val, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void AtomicStore(volatile int64* src, int64 val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(src, val, ToBuiltinOrder(order));
+	}
+
+	static FORCE_INLINE void AtomicStorePtr(void* volatile* dest, void* val, EMemoryOrder order = EMemoryOrder::SequentiallyConsistent)
+	{
+		__atomic_store_n(dest, val, ToBuiltinOrder(order));
 	}
 
 	static FORCE_INLINE void AtomicStoreRelaxed(volatile int8* src, int8 val)
 	{
-		*src = val;
+		__atomic_store_n(src, val, __ATOMIC_RELAXED);
 	}
 
 	static FORCE_INLINE void AtomicStoreRelaxed(volatile int16* src, int16 val)
 	{
-		*src = val;
+		__atomic_store_n(src, val, __ATOMIC_RELAXED);
 	}
 
 	static FORCE_INLINE void AtomicStoreRelaxed(volatile int32* src, int32 val)
 	{
-		*src = val;
+		__atomic_store_n(src, val, __ATOMIC_RELAXED);
 	}
 
 	static FORCE_INLINE void AtomicStoreRelaxed(volatile int64* src, int64 val)
 	{
-#if PLATFORM_64BITS
-		*src = val;
-#else
-		InterlockedExchange(src, val);
+		__atomic_store_n(src, val, __ATOMIC_RELAXED);
+	}
+
+	static FORCE_INLINE void Pause()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield");
 #endif
 	}
 
-	static FORCE_INLINE void* InterlockedCompareExchangePointer(void* volatile* dest, void* exchange, void* comparand)
+	/** Gives the rest of the time slice to another ready thread, for spin loops that wait longer than a few pauses. */
+	static FORCE_INLINE void YieldThread()
 	{
-		return ::_InterlockedCompareExchangePointer(dest, exchange, comparand);
+		sched_yield();
+	}
+
+private:
+
+	static FORCE_INLINE int32 ToBuiltinOrder(EMemoryOrder order)
+	{
+		switch (order)
+		{
+			case EMemoryOrder::Relaxed:
+			{
+				return __ATOMIC_RELAXED;
+			}
+			case EMemoryOrder::Acquire:
+			{
+				return __ATOMIC_ACQUIRE;
+			}
+			case EMemoryOrder::Release:
+			{
+				return __ATOMIC_RELEASE;
+			}
+			case EMemoryOrder::AcquireRelease:
+			{
+				return __ATOMIC_ACQ_REL;
+			}
+			default:
+			{
+				return __ATOMIC_SEQ_CST;
+			}
+		}
+	}
+
+	/** The failure path of a compare exchange is only a load, so it cannot have release semantics. */
+	static FORCE_INLINE int32 ToBuiltinFailureOrder(EMemoryOrder order)
+	{
+		switch (order)
+		{
+			case EMemoryOrder::Relaxed:
+			case EMemoryOrder::Release:
+			{
+				return __ATOMIC_RELAXED;
+			}
+			case EMemoryOrder::Acquire:
+			case EMemoryOrder::AcquireRelease:
+			{
+				return __ATOMIC_ACQUIRE;
+			}
+			default:
+			{
+				return __ATOMIC_SEQ_CST;
+			}
+		}
 	}
 };
+
+#endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+﻿#include "Runtime/Core/PlatformFiber.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Utilities/Align.h"
+
+#if defined(_MSC_VER)
+#include <Windows.h>
+#elif defined(__x86_64__) && defined(__ELF__)
+#define FLY3D_FIBER_X64_SWITCH 1
+#else
+#include <ucontext.h>
+#endif
+
+struct FFiberContext
+{
+#if defined(_MSC_VER)
+	LPVOID Handle;
+#elif FLY3D_FIBER_X64_SWITCH
+	/** Stack pointer of a fiber that is not running, its registers are saved right below. */
+	void* StackPointer;
+#else
+	ucontext_t Context;
+#endif
+
+	void*                  Stack;
+	FPlatformFiber::FEntry Entry;
+	void*                  Arg;
+};
+
+#if defined(_MSC_VER)
+
+namespace Fly3DPrivateFiber
+{
+	static VOID CALLBACK FiberStart(LPVOID param)
+	{
+		FFiberContext* fiber = (FFiberContext*)param;
+		fiber->Entry(fiber->Arg);
+	}
+}
+
+FFiberContext* FPlatformFiber::ConvertThreadToFiber()
+{
+	FFiberContext* fiber = FLY3D_NEW(FFiberContext, kMemTypeFiber)();
+	fiber->Handle = ::ConvertThreadToFiber(nullptr);
+	AssertMsg(fiber->Handle != nullptr, "Thread is a fiber already\n");
+	return fiber;
+}
+
+void FPlatformFiber::ConvertFiberToThread(FFiberContext* fiber)
+{
+	::ConvertFiberToThread();
+	FLY3D_DELETE(fiber);
+}
+
+FFiberContext* FPlatformFiber::Create(uint32 stackSize, FEntry entry, void* arg)
+{
+	FFiberContext* fiber = FLY3D_NEW(FFiberContext, kMemTypeFiber)();
+	fiber->Entry  = entry;
+	fiber->Arg    = arg;
+	fiber->Handle = ::CreateFiber(stackSize, &Fly3DPrivateFiber::FiberStart, fiber);
+	AssertMsg(fiber->Handle != nullptr, "CreateFiber failed\n");
+	return fiber;
+}
+
+void FPlatformFiber::Delete(FFiberContext* fiber)
+{
+	::DeleteFiber(fiber->Handle);
+	FLY3D_DELETE(fiber);
+}
+
+void FPlatformFiber::Switch(FFiberContext* from, FFiberContext* to)
+{
+	::SwitchToFiber(to->Handle);
+}
+
+#else
+
+namespace Fly3DPrivateFiber
+{
+	enum
+	{
+		STACK_ALIGNMENT = 16,
+
+		/** Default MXCSR and x87 control word, all exceptions masked and round to nearest. */
+		DEFAULT_MXCSR   = 0x1F80,
+		DEFAULT_FPU_CW  = 0x037F,
+	};
+}
+
+#if FLY3D_FIBER_X64_SWITCH
+
+extern "C" void Fly3DSwitchFiber(void** fromStackPointer, void* toStackPointer);
+extern "C" void Fly3DFiberStart();
+
+/**
+* System V: rbx, rbp and r12 to r15 are callee saved, as are the control bits of MXCSR and the x87 control word.
+* A new fiber starts in Fly3DFiberStart with the entry point in r12 and its argument in r13.
+*/
+__asm__(
+	".text\n"
+	".globl Fly3DSwitchFiber\n"
+	".type Fly3DSwitchFiber, @function\n"
+	"Fly3DSwitchFiber:\n"
+	"	pushq %rbp\n"
+	"	pushq %rbx\n"
+	"	pushq %r12\n"
+	"	pushq %r13\n"
+	"	pushq %r14\n"
+	"	pushq %r15\n"
+	"	subq $8, %rsp\n"
+	"	stmxcsr (%rsp)\n"
+	"	fnstcw 4(%rsp)\n"
+	"	movq %rsp, (%rdi)\n"
+	"	movq %rsi, %rsp\n"
+	"	ldmxcsr (%rsp)\n"
+	"	fldcw 4(%rsp)\n"
+	"	addq $8, %rsp\n"
+	"	popq %r15\n"
+	"	popq %r14\n"
+	"	popq %r13\n"
+	"	popq %r12\n"
+	"	popq %rbx\n"
+	"	popq %rbp\n"
+	"	ret\n"
+	".size Fly3DSwitchFiber, .-Fly3DSwitchFiber\n"
+	".globl Fly3DFiberStart\n"
+	".type Fly3DFiberStart, @function\n"
+	"Fly3DFiberStart:\n"
+	"	movq %r13, %rdi\n"
+	"	callq *%r12\n"
+	"	ud2\n"
+	".size Fly3DFiberStart, .-Fly3DFiberStart\n"
+);
+
+#else
+
+namespace Fly3DPrivateFiber
+{
+	/** makecontext only passes int arguments, so the pointer comes in two halves. */
+	static void FiberStart(uint32 low, uint32 high)
+	{
+		FFiberContext* fiber = (FFiberContext*)(size_t)(((uint64)high << 32) | low);
+		fiber->Entry(fiber->Arg);
+	}
+}
+
+#endif
+
+FFiberContext* FPlatformFiber::ConvertThreadToFiber()
+{
+	// The thread's state is saved into the context by the first switch away from it.
+	FFiberContext* fiber = FLY3D_NEW(FFiberContext, kMemTypeFiber)();
+	fiber->Stack = nullptr;
+	return fiber;
+}
+
+void FPlatformFiber::ConvertFiberToThread(FFiberContext* fiber)
+{
+	FLY3D_DELETE(fiber);
+}
+
+FFiberContext* FPlatformFiber::Create(uint32 stackSize, FEntry entry, void* arg)
+{
+	// The top of the stack is aligned by hand rather than trusting the allocator with the alignment, the extra
+	// bytes keep at least stackSize usable below it.
+	const uint32 allocationSize = stackSize + Fly3DPrivateFiber::STACK_ALIGNMENT;
+
+	FFiberContext* fiber = FLY3D_NEW(FFiberContext, kMemTypeFiber)();
+	fiber->Stack = FLY3D_MALLOC_ALIGNED(allocationSize, Fly3DPrivateFiber::STACK_ALIGNMENT, kMemTypeFiber);
+	fiber->Entry = entry;
+	fiber->Arg   = arg;
+
+#if FLY3D_FIBER_X64_SWITCH
+	// The frame Fly3DSwitchFiber pops, returning into Fly3DFiberStart with a 16 byte aligned stack.
+	void** stackPointer = (void**)AlignDown((size_t)fiber->Stack + allocationSize, (size_t)Fly3DPrivateFiber::STACK_ALIGNMENT);
+	*--stackPointer = (void*)&Fly3DFiberStart;
+	*--stackPointer = nullptr;
+	*--stackPointer = nullptr;
+	*--stackPointer = (void*)entry;
+	*--stackPointer = arg;
+	*--stackPointer = nullptr;
+	*--stackPointer = nullptr;
+	*--stackPointer = (void*)(size_t)(((uint64)Fly3DPrivateFiber::DEFAULT_FPU_CW << 32) | Fly3DPrivateFiber::DEFAULT_MXCSR);
+
+	fiber->StackPointer = stackPointer;
+#else
+	getcontext(&fiber->Context);
+	fiber->Context.uc_stack.ss_sp   = fiber->Stack;
+	fiber->Context.uc_stack.ss_size = allocationSize;
+	fiber->Context.uc_link          = nullptr;
+
+	const uint64 address = (uint64)(size_t)fiber;
+	makecontext(&fiber->Context, (void (*)())&Fly3DPrivateFiber::FiberStart, 2, (uint32)address, (uint32)(address >> 32));
+#endif
+
+	return fiber;
+}
+
+void FPlatformFiber::Delete(FFiberContext* fiber)
+{
+	FLY3D_FREE(fiber->Stack);
+	FLY3D_DELETE(fiber);
+}
+
+void FPlatformFiber::Switch(FFiberContext* from, FFiberContext* to)
+{
+#if FLY3D_FIBER_X64_SWITCH
+	Fly3DSwitchFiber(&from->StackPointer, to->StackPointer);
+#else
+	swapcontext(&from->Context, &to->Context);
+#endif
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+struct FFiberContext;
+
+/**
+* Execution contexts with their own stack, switched cooperatively. Windows uses its fiber API. On x86-64 elsewhere
+* a switch saves the callee-saved registers on the stack and swaps stack pointers, which costs a few nanoseconds
+* instead of the signal mask system call of swapcontext; other targets fall back to ucontext.
+*
+* A thread has to be converted into a fiber before it may switch. A fiber that is not running can be resumed on
+* any converted thread, so code that switches must not keep thread local addresses or thread_local values across
+* the switch, see FJobSystem.
+*/
+class FPlatformFiber
+{
+public:
+
+	typedef void (*FEntry)(void* arg);
+
+public:
+
+	/** Turns the calling thread into a fiber that stands for the stack it is running on. */
+	static FFiberContext* ConvertThreadToFiber();
+
+	/** Undoes ConvertThreadToFiber, on the same thread and while that fiber is running. */
+	static void ConvertFiberToThread(FFiberContext* fiber);
+
+	/** Creates a fiber that calls entry once switched to. entry must not return, it switches away instead. */
+	static FFiberContext* Create(uint32 stackSize, FEntry entry, void* arg);
+
+	/** fiber must not be running. */
+	static void Delete(FFiberContext* fiber);
+
+	/** Saves the state of from, which must be the running fiber, and continues to. */
+	static void Switch(FFiberContext* from, FFiberContext* to);
+};
\ No newline at end of file
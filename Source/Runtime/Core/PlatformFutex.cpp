@@ -0,0 +1,82 @@
+﻿#include "Runtime/Core/PlatformFutex.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#if defined(_MSC_VER)
+#include <Windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+
+bool FPlatformFutex::Wait(volatile int32* address, int32 expected, uint32 timeoutMs)
+{
+	if (::WaitOnAddress(address, &expected, sizeof(int32), timeoutMs == WAIT_INFINITE ? INFINITE : timeoutMs))
+	{
+		return true;
+	}
+
+	return ::GetLastError() != ERROR_TIMEOUT;
+}
+
+void FPlatformFutex::WakeOne(volatile int32* address)
+{
+	::WakeByAddressSingle((PVOID)address);
+}
+
+void FPlatformFutex::WakeAll(volatile int32* address)
+{
+	::WakeByAddressAll((PVOID)address);
+}
+
+#elif defined(__linux__)
+
+bool FPlatformFutex::Wait(volatile int32* address, int32 expected, uint32 timeoutMs)
+{
+	timespec  timeout;
+	timespec* timeoutPtr = nullptr;
+
+	if (timeoutMs != WAIT_INFINITE)
+	{
+		timeout.tv_sec  = timeoutMs / 1000;
+		timeout.tv_nsec = (long)(timeoutMs % 1000) * 1000000;
+		timeoutPtr      = &timeout;
+	}
+
+	return syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, timeoutPtr, nullptr, 0) == 0 || errno != ETIMEDOUT;
+}
+
+void FPlatformFutex::WakeOne(volatile int32* address)
+{
+	syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void FPlatformFutex::WakeAll(volatile int32* address)
+{
+	syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+bool FPlatformFutex::Wait(volatile int32* address, int32 expected, uint32 timeoutMs)
+{
+	FPlatformAtomics::YieldThread();
+	return true;
+}
+
+void FPlatformFutex::WakeOne(volatile int32* address)
+{
+
+}
+
+void FPlatformFutex::WakeAll(volatile int32* address)
+{
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+/**
+* Sleeping on the address of an int32 until another thread wakes it: futex on Linux, WaitOnAddress on Windows.
+* Waits may return spuriously, callers re-check their condition in a loop. Where neither exists Wait only yields.
+*/
+class FPlatformFutex
+{
+public:
+
+	enum : uint32
+	{
+		WAIT_INFINITE = 0xFFFFFFFFu,
+	};
+
+public:
+
+	/** Sleeps if *address still equals expected, until woken or timeoutMs passed. False if the timeout passed. */
+	static bool Wait(volatile int32* address, int32 expected, uint32 timeoutMs = WAIT_INFINITE);
+
+	static void WakeOne(volatile int32* address);
+
+	static void WakeAll(volatile int32* address);
+};
\ No newline at end of file
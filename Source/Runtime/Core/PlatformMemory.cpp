@@ -0,0 +1,370 @@
+﻿#include "Runtime/Core/PlatformMemory.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FLY3D_TARGET_AVX
+#else
+#include <cpuid.h>
+#define FLY3D_TARGET_AVX __attribute__((target("avx")))
+#endif
+
+typedef void* (*FMemcpyFunction)(void* dest, const void* src, size_t count);
+
+enum
+{
+	STREAMING_PREFETCH_DISTANCE = 512,
+};
+
+static void Cpuid(uint32 leaf, uint32 subleaf, uint32 registers[4])
+{
+#if defined(_MSC_VER)
+	__cpuidex((int32*)registers, (int32)leaf, (int32)subleaf);
+#else
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+static bool IsAVXSupported()
+{
+	uint32 registers[4] = { 0, 0, 0, 0 };
+	Cpuid(1, 0, registers);
+
+	const bool hasOSXSave = (registers[2] & (1u << 27)) != 0;
+	const bool hasAVX     = (registers[2] & (1u << 28)) != 0;
+	if (!hasOSXSave || !hasAVX)
+	{
+		return false;
+	}
+
+	// The OS must save the YMM registers on context switches.
+#if defined(_MSC_VER)
+	const uint64 xcr0 = _xgetbv(0);
+#else
+	uint32 xcr0Low, xcr0High;
+	__asm__ __volatile__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+	const uint64 xcr0 = ((uint64)xcr0High << 32) | xcr0Low;
+#endif
+
+	return (xcr0 & 0x6) == 0x6;
+}
+
+/**
+* Walks the deterministic cache parameters of leaf (4 on Intel, 0x8000001D on AMD) and returns the largest data or
+* unified cache, 0 if the leaf lists none.
+*/
+static size_t FindLargestCache(uint32 leaf)
+{
+	size_t largest = 0;
+
+	for (uint32 index = 0; index < 16; ++index)
+	{
+		uint32 registers[4] = { 0, 0, 0, 0 };
+		Cpuid(leaf, index, registers);
+
+		// Type 0 ends the list, type 2 is an instruction cache.
+		const uint32 type = registers[0] & 0x1F;
+		if (type == 0)
+		{
+			break;
+		}
+
+		if (type == 2)
+		{
+			continue;
+		}
+
+		const size_t ways       = ((registers[1] >> 22) & 0x3FF) + 1;
+		const size_t partitions = ((registers[1] >> 12) & 0x3FF) + 1;
+		const size_t lineSize   = (registers[1] & 0xFFF) + 1;
+		const size_t sets       = (size_t)registers[2] + 1;
+
+		const size_t size = ways * partitions * lineSize * sets;
+		largest = size > largest ? size : largest;
+	}
+
+	return largest;
+}
+
+static size_t DetectLastLevelCacheSize()
+{
+	uint32 registers[4] = { 0, 0, 0, 0 };
+
+	Cpuid(0, 0, registers);
+	size_t size = registers[0] >= 4 ? FindLargestCache(4) : 0;
+
+	if (size == 0)
+	{
+		Cpuid(0x80000000, 0, registers);
+		size = registers[0] >= 0x8000001D ? FindLargestCache(0x8000001D) : 0;
+	}
+
+	return size > 0 ? size : (size_t)FPlatformMemory::DefaultLastLevelCacheSize;
+}
+
+/** Copies the unaligned head with memcpy and returns how many bytes were consumed to align dest. */
+static FORCE_INLINE size_t CopyHeadToAlignment(uint8*& dest, const uint8*& src, size_t count, size_t alignment)
+{
+	size_t head = (alignment - ((size_t)dest & (alignment - 1))) & (alignment - 1);
+	head = head < count ? head : count;
+
+	memcpy(dest, src, head);
+	dest += head;
+	src  += head;
+
+	return head;
+}
+
+static void* StreamingMemcpySSE2(void* dest, const void* src, size_t count)
+{
+	uint8*       dst = (uint8*)dest;
+	const uint8* s   = (const uint8*)src;
+
+	count -= CopyHeadToAlignment(dst, s, count, 16);
+
+	for (; count >= 64; count -= 64, dst += 64, s += 64)
+	{
+		_mm_prefetch((const char*)(s + STREAMING_PREFETCH_DISTANCE), _MM_HINT_NTA);
+
+		const __m128i a = _mm_loadu_si128((const __m128i*)(s +  0));
+		const __m128i b = _mm_loadu_si128((const __m128i*)(s + 16));
+		const __m128i c = _mm_loadu_si128((const __m128i*)(s + 32));
+		const __m128i d = _mm_loadu_si128((const __m128i*)(s + 48));
+
+		_mm_stream_si128((__m128i*)(dst +  0), a);
+		_mm_stream_si128((__m128i*)(dst + 16), b);
+		_mm_stream_si128((__m128i*)(dst + 32), c);
+		_mm_stream_si128((__m128i*)(dst + 48), d);
+	}
+
+	// Non-temporal stores are weakly ordered, make them visible before anything that follows.
+	_mm_sfence();
+
+	memcpy(dst, s, count);
+
+	return dest;
+}
+
+FLY3D_TARGET_AVX static void* StreamingMemcpyAVX(void* dest, const void* src, size_t count)
+{
+	uint8*       dst = (uint8*)dest;
+	const uint8* s   = (const uint8*)src;
+
+	count -= CopyHeadToAlignment(dst, s, count, 32);
+
+	for (; count >= 128; count -= 128, dst += 128, s += 128)
+	{
+		_mm_prefetch((const char*)(s + STREAMING_PREFETCH_DISTANCE), _MM_HINT_NTA);
+		_mm_prefetch((const char*)(s + STREAMING_PREFETCH_DISTANCE + 64), _MM_HINT_NTA);
+
+		const __m256i a = _mm256_loadu_si256((const __m256i*)(s +  0));
+		const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+		const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(s + 96));
+
+		_mm256_stream_si256((__m256i*)(dst +  0), a);
+		_mm256_stream_si256((__m256i*)(dst + 32), b);
+		_mm256_stream_si256((__m256i*)(dst + 64), c);
+		_mm256_stream_si256((__m256i*)(dst + 96), d);
+	}
+
+	_mm_sfence();
+	_mm256_zeroupper();
+
+	memcpy(dst, s, count);
+
+	return dest;
+}
+
+FLY3D_TARGET_AVX static void* BigBlockMemcpyAVX(void* dest, const void* src, size_t count)
+{
+	uint8*       dst = (uint8*)dest;
+	const uint8* s   = (const uint8*)src;
+
+	count -= CopyHeadToAlignment(dst, s, count, 32);
+
+	for (; count >= 128; count -= 128, dst += 128, s += 128)
+	{
+		const __m256i a = _mm256_loadu_si256((const __m256i*)(s +  0));
+		const __m256i b = _mm256_loadu_si256((const __m256i*)(s + 32));
+		const __m256i c = _mm256_loadu_si256((const __m256i*)(s + 64));
+		const __m256i d = _mm256_loadu_si256((const __m256i*)(s + 96));
+
+		_mm256_store_si256((__m256i*)(dst +  0), a);
+		_mm256_store_si256((__m256i*)(dst + 32), b);
+		_mm256_store_si256((__m256i*)(dst + 64), c);
+		_mm256_store_si256((__m256i*)(dst + 96), d);
+	}
+
+	_mm256_zeroupper();
+
+	memcpy(dst, s, count);
+
+	return dest;
+}
+
+static void* BigBlockMemcpyDefault(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+struct FMemcpyKernels
+{
+	FMemcpyFunction BigBlock;
+	FMemcpyFunction Streaming;
+
+	FMemcpyKernels()
+	{
+		const bool hasAVX = IsAVXSupported();
+
+		BigBlock  = hasAVX ? BigBlockMemcpyAVX  : BigBlockMemcpyDefault;
+		Streaming = hasAVX ? StreamingMemcpyAVX : StreamingMemcpySSE2;
+	}
+};
+
+/** Resolved once on first use, the initialization of a local static is thread safe and independent of static init order. */
+static const FMemcpyKernels& GetMemcpyKernels()
+{
+	static const FMemcpyKernels kernels;
+	return kernels;
+}
+
+void* FPlatformMemory::BigBlockMemcpy(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+void* FPlatformMemory::StreamingMemcpy(void* dest, const void* src, size_t count)
+{
+	if (count < GetStreamingMemcpyMinSize())
+	{
+		return memcpy(dest, src, count);
+	}
+
+	return StreamingMemcpyKernel(dest, src, count);
+}
+
+size_t FPlatformMemory::GetLastLevelCacheSize()
+{
+	static const size_t size = DetectLastLevelCacheSize();
+	return size;
+}
+
+void* FPlatformMemory::BigBlockMemcpyKernel(void* dest, const void* src, size_t count)
+{
+	Assert((const uint8*)dest + count <= (const uint8*)src || (const uint8*)src + count <= (const uint8*)dest);
+	return GetMemcpyKernels().BigBlock(dest, src, count);
+}
+
+void* FPlatformMemory::StreamingMemcpyKernel(void* dest, const void* src, size_t count)
+{
+	Assert((const uint8*)dest + count <= (const uint8*)src || (const uint8*)src + count <= (const uint8*)dest);
+	return GetMemcpyKernels().Streaming(dest, src, count);
+}
+
+void FPlatformMemory::MemswapGeneric(void* ptr1, void* ptr2, size_t size)
+{
+	uint8* a = (uint8*)ptr1;
+	uint8* b = (uint8*)ptr2;
+
+	for (; size >= 32; size -= 32, a += 32, b += 32)
+	{
+		const __m128i a0 = _mm_loadu_si128((const __m128i*)(a +  0));
+		const __m128i a1 = _mm_loadu_si128((const __m128i*)(a + 16));
+		const __m128i b0 = _mm_loadu_si128((const __m128i*)(b +  0));
+		const __m128i b1 = _mm_loadu_si128((const __m128i*)(b + 16));
+
+		_mm_storeu_si128((__m128i*)(a +  0), b0);
+		_mm_storeu_si128((__m128i*)(a + 16), b1);
+		_mm_storeu_si128((__m128i*)(b +  0), a0);
+		_mm_storeu_si128((__m128i*)(b + 16), a1);
+	}
+
+	if (size >= 16)
+	{
+		const __m128i a0 = _mm_loadu_si128((const __m128i*)a);
+		const __m128i b0 = _mm_loadu_si128((const __m128i*)b);
+
+		_mm_storeu_si128((__m128i*)a, b0);
+		_mm_storeu_si128((__m128i*)b, a0);
+
+		size -= 16;
+		a    += 16;
+		b    += 16;
+	}
+
+	if (size >= 8)
+	{
+		uint64 a0, b0;
+		memcpy(&a0, a, 8);
+		memcpy(&b0, b, 8);
+		memcpy(a, &b0, 8);
+		memcpy(b, &a0, 8);
+
+		size -= 8;
+		a    += 8;
+		b    += 8;
+	}
+
+	for (; size > 0; --size, ++a, ++b)
+	{
+		const uint8 temp = *a;
+		*a = *b;
+		*b = temp;
+	}
+}
+
+#else
+
+void FPlatformMemory::MemswapGeneric(void* ptr1, void* ptr2, size_t size)
+{
+	uint8* a = (uint8*)ptr1;
+	uint8* b = (uint8*)ptr2;
+
+	for (; size >= 8; size -= 8, a += 8, b += 8)
+	{
+		uint64 a0, b0;
+		memcpy(&a0, a, 8);
+		memcpy(&b0, b, 8);
+		memcpy(a, &b0, 8);
+		memcpy(b, &a0, 8);
+	}
+
+	for (; size > 0; --size, ++a, ++b)
+	{
+		const uint8 temp = *a;
+		*a = *b;
+		*b = temp;
+	}
+}
+
+void* FPlatformMemory::BigBlockMemcpy(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+void* FPlatformMemory::StreamingMemcpy(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+void* FPlatformMemory::BigBlockMemcpyKernel(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+void* FPlatformMemory::StreamingMemcpyKernel(void* dest, const void* src, size_t count)
+{
+	return memcpy(dest, src, count);
+}
+
+size_t FPlatformMemory::GetLastLevelCacheSize()
+{
+	return DefaultLastLevelCacheSize;
+}
+
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS
@@ -3,11 +3,18 @@
 #include "Runtime/Platform/Platform.h"
 
 #include <memory>
+#include <string.h>
 
 class FPlatformMemory
 {
 public:
 
+	enum
+	{
+		/** Assumed last level cache size when the CPU does not report its caches. */
+		DefaultLastLevelCacheSize = 8 * 1024 * 1024,
+	};
+
 	static FORCE_INLINE void* Memmove(void* dest, const void* src, size_t count)
 	{
 		return memmove(dest, src, count);
@@ -33,15 +40,35 @@ public:
 		return memcpy(dest, src, count);
 	}
 
-	static FORCE_INLINE void* BigBlockMemcpy(void* dest, const void* src, size_t count)
+	/**
+	* Copy for large blocks, buffers must not overlap. This is plain memcpy for now: the AVX kernel has not beaten memcpy
+	* at any size in the Memcpy benchmark, so it is only reachable through BigBlockMemcpyKernel until it does.
+	*/
+	static void* BigBlockMemcpy(void* dest, const void* src, size_t count);
+
+	/**
+	* Copies with non-temporal stores that bypass the cache. Use it for large buffers that will not be read back soon,
+	* such as uploads and staging data. Copies below GetStreamingMemcpyMinSize() use memcpy. Buffers must not overlap.
+	*/
+	static void* StreamingMemcpy(void* dest, const void* src, size_t count);
+
+	/** Size of the largest data cache the CPU reports, detected once. DefaultLastLevelCacheSize if it reports none. */
+	static size_t GetLastLevelCacheSize();
+
+	/**
+	* Half the last level cache. From this size the source and destination of a cached copy fill the whole cache and evict
+	* the data the caller works on next, which is what non-temporal stores avoid. Below it memcpy leaves the destination
+	* in cache for free. The Memcpy benchmark measures the crossover including that eviction.
+	*/
+	static FORCE_INLINE size_t GetStreamingMemcpyMinSize()
 	{
-		return memcpy(dest, src, count);
+		return GetLastLevelCacheSize() / 2;
 	}
 
-	static FORCE_INLINE void* StreamingMemcpy(void* dest, const void* src, size_t count)
-	{
-		return memcpy(dest, src, count);
-	}
+	/** The kernels behind BigBlockMemcpy and StreamingMemcpy without the size dispatch, the Memcpy benchmark measures them against memcpy. */
+	static void* BigBlockMemcpyKernel(void* dest, const void* src, size_t count);
+
+	static void* StreamingMemcpyKernel(void* dest, const void* src, size_t count);
 
 	template <typename T>
 	static FORCE_INLINE void Valswap(T& a, T& b)
@@ -101,9 +128,14 @@ public:
 				break;
 
 			default:
-				Assert(false);
+				MemswapGeneric(ptr1, ptr2, size);
 				break;
 		}
 	}
 
+private:
+
+	/** Swaps in 32, 16 and 8 byte chunks followed by a byte tail. The ranges must not overlap. */
+	static void MemswapGeneric(void* ptr1, void* ptr2, size_t size);
+
 };
\ No newline at end of file
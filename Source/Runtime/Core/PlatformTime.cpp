@@ -0,0 +1,55 @@
+﻿#include "Runtime/Core/PlatformTime.h"
+
+#if defined(_MSC_VER)
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace Fly3DPrivatePlatformTime
+{
+	/** How long the cycle counter is calibrated for. The jitter of reading both clocks is small next to it. */
+	static const double CALIBRATION_SECONDS = 0.005;
+
+#if defined(_MSC_VER)
+	static double GetSecondsPerPerformanceCount()
+	{
+		LARGE_INTEGER frequency;
+		::QueryPerformanceFrequency(&frequency);
+		return 1.0 / (double)frequency.QuadPart;
+	}
+
+	static const double s_SecondsPerPerformanceCount = GetSecondsPerPerformanceCount();
+#endif
+
+	static double CalibrateCycles64()
+	{
+		const double startSeconds = FPlatformTime::Seconds();
+		const uint64 startCycles  = FPlatformTime::Cycles64();
+
+		double seconds;
+		do
+		{
+			seconds = FPlatformTime::Seconds();
+		}
+		while (seconds - startSeconds < CALIBRATION_SECONDS);
+
+		const uint64 cycles = FPlatformTime::Cycles64();
+		return (seconds - startSeconds) / (double)(cycles - startCycles);
+	}
+}
+
+double FPlatformTime::s_SecondsPerCycle64 = Fly3DPrivatePlatformTime::CalibrateCycles64();
+
+double FPlatformTime::Seconds()
+{
+#if defined(_MSC_VER)
+	LARGE_INTEGER counter;
+	::QueryPerformanceCounter(&counter);
+	return (double)counter.QuadPart * Fly3DPrivatePlatformTime::s_SecondsPerPerformanceCount;
+#else
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
\ No newline at end of file
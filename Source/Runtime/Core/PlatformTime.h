@@ -0,0 +1,51 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+* Monotonic clocks for frame timing and profiling. Seconds() asks the OS and is the one to use for anything that
+* spans frames. Cycles64() is a single rdtsc for timing short spans, converted with ToSeconds or ToMilliseconds;
+* its rate is calibrated against Seconds() during static initialization, which assumes the invariant time stamp
+* counter of every x86-64 CPU of the last decade. Neither is ordered with the surrounding loads and stores.
+*/
+class FPlatformTime
+{
+public:
+
+	/** Seconds since an arbitrary point, from QueryPerformanceCounter or CLOCK_MONOTONIC. */
+	static double Seconds();
+
+	static FORCE_INLINE uint64 Cycles64()
+	{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return (uint64)(Seconds() * 1e9);
+#endif
+	}
+
+	static FORCE_INLINE double GetSecondsPerCycle64()
+	{
+		return s_SecondsPerCycle64;
+	}
+
+	static FORCE_INLINE double ToSeconds(uint64 cycles)
+	{
+		return (double)cycles * s_SecondsPerCycle64;
+	}
+
+	static FORCE_INLINE double ToMilliseconds(uint64 cycles)
+	{
+		return (double)cycles * s_SecondsPerCycle64 * 1000.0;
+	}
+
+private:
+
+	static double s_SecondsPerCycle64;
+};
\ No newline at end of file
@@ -0,0 +1,356 @@
+﻿#include "Runtime/Core/String/FlyString.h"
+#include "Runtime/Core/String/StringConv.h"
+#include "Runtime/Core/String/Unicode.h"
+
+#include <cstdarg>
+#include <cstring>
+#include <cwchar>
+
+namespace Fly3DPrivateString
+{
+	enum
+	{
+		MIN_FORMAT_CAPACITY = 256,
+		MAX_FORMAT_CAPACITY = 1 << 24,
+	};
+
+	static FORCE_INLINE int32 GetLength(const TCHAR* str)
+	{
+		return str ? (int32)wcslen(str) : 0;
+	}
+
+	static FORCE_INLINE int32 CompareChars(const TCHAR* a, const TCHAR* b, int32 count, ESearchCase searchCase)
+	{
+		if (searchCase == ESearchCase::IgnoreCase)
+		{
+			return FUnicode::CompareIgnoreCase(a, b, count);
+		}
+
+		for (int32 i = 0; i < count; ++i)
+		{
+			if (a[i] != b[i])
+			{
+				return a[i] < b[i] ? -1 : 1;
+			}
+		}
+
+		return 0;
+	}
+
+	/** Formats straight into the slack of data, growing it until the result fits. On failure data is left as it was. */
+	static void AppendFormatted(FString::DataType& data, const TCHAR* format, va_list args)
+	{
+		const int32 oldLen = data.Num() ? data.Num() - 1 : 0;
+
+		for (int32 capacity = MIN_FORMAT_CAPACITY; ; )
+		{
+			data.SetNumUninitialized(oldLen + capacity, false);
+
+			va_list argsCopy;
+			va_copy(argsCopy, args);
+			const int32 written = FUnicode::FormatV(data.GetData() + oldLen, capacity, format, argsCopy);
+			va_end(argsCopy);
+
+			if (written >= 0 && written < capacity)
+			{
+				if (oldLen + written == 0)
+				{
+					data.Reset();
+				}
+				else
+				{
+					data.SetNumUninitialized(oldLen + written + 1, false);
+				}
+
+				return;
+			}
+
+			const int32 needed = written > capacity ? written + 1 : capacity * 2;
+			if (written < 0 || needed > MAX_FORMAT_CAPACITY)
+			{
+				AssertMsg(written >= 0, "Format arguments cannot be encoded\n");
+				AssertMsg(written < 0, "Formatted string is too long\n");
+
+				if (oldLen == 0)
+				{
+					data.Reset();
+				}
+				else
+				{
+					data.SetNumUninitialized(oldLen + 1, false);
+					data[oldLen] = 0;
+				}
+
+				return;
+			}
+
+			capacity = needed;
+		}
+	}
+}
+
+FString::FString(const TCHAR* str)
+{
+	Append(str, Fly3DPrivateString::GetLength(str));
+}
+
+FString::FString(const TCHAR* str, int32 len)
+{
+	Append(str, len);
+}
+
+FString::FString(const ANSICHAR* str)
+{
+	if (str)
+	{
+		AppendUTF8(str, (int32)strlen(str));
+	}
+}
+
+FString& FString::operator=(const TCHAR* str)
+{
+	// str may point into this string.
+	if (str >= m_Data.GetData() && str < m_Data.GetData() + m_Data.Num())
+	{
+		*this = FString(str);
+		return *this;
+	}
+
+	m_Data.Reset();
+	return Append(str, Fly3DPrivateString::GetLength(str));
+}
+
+FString& FString::Append(const TCHAR* str, int32 count)
+{
+	Assert(count >= 0);
+
+	if (count == 0)
+	{
+		return *this;
+	}
+
+	// Appending a part of this string must survive the reallocation below.
+	if (str >= m_Data.GetData() && str < m_Data.GetData() + m_Data.Num())
+	{
+		FString copy(str, count);
+		return Append(copy);
+	}
+
+	const int32 oldLen = Len();
+	m_Data.SetNumUninitialized(oldLen + count + 1, false);
+
+	TCHAR* dest = m_Data.GetData() + oldLen;
+	FMemory::Memcpy(dest, str, count * sizeof(TCHAR));
+	dest[count] = 0;
+
+	return *this;
+}
+
+FString& FString::Append(const TCHAR* str)
+{
+	return Append(str, Fly3DPrivateString::GetLength(str));
+}
+
+FString& FString::AppendUTF8(const ANSICHAR* str, int32 count)
+{
+	const int32 numChars = FStringConv::UTF8ToTCHARLength(str, count);
+	if (numChars == 0)
+	{
+		return *this;
+	}
+
+	const int32 oldLen = Len();
+	m_Data.SetNumUninitialized(oldLen + numChars + 1, false);
+
+	TCHAR* dest = m_Data.GetData() + oldLen;
+	FStringConv::UTF8ToTCHAR(dest, numChars, str, count);
+	dest[numChars] = 0;
+
+	return *this;
+}
+
+FString& FString::Appendf(const TCHAR* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	Fly3DPrivateString::AppendFormatted(m_Data, format, args);
+	va_end(args);
+
+	return *this;
+}
+
+FString FString::Printf(const TCHAR* format, ...)
+{
+	FString result;
+
+	va_list args;
+	va_start(args, format);
+	Fly3DPrivateString::AppendFormatted(result.m_Data, format, args);
+	va_end(args);
+
+	return result;
+}
+
+FString FString::FromUTF8(const ANSICHAR* str, int32 len)
+{
+	FString result;
+	result.AppendUTF8(str, len);
+	return result;
+}
+
+FString operator+(const FString& lhs, const FString& rhs)
+{
+	FString result;
+	result.Reserve(lhs.Len() + rhs.Len());
+	result.Append(lhs);
+	result.Append(rhs);
+	return result;
+}
+
+FString operator+(FString&& lhs, const FString& rhs)
+{
+	lhs.Append(rhs);
+	return MoveTemp(lhs);
+}
+
+FString operator+(const FString& lhs, const TCHAR* rhs)
+{
+	const int32 rhsLen = Fly3DPrivateString::GetLength(rhs);
+
+	FString result;
+	result.Reserve(lhs.Len() + rhsLen);
+	result.Append(lhs);
+	result.Append(rhs, rhsLen);
+	return result;
+}
+
+FString operator+(FString&& lhs, const TCHAR* rhs)
+{
+	lhs.Append(rhs);
+	return MoveTemp(lhs);
+}
+
+FString operator+(const TCHAR* lhs, const FString& rhs)
+{
+	const int32 lhsLen = Fly3DPrivateString::GetLength(lhs);
+
+	FString result;
+	result.Reserve(lhsLen + rhs.Len());
+	result.Append(lhs, lhsLen);
+	result.Append(rhs);
+	return result;
+}
+
+bool FString::Equals(const FString& other, ESearchCase searchCase) const
+{
+	const int32 len = Len();
+	return len == other.Len() && Fly3DPrivateString::CompareChars(**this, *other, len, searchCase) == 0;
+}
+
+int32 FString::Compare(const FString& other, ESearchCase searchCase) const
+{
+	// The terminator takes part, so a prefix orders before the longer string.
+	const int32 len = Len() < other.Len() ? Len() : other.Len();
+	return Fly3DPrivateString::CompareChars(**this, *other, len + 1, searchCase);
+}
+
+int32 FString::Find(const TCHAR* subStr, ESearchCase searchCase, int32 startPosition) const
+{
+	const int32 len = Len();
+
+	startPosition = startPosition < 0 ? 0 : startPosition;
+	if (startPosition > len)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 index = FUnicode::Find(**this + startPosition, len - startPosition, subStr, Fly3DPrivateString::GetLength(subStr), searchCase == ESearchCase::IgnoreCase);
+	return index == INDEX_NONE ? INDEX_NONE : startPosition + index;
+}
+
+bool FString::StartsWith(const TCHAR* prefix, ESearchCase searchCase) const
+{
+	const int32 prefixLen = Fly3DPrivateString::GetLength(prefix);
+	return prefixLen <= Len() && Fly3DPrivateString::CompareChars(**this, prefix, prefixLen, searchCase) == 0;
+}
+
+bool FString::EndsWith(const TCHAR* suffix, ESearchCase searchCase) const
+{
+	const int32 suffixLen = Fly3DPrivateString::GetLength(suffix);
+	return suffixLen <= Len() && Fly3DPrivateString::CompareChars(**this + Len() - suffixLen, suffix, suffixLen, searchCase) == 0;
+}
+
+FString FString::Left(int32 count) const
+{
+	return Mid(0, count);
+}
+
+FString FString::Right(int32 count) const
+{
+	const int32 len = Len();
+	count = count < 0 ? 0 : count > len ? len : count;
+	return FString(**this + len - count, count);
+}
+
+FString FString::Mid(int32 start, int32 count) const
+{
+	const int32 len = Len();
+	start = start < 0 ? 0 : start > len ? len : start;
+	count = count < 0 ? 0 : count > len - start ? len - start : count;
+	return FString(**this + start, count);
+}
+
+FString FString::ToUpper() const
+{
+	FString result(*this);
+	result.ToUpperInline();
+	return result;
+}
+
+FString FString::ToLower() const
+{
+	FString result(*this);
+	result.ToLowerInline();
+	return result;
+}
+
+void FString::ToUpperInline()
+{
+	TCHAR* data = m_Data.GetData();
+	for (int32 i = 0, len = Len(); i < len; ++i)
+	{
+		data[i] = FUnicode::ToUpper(data[i]);
+	}
+}
+
+void FString::ToLowerInline()
+{
+	TCHAR* data = m_Data.GetData();
+	for (int32 i = 0, len = Len(); i < len; ++i)
+	{
+		data[i] = FUnicode::ToLower(data[i]);
+	}
+}
+
+void FString::ToUTF8(TArray<ANSICHAR>& out) const
+{
+	const int32 numBytes = FStringConv::TCHARToUTF8Length(**this, Len());
+
+	out.SetNumUninitialized(numBytes + 1, false);
+	FStringConv::TCHARToUTF8(out.GetData(), numBytes, **this, Len());
+	out[numBytes] = 0;
+}
+
+uint32 GetTypeHash(const FString& str)
+{
+	// FNV-1a over the code units.
+	uint32 hash = 2166136261u;
+
+	const TCHAR* data = *str;
+	for (int32 i = 0, len = str.Len(); i < len; ++i)
+	{
+		hash = (hash ^ (uint32)data[i]) * 16777619u;
+	}
+
+	return hash;
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Template/TypeTraits.h"
+
+enum class ESearchCase
+{
+	CaseSensitive,
+
+	/** Folds case with FUnicode::ToLower, characters outside the current locale compare as is. */
+	IgnoreCase
+};
+
+/**
+* Growable TCHAR string. The characters live in a TArray that is either empty or null terminated, and strings
+* of up to NUM_INLINE_CHARS - 1 characters are stored inside the FString itself without touching the heap.
+*
+* Formatting goes through vswprintf, so pass wide string arguments with %ls to get the same result everywhere.
+*/
+class FString
+{
+public:
+
+	enum
+	{
+		NUM_INLINE_CHARS = 16,
+	};
+
+	typedef TArray<TCHAR, TInlineAllocator<NUM_INLINE_CHARS>> DataType;
+
+public:
+
+	FString() = default;
+
+	FString(const FString&) = default;
+
+	FString(FString&&) = default;
+
+	FString& operator=(const FString&) = default;
+
+	FString& operator=(FString&&) = default;
+
+	FString(const TCHAR* str);
+
+	FString(const TCHAR* str, int32 len);
+
+	/** Decodes a UTF-8 string. */
+	explicit FString(const ANSICHAR* str);
+
+	FString& operator=(const TCHAR* str);
+
+	/** The null terminated characters, never null. */
+	FORCE_INLINE const TCHAR* operator*() const
+	{
+		return m_Data.Num() ? m_Data.GetData() : TEXT("");
+	}
+
+	FORCE_INLINE DataType& GetCharArray()
+	{
+		return m_Data;
+	}
+
+	FORCE_INLINE const DataType& GetCharArray() const
+	{
+		return m_Data;
+	}
+
+	FORCE_INLINE int32 Len() const
+	{
+		return m_Data.Num() ? m_Data.Num() - 1 : 0;
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_Data.Num() <= 1;
+	}
+
+	FORCE_INLINE bool IsValidIndex(int32 index) const
+	{
+		return index >= 0 && index < Len();
+	}
+
+	FORCE_INLINE TCHAR& operator[](int32 index)
+	{
+		Assert(IsValidIndex(index));
+		return m_Data.GetData()[index];
+	}
+
+	FORCE_INLINE const TCHAR& operator[](int32 index) const
+	{
+		Assert(IsValidIndex(index));
+		return m_Data.GetData()[index];
+	}
+
+	/** Makes room for numChars characters, terminator excluded. */
+	FORCE_INLINE void Reserve(int32 numChars)
+	{
+		m_Data.Reserve(numChars + 1);
+	}
+
+	/** Empties the string and frees its memory, keeping slack characters if asked for. */
+	FORCE_INLINE void Empty(int32 slack = 0)
+	{
+		m_Data.Empty(slack ? slack + 1 : 0);
+	}
+
+	/** Empties the string but keeps its memory. */
+	FORCE_INLINE void Reset()
+	{
+		m_Data.Reset();
+	}
+
+	FORCE_INLINE FString& AppendChar(TCHAR c)
+	{
+		if (m_Data.Num())
+		{
+			m_Data.GetData()[m_Data.Num() - 1] = c;
+			m_Data.Add((TCHAR)0);
+		}
+		else
+		{
+			m_Data.AddUninitialized(2);
+			m_Data.GetData()[0] = c;
+			m_Data.GetData()[1] = 0;
+		}
+
+		return *this;
+	}
+
+	FString& Append(const TCHAR* str, int32 count);
+
+	FString& Append(const TCHAR* str);
+
+	FORCE_INLINE FString& Append(const FString& str)
+	{
+		return Append(str.m_Data.GetData(), str.Len());
+	}
+
+	/** Appends UTF-8 text. */
+	FString& AppendUTF8(const ANSICHAR* str, int32 count);
+
+	FString& Appendf(const TCHAR* format, ...);
+
+	FORCE_INLINE FString& operator+=(TCHAR c)
+	{
+		return AppendChar(c);
+	}
+
+	FORCE_INLINE FString& operator+=(const TCHAR* str)
+	{
+		return Append(str);
+	}
+
+	FORCE_INLINE FString& operator+=(const FString& str)
+	{
+		return Append(str);
+	}
+
+	friend FString operator+(const FString& lhs, const FString& rhs);
+
+	friend FString operator+(FString&& lhs, const FString& rhs);
+
+	friend FString operator+(const FString& lhs, const TCHAR* rhs);
+
+	friend FString operator+(FString&& lhs, const TCHAR* rhs);
+
+	friend FString operator+(const TCHAR* lhs, const FString& rhs);
+
+	bool Equals(const FString& other, ESearchCase searchCase = ESearchCase::CaseSensitive) const;
+
+	/** Returns <0, 0 or >0, comparing character codes. */
+	int32 Compare(const FString& other, ESearchCase searchCase = ESearchCase::CaseSensitive) const;
+
+	FORCE_INLINE bool operator==(const FString& other) const
+	{
+		return Equals(other);
+	}
+
+	FORCE_INLINE bool operator!=(const FString& other) const
+	{
+		return !Equals(other);
+	}
+
+	FORCE_INLINE bool operator<(const FString& other) const
+	{
+		return Compare(other) < 0;
+	}
+
+	/** Index of the first occurrence of subStr at or after startPosition, INDEX_NONE if there is none. */
+	int32 Find(const TCHAR* subStr, ESearchCase searchCase = ESearchCase::CaseSensitive, int32 startPosition = 0) const;
+
+	FORCE_INLINE bool Contains(const TCHAR* subStr, ESearchCase searchCase = ESearchCase::CaseSensitive) const
+	{
+		return Find(subStr, searchCase) != INDEX_NONE;
+	}
+
+	bool StartsWith(const TCHAR* prefix, ESearchCase searchCase = ESearchCase::CaseSensitive) const;
+
+	bool EndsWith(const TCHAR* suffix, ESearchCase searchCase = ESearchCase::CaseSensitive) const;
+
+	/** The first count characters. */
+	FString Left(int32 count) const;
+
+	/** The last count characters. */
+	FString Right(int32 count) const;
+
+	/** count characters starting at start, both clamped to the string. */
+	FString Mid(int32 start, int32 count = 0x7FFFFFFF) const;
+
+	FString ToUpper() const;
+
+	FString ToLower() const;
+
+	void ToUpperInline();
+
+	void ToLowerInline();
+
+	/** Replaces out with the UTF-8 encoding of the string, null terminated. */
+	void ToUTF8(TArray<ANSICHAR>& out) const;
+
+	static FString Printf(const TCHAR* format, ...);
+
+	static FString FromUTF8(const ANSICHAR* str, int32 len);
+
+private:
+
+	DataType m_Data;
+};
+
+/** Case-sensitive, matching operator==. */
+uint32 GetTypeHash(const FString& str);
+
+template<>
+struct TIsBitwiseRelocatable<FString>
+{
+	enum
+	{
+		Value = TIsBitwiseRelocatable<FString::DataType>::Value
+	};
+};
\ No newline at end of file
@@ -0,0 +1,176 @@
+﻿#include "Runtime/Core/String/StringBuilder.h"
+#include "Runtime/Core/String/StringConv.h"
+#include "Runtime/Core/String/Unicode.h"
+#include "Runtime/Core/Name.h"
+
+#include <cstdarg>
+#include <cwchar>
+
+FStringBuilder::FStringBuilder(FMemStack& stack, int32 initialCapacity)
+	: m_Stack(stack)
+{
+	Assert(initialCapacity > 0);
+
+	m_Base = m_Stack.PushArray<TCHAR>(initialCapacity);
+	m_Cur  = m_Base;
+	m_End  = m_Base + initialCapacity;
+	*m_Cur = 0;
+}
+
+void FStringBuilder::Grow(int32 count)
+{
+	const int32 len         = Len();
+	const int32 oldCapacity = (int32)(m_End - m_Base);
+	const int32 needed      = len + count + 1;
+	const int32 newCapacity = needed > oldCapacity * 2 ? needed : oldCapacity * 2;
+
+	// Nothing else was pushed since the last grow in the common case, so the buffer just extends.
+	if (!m_Stack.TryGrowTop(m_Base, oldCapacity * sizeof(TCHAR), newCapacity * sizeof(TCHAR)))
+	{
+		TCHAR* newBase = m_Stack.PushArray<TCHAR>(newCapacity);
+		FMemory::Memcpy(newBase, m_Base, (len + 1) * sizeof(TCHAR));
+		m_Base = newBase;
+	}
+
+	m_Cur = m_Base + len;
+	m_End = m_Base + newCapacity;
+}
+
+FStringBuilder& FStringBuilder::Append(const TCHAR* str, int32 count)
+{
+	Assert(count >= 0);
+
+	// str may point into the builder itself, which Grow can move.
+	if (m_Cur + count >= m_End)
+	{
+		const int32 offset = (int32)(str - m_Base);
+		const bool  isSelf = str >= m_Base && str < m_End;
+
+		Grow(count);
+
+		if (isSelf)
+		{
+			str = m_Base + offset;
+		}
+	}
+
+	FMemory::Memcpy(m_Cur, str, count * sizeof(TCHAR));
+	m_Cur += count;
+	*m_Cur = 0;
+
+	return *this;
+}
+
+FStringBuilder& FStringBuilder::Append(const TCHAR* str)
+{
+	return Append(str, str ? (int32)wcslen(str) : 0);
+}
+
+FStringBuilder& FStringBuilder::AppendUTF8(const ANSICHAR* str, int32 count)
+{
+	const int32 numChars = FStringConv::UTF8ToTCHARLength(str, count);
+	FStringConv::UTF8ToTCHAR(AddUninitialized(numChars), numChars, str, count);
+	return *this;
+}
+
+FStringBuilder& FStringBuilder::Appendf(const TCHAR* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+
+	for (;;)
+	{
+		const int32 available = (int32)(m_End - m_Cur);
+
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+		const int32 written = FUnicode::FormatV(m_Cur, available, format, argsCopy);
+		va_end(argsCopy);
+
+		if (written >= 0 && written < available)
+		{
+			m_Cur += written;
+			break;
+		}
+
+		// Drop whatever was partially written, on failure the builder keeps its previous contents.
+		*m_Cur = 0;
+
+		// Without an exact size from the platform, double until it fits.
+		const int32 needed = written > available ? written : available * 2;
+		if (written < 0 || needed > (1 << 24))
+		{
+			AssertMsg(written >= 0, "Format arguments cannot be encoded\n");
+			AssertMsg(written < 0, "Formatted string is too long\n");
+			break;
+		}
+
+		Grow(needed);
+	}
+
+	va_end(args);
+
+	*m_Cur = 0;
+	return *this;
+}
+
+FStringBuilder& FStringBuilder::AppendUnsigned(uint64 value, bool negative)
+{
+	TCHAR  digits[24];
+	TCHAR* end = digits + 24;
+	TCHAR* it  = end;
+
+	do
+	{
+		*--it = (TCHAR)('0' + value % 10);
+		value /= 10;
+	}
+	while (value);
+
+	if (negative)
+	{
+		*--it = '-';
+	}
+
+	return Append(it, (int32)(end - it));
+}
+
+FStringBuilder& FStringBuilder::operator<<(int32 value)
+{
+	return *this << (int64)value;
+}
+
+FStringBuilder& FStringBuilder::operator<<(uint32 value)
+{
+	return AppendUnsigned(value, false);
+}
+
+FStringBuilder& FStringBuilder::operator<<(int64 value)
+{
+	// Negate in unsigned arithmetic so that the smallest int64 does not overflow.
+	return value < 0 ? AppendUnsigned(0 - (uint64)value, true) : AppendUnsigned((uint64)value, false);
+}
+
+FStringBuilder& FStringBuilder::operator<<(uint64 value)
+{
+	return AppendUnsigned(value, false);
+}
+
+FStringBuilder& FStringBuilder::operator<<(float value)
+{
+	return Appendf(TEXT("%g"), (double)value);
+}
+
+FStringBuilder& FStringBuilder::operator<<(double value)
+{
+	return Appendf(TEXT("%g"), value);
+}
+
+FStringBuilder& FStringBuilder::operator<<(const FName& name)
+{
+	const int32 len = (int32)name.GetStringLength();
+
+	// ToString writes the terminator as well, which AddUninitialized always leaves room for.
+	name.ToString(AddUninitialized(len), len + 1);
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/Noncopyable.h"
+#include "Runtime/Allocator/MemStack.h"
+#include "Runtime/Core/String/FlyString.h"
+
+class FName;
+
+/**
+* Builds a string in FMemStack memory, for text that only lives until the end of the frame such as log lines,
+* debug labels or UI text. The characters are released with the FMemMark the builder was created under, so
+* the builder must not outlive it; use ToString() to keep the result.
+*
+*	FMemMark mark(FMemStack::Get());
+*	FStringBuilder builder;
+*	builder << TEXT("Frame ") << frameIndex << TEXT(": ") << frameTimeMs;
+*/
+class FStringBuilder : public Noncopyable
+{
+public:
+
+	enum
+	{
+		DEFAULT_CAPACITY = 256,
+	};
+
+public:
+
+	explicit FStringBuilder(FMemStack& stack = FMemStack::Get(), int32 initialCapacity = DEFAULT_CAPACITY);
+
+	/** The null terminated characters. Valid until the next append. */
+	FORCE_INLINE const TCHAR* operator*() const
+	{
+		return m_Base;
+	}
+
+	FORCE_INLINE int32 Len() const
+	{
+		return (int32)(m_Cur - m_Base);
+	}
+
+	FORCE_INLINE bool IsEmpty() const
+	{
+		return m_Cur == m_Base;
+	}
+
+	/** Empties the builder, keeping its memory. */
+	FORCE_INLINE void Reset()
+	{
+		m_Cur  = m_Base;
+		*m_Cur = 0;
+	}
+
+	FORCE_INLINE FStringBuilder& AppendChar(TCHAR c)
+	{
+		if (m_Cur + 1 >= m_End)
+		{
+			Grow(1);
+		}
+
+		*m_Cur++ = c;
+		*m_Cur   = 0;
+		return *this;
+	}
+
+	FStringBuilder& Append(const TCHAR* str, int32 count);
+
+	FStringBuilder& Append(const TCHAR* str);
+
+	FORCE_INLINE FStringBuilder& Append(const FString& str)
+	{
+		return Append(*str, str.Len());
+	}
+
+	/** Appends UTF-8 text. */
+	FStringBuilder& AppendUTF8(const ANSICHAR* str, int32 count);
+
+	FStringBuilder& Appendf(const TCHAR* format, ...);
+
+	FStringBuilder& operator<<(int32 value);
+
+	FStringBuilder& operator<<(uint32 value);
+
+	FStringBuilder& operator<<(int64 value);
+
+	FStringBuilder& operator<<(uint64 value);
+
+	FStringBuilder& operator<<(float value);
+
+	FStringBuilder& operator<<(double value);
+
+	FStringBuilder& operator<<(const FName& name);
+
+	FORCE_INLINE FStringBuilder& operator<<(TCHAR c)
+	{
+		return AppendChar(c);
+	}
+
+	/** Without this a narrow character literal would be printed as its code. */
+	FORCE_INLINE FStringBuilder& operator<<(ANSICHAR c)
+	{
+		return AppendChar((TCHAR)(uint8)c);
+	}
+
+	FORCE_INLINE FStringBuilder& operator<<(const TCHAR* str)
+	{
+		return Append(str);
+	}
+
+	FORCE_INLINE FStringBuilder& operator<<(const FString& str)
+	{
+		return Append(str);
+	}
+
+	/** Copies the characters into a heap string that outlives the builder. */
+	FORCE_INLINE FString ToString() const
+	{
+		return FString(m_Base, Len());
+	}
+
+private:
+
+	/** Makes room for count more characters and the terminator. */
+	void Grow(int32 count);
+
+	FORCE_INLINE TCHAR* AddUninitialized(int32 count)
+	{
+		if (m_Cur + count >= m_End)
+		{
+			Grow(count);
+		}
+
+		TCHAR* result = m_Cur;
+		m_Cur += count;
+		*m_Cur = 0;
+		return result;
+	}
+
+	FStringBuilder& AppendUnsigned(uint64 value, bool negative);
+
+private:
+
+	FMemStack& m_Stack;
+	TCHAR*     m_Base;
+	TCHAR*     m_Cur;
+	TCHAR*     m_End;
+};
\ No newline at end of file
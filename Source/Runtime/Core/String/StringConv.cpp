@@ -0,0 +1,22 @@
+﻿#include "Runtime/Core/String/StringConv.h"
+#include "Runtime/Core/String/Unicode.h"
+
+int32 FStringConv::UTF8ToTCHAR(TCHAR* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)
+{
+	if (sizeof(TCHAR) == 2)
+	{
+		return FUnicode::UTF8ToUTF16((CHAR16*)dest, destLen, src, srcLen);
+	}
+
+	return FUnicode::UTF8ToUTF32((CHAR32*)dest, destLen, src, srcLen);
+}
+
+int32 FStringConv::TCHARToUTF8(ANSICHAR* dest, int32 destLen, const TCHAR* src, int32 srcLen)
+{
+	if (sizeof(TCHAR) == 2)
+	{
+		return FUnicode::UTF16ToUTF8(dest, destLen, (const CHAR16*)src, srcLen);
+	}
+
+	return FUnicode::UTF32ToUTF8(dest, destLen, (const CHAR32*)src, srcLen);
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/Containers/Array.h"
+
+/**
+* Conversions between UTF-8 and TCHAR, which holds UTF-16 on Windows and UTF-32 elsewhere. Malformed input
+* (truncated or overlong sequences, stray continuation bytes, unpaired surrogates) becomes U+FFFD rather than
+* failing, so the result is always well formed.
+*/
+struct FStringConv
+{
+	enum
+	{
+		REPLACEMENT_CHAR = 0xFFFD,
+	};
+
+	/**
+	* Converts srcLen bytes of UTF-8 and returns the number of TCHARs the full conversion needs. At most destLen
+	* characters are written, dest may be null to only measure. Nothing is null terminated.
+	*/
+	static int32 UTF8ToTCHAR(TCHAR* dest, int32 destLen, const ANSICHAR* src, int32 srcLen);
+
+	/** Converts srcLen TCHARs to UTF-8 and returns the number of bytes needed, see UTF8ToTCHAR. */
+	static int32 TCHARToUTF8(ANSICHAR* dest, int32 destLen, const TCHAR* src, int32 srcLen);
+
+	/** Number of TCHARs srcLen bytes of UTF-8 convert to. */
+	FORCE_INLINE static int32 UTF8ToTCHARLength(const ANSICHAR* src, int32 srcLen)
+	{
+		return UTF8ToTCHAR(nullptr, 0, src, srcLen);
+	}
+
+	/** Number of UTF-8 bytes srcLen TCHARs convert to. */
+	FORCE_INLINE static int32 TCHARToUTF8Length(const TCHAR* src, int32 srcLen)
+	{
+		return TCHARToUTF8(nullptr, 0, src, srcLen);
+	}
+};
+
+template <typename FromType, typename ToType, int32 NumInlineChars>
+class TStringConversion
+{
+public:
+
+	/** Converts a null terminated string. */
+	explicit TStringConversion(const FromType* src)
+	{
+		Convert(src, src ? GetLength(src) : 0);
+	}
+
+	TStringConversion(const FromType* src, int32 srcLen)
+	{
+		Convert(src, srcLen);
+	}
+
+	/** The converted string, null terminated. */
+	FORCE_INLINE const ToType* Get() const
+	{
+		return m_Buffer.GetData();
+	}
+
+	/** Length of the converted string, terminator excluded. */
+	FORCE_INLINE int32 Length() const
+	{
+		return m_Buffer.Num() - 1;
+	}
+
+private:
+
+	static int32 GetLength(const FromType* src)
+	{
+		const FromType* end = src;
+		while (*end)
+		{
+			++end;
+		}
+
+		return (int32)(end - src);
+	}
+
+	FORCE_INLINE static int32 ConvertChars(ANSICHAR* dest, int32 destLen, const TCHAR* src, int32 srcLen)
+	{
+		return FStringConv::TCHARToUTF8(dest, destLen, src, srcLen);
+	}
+
+	FORCE_INLINE static int32 ConvertChars(TCHAR* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)
+	{
+		return FStringConv::UTF8ToTCHAR(dest, destLen, src, srcLen);
+	}
+
+	void Convert(const FromType* src, int32 srcLen)
+	{
+		// Try the inline buffer first, most strings fit and are then converted in a single pass.
+		m_Buffer.SetNumUninitialized(NumInlineChars);
+
+		int32 length = ConvertChars(m_Buffer.GetData(), NumInlineChars - 1, src, srcLen);
+		if (length > NumInlineChars - 1)
+		{
+			m_Buffer.SetNumUninitialized(length + 1);
+			ConvertChars(m_Buffer.GetData(), length, src, srcLen);
+		}
+
+		m_Buffer[length] = 0;
+		m_Buffer.SetNumUninitialized(length + 1, false);
+	}
+
+private:
+
+	TArray<ToType, TInlineAllocator<NumInlineChars>> m_Buffer;
+};
+
+/** Temporary UTF-8 copy of a TCHAR string, e.g. TCHAR_TO_UTF8(*path) for a narrow API. */
+typedef TStringConversion<TCHAR, ANSICHAR, 128> FTCHARToUTF8;
+
+/** Temporary TCHAR copy of a UTF-8 string. */
+typedef TStringConversion<ANSICHAR, TCHAR, 128> FUTF8ToTCHAR;
+
+/** The pointer is only valid until the end of the full expression. */
+#define TCHAR_TO_UTF8(str) (FTCHARToUTF8((const TCHAR*)(str)).Get())
+#define UTF8_TO_TCHAR(str) (FUTF8ToTCHAR((const ANSICHAR*)(str)).Get())
\ No newline at end of file
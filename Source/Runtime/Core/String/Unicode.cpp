@@ -0,0 +1,777 @@
+﻿#include "Runtime/Core/String/Unicode.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Template/ChooseClass.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#endif
+
+namespace Fly3DPrivateUnicode
+{
+	enum
+	{
+		INVALID_CODE_POINT = 0xFFFFFFFF,
+	};
+
+	/** Decodes one code point and advances src. Malformed sequences consume one byte and decode to INVALID_CODE_POINT. */
+	static FORCE_INLINE uint32 Decode(const uint8*& src, const uint8* end)
+	{
+		const uint32 lead = *src++;
+		if (lead < 0x80)
+		{
+			return lead;
+		}
+
+		int32  numTrail;
+		uint32 minCodePoint;
+		uint32 codePoint;
+
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			numTrail     = 1;
+			minCodePoint = 0x80;
+			codePoint    = lead & 0x1F;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			numTrail     = 2;
+			minCodePoint = 0x800;
+			codePoint    = lead & 0x0F;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			numTrail     = 3;
+			minCodePoint = 0x10000;
+			codePoint    = lead & 0x07;
+		}
+		else
+		{
+			return INVALID_CODE_POINT;
+		}
+
+		if (end - src < numTrail)
+		{
+			return INVALID_CODE_POINT;
+		}
+
+		for (int32 i = 0; i < numTrail; ++i)
+		{
+			const uint32 trail = src[i];
+			if ((trail & 0xC0) != 0x80)
+			{
+				return INVALID_CODE_POINT;
+			}
+
+			codePoint = (codePoint << 6) | (trail & 0x3F);
+		}
+
+		if (codePoint < minCodePoint || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+		{
+			return INVALID_CODE_POINT;
+		}
+
+		src += numTrail;
+		return codePoint;
+	}
+
+	static FORCE_INLINE uint32 Decode(const CHAR16*& src, const CHAR16* end)
+	{
+		const uint32 c = *src++;
+		if (c < 0xD800 || c > 0xDFFF)
+		{
+			return c;
+		}
+
+		if (c <= 0xDBFF && src < end && *src >= 0xDC00 && *src <= 0xDFFF)
+		{
+			const uint32 low = *src++;
+			return 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+		}
+
+		return INVALID_CODE_POINT;
+	}
+
+	static FORCE_INLINE uint32 Decode(const CHAR32*& src, const CHAR32* end)
+	{
+		const uint32 c = *src++;
+		return (c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) ? (uint32)INVALID_CODE_POINT : c;
+	}
+
+	static FORCE_INLINE int32 GetEncodedLength(ANSICHAR*, uint32 codePoint)
+	{
+		return codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+	}
+
+	static FORCE_INLINE int32 GetEncodedLength(CHAR16*, uint32 codePoint)
+	{
+		return codePoint < 0x10000 ? 1 : 2;
+	}
+
+	static FORCE_INLINE int32 GetEncodedLength(CHAR32*, uint32 codePoint)
+	{
+		return 1;
+	}
+
+	static FORCE_INLINE void Encode(ANSICHAR* dest, uint32 codePoint, int32 length)
+	{
+		uint8* out = (uint8*)dest;
+		switch (length)
+		{
+		case 1:
+			out[0] = (uint8)codePoint;
+			break;
+		case 2:
+			out[0] = (uint8)(0xC0 | (codePoint >> 6));
+			out[1] = (uint8)(0x80 | (codePoint & 0x3F));
+			break;
+		case 3:
+			out[0] = (uint8)(0xE0 | (codePoint >> 12));
+			out[1] = (uint8)(0x80 | ((codePoint >> 6) & 0x3F));
+			out[2] = (uint8)(0x80 | (codePoint & 0x3F));
+			break;
+		default:
+			out[0] = (uint8)(0xF0 | (codePoint >> 18));
+			out[1] = (uint8)(0x80 | ((codePoint >> 12) & 0x3F));
+			out[2] = (uint8)(0x80 | ((codePoint >> 6) & 0x3F));
+			out[3] = (uint8)(0x80 | (codePoint & 0x3F));
+			break;
+		}
+	}
+
+	static FORCE_INLINE void Encode(CHAR16* dest, uint32 codePoint, int32 length)
+	{
+		if (length == 2)
+		{
+			dest[0] = (CHAR16)(0xD800 + ((codePoint - 0x10000) >> 10));
+			dest[1] = (CHAR16)(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+		}
+		else
+		{
+			dest[0] = (CHAR16)codePoint;
+		}
+	}
+
+	static FORCE_INLINE void Encode(CHAR32* dest, uint32 codePoint, int32 length)
+	{
+		dest[0] = codePoint;
+	}
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+
+	enum
+	{
+		BLOCK_SIZE = 16,
+	};
+
+	/** Lowest set bit of a 64 bit mask. */
+	static FORCE_INLINE uint32 CountTrailingZeros64(uint64 mask)
+	{
+		const uint32 low = (uint32)mask;
+		return low ? FMath::CountTrailingZeros(low) : 32 + FMath::CountTrailingZeros((uint32)(mask >> 32));
+	}
+
+	/**
+	* Per code unit operations on 16 code unit blocks. Masks are _mm_movemask_epi8 results concatenated over the
+	* block's vectors, so every code unit owns sizeof(CharType) bits.
+	*/
+	template <typename CharType>
+	struct TUnitBlock;
+
+	template <>
+	struct TUnitBlock<CHAR16>
+	{
+		enum
+		{
+			NumPerVector = 8,
+		};
+
+		static FORCE_INLINE __m128i Splat(uint32 c)             { return _mm_set1_epi16((short)c); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi16(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+		static FORCE_INLINE __m128i Add(__m128i a, __m128i b)     { return _mm_add_epi16(a, b); }
+
+		/** Widens 16 ASCII bytes. */
+		static FORCE_INLINE void StoreWidened(CHAR16* dest, __m128i bytes)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			_mm_storeu_si128((__m128i*)(dest + 0), _mm_unpacklo_epi8(bytes, zero));
+			_mm_storeu_si128((__m128i*)(dest + 8), _mm_unpackhi_epi8(bytes, zero));
+		}
+
+		/** Mask of the ASCII code units among the 16 at src. */
+		static FORCE_INLINE uint64 AsciiMask(const CHAR16* src, __m128i& narrowed)
+		{
+			const __m128i zero     = _mm_setzero_si128();
+			const __m128i nonAscii = Splat(0xFF80);
+			const __m128i a        = _mm_loadu_si128((const __m128i*)(src + 0));
+			const __m128i b        = _mm_loadu_si128((const __m128i*)(src + 8));
+
+			narrowed = _mm_packus_epi16(a, b);
+
+			const uint32 maskA = (uint32)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(a, nonAscii), zero));
+			const uint32 maskB = (uint32)_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(b, nonAscii), zero));
+			return maskA | ((uint64)maskB << 16);
+		}
+	};
+
+	template <>
+	struct TUnitBlock<CHAR32>
+	{
+		enum
+		{
+			NumPerVector = 4,
+		};
+
+		static FORCE_INLINE __m128i Splat(uint32 c)             { return _mm_set1_epi32((int32)c); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi32(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_cmpgt_epi32(a, b); }
+		static FORCE_INLINE __m128i Add(__m128i a, __m128i b)     { return _mm_add_epi32(a, b); }
+
+		static FORCE_INLINE void StoreWidened(CHAR32* dest, __m128i bytes)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i low  = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+			_mm_storeu_si128((__m128i*)(dest +  0), _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128((__m128i*)(dest +  4), _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128((__m128i*)(dest +  8), _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128((__m128i*)(dest + 12), _mm_unpackhi_epi16(high, zero));
+		}
+
+		static FORCE_INLINE uint64 AsciiMask(const CHAR32* src, __m128i& narrowed)
+		{
+			const __m128i zero     = _mm_setzero_si128();
+			const __m128i nonAscii = Splat(0xFFFFFF80);
+
+			uint64  mask = 0;
+			__m128i vectors[4];
+			for (int32 i = 0; i < 4; ++i)
+			{
+				vectors[i] = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				mask |= (uint64)(uint32)_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(vectors[i], nonAscii), zero)) << (i * 16);
+			}
+
+			// Only meaningful for ASCII lanes, packs saturate everything else.
+			narrowed = _mm_packus_epi16(_mm_packs_epi32(vectors[0], vectors[1]), _mm_packs_epi32(vectors[2], vectors[3]));
+			return mask;
+		}
+	};
+
+	/**
+	* Copies the ASCII prefix of the UTF-8 at src, 16 bytes at a time, and returns its length. Stops early when
+	* dest has no room for a whole block and leaves the rest to the scalar loop.
+	*/
+	template <typename CharType>
+	static FORCE_INLINE int32 ConvertAsciiPrefix(CharType* dest, int32 destLen, const uint8* src, const uint8* end)
+	{
+		int32 count = 0;
+		for (; end - (src + count) >= BLOCK_SIZE; count += BLOCK_SIZE)
+		{
+			if (dest && count + BLOCK_SIZE > destLen)
+			{
+				return count;
+			}
+
+			const __m128i bytes = _mm_loadu_si128((const __m128i*)(src + count));
+			const uint32  mask  = (uint32)_mm_movemask_epi8(bytes);
+
+			// Non-ASCII lanes are stored too, the scalar loop overwrites them.
+			if (dest)
+			{
+				TUnitBlock<CharType>::StoreWidened(dest + count, bytes);
+			}
+
+			if (mask)
+			{
+				return count + (int32)FMath::CountTrailingZeros(mask);
+			}
+		}
+
+		return count;
+	}
+
+	/** Narrowing counterpart of ConvertAsciiPrefix. */
+	template <typename CharType>
+	static FORCE_INLINE int32 ConvertAsciiPrefix(ANSICHAR* dest, int32 destLen, const CharType* src, const CharType* end)
+	{
+		const uint64 allAscii = sizeof(CharType) == 2 ? 0xFFFFFFFFull : ~0ull;
+
+		int32 count = 0;
+		for (; end - (src + count) >= BLOCK_SIZE; count += BLOCK_SIZE)
+		{
+			if (dest && count + BLOCK_SIZE > destLen)
+			{
+				return count;
+			}
+
+			__m128i narrowed;
+			const uint64 mask = TUnitBlock<CharType>::AsciiMask(src + count, narrowed);
+
+			if (dest)
+			{
+				_mm_storeu_si128((__m128i*)(dest + count), narrowed);
+			}
+
+			if (mask != allAscii)
+			{
+				return count + (int32)(CountTrailingZeros64(~mask) / sizeof(CharType));
+			}
+		}
+
+		return count;
+	}
+
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS
+
+	template <typename DestType, typename SrcType>
+	static int32 Convert(DestType* dest, int32 destLen, const SrcType* src, int32 srcLen)
+	{
+		const SrcType* it  = src;
+		const SrcType* end = src + srcLen;
+
+		int32 length = 0;
+		while (it < end)
+		{
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+			const int32 asciiCount = ConvertAsciiPrefix(dest ? dest + length : nullptr, destLen - length, it, end);
+
+			it     += asciiCount;
+			length += asciiCount;
+
+			if (it >= end)
+			{
+				break;
+			}
+#endif
+
+			uint32 codePoint = Decode(it, end);
+			if (codePoint == INVALID_CODE_POINT)
+			{
+				codePoint = FUnicode::REPLACEMENT_CHAR;
+			}
+
+			const int32 count = GetEncodedLength(dest, codePoint);
+
+			// Stop writing at the first code point that does not fit, keep counting.
+			if (dest && length + count > destLen)
+			{
+				dest = nullptr;
+			}
+
+			if (dest)
+			{
+				Encode(dest + length, codePoint, count);
+			}
+
+			length += count;
+		}
+
+		return length;
+	}
+
+	/** A run of characters mapping to c + Delta. Stride 2 covers the alternating upper and lower case pairs of the Latin, Greek and Cyrillic blocks. */
+	struct FCaseRange
+	{
+		uint16 First;
+		uint16 Last;
+		uint16 Stride;
+		int16  Delta;
+	};
+
+	/**
+	* Simple one to one case mappings of UnicodeData.txt (Unicode 14) for Latin-1, Latin Extended-A, Greek, Cyrillic,
+	* Armenian, Latin Extended Additional and the fullwidth forms, sorted by First. Mappings that expand to several
+	* characters (U+00DF to "SS") are left out, as towupper does. Characters of other blocks keep their case.
+	*/
+	static const FCaseRange LowerCaseRanges[] =
+	{
+		{ 0x00C0, 0x00D6, 1,     32 },
+		{ 0x00D8, 0x00DE, 1,     32 },
+		{ 0x0100, 0x012E, 2,      1 },
+		{ 0x0130, 0x0130, 1,   -199 },
+		{ 0x0132, 0x0136, 2,      1 },
+		{ 0x0139, 0x0147, 2,      1 },
+		{ 0x014A, 0x0176, 2,      1 },
+		{ 0x0178, 0x0178, 1,   -121 },
+		{ 0x0179, 0x017D, 2,      1 },
+		{ 0x0370, 0x0372, 2,      1 },
+		{ 0x0376, 0x0376, 1,      1 },
+		{ 0x037F, 0x037F, 1,    116 },
+		{ 0x0386, 0x0386, 1,     38 },
+		{ 0x0388, 0x038A, 1,     37 },
+		{ 0x038C, 0x038C, 1,     64 },
+		{ 0x038E, 0x038F, 1,     63 },
+		{ 0x0391, 0x03A1, 1,     32 },
+		{ 0x03A3, 0x03AB, 1,     32 },
+		{ 0x03CF, 0x03CF, 1,      8 },
+		{ 0x03D8, 0x03EE, 2,      1 },
+		{ 0x03F4, 0x03F4, 1,    -60 },
+		{ 0x03F7, 0x03F7, 1,      1 },
+		{ 0x03F9, 0x03F9, 1,     -7 },
+		{ 0x03FA, 0x03FA, 1,      1 },
+		{ 0x03FD, 0x03FF, 1,   -130 },
+		{ 0x0400, 0x040F, 1,     80 },
+		{ 0x0410, 0x042F, 1,     32 },
+		{ 0x0460, 0x0480, 2,      1 },
+		{ 0x048A, 0x04BE, 2,      1 },
+		{ 0x04C0, 0x04C0, 1,     15 },
+		{ 0x04C1, 0x04CD, 2,      1 },
+		{ 0x04D0, 0x052E, 2,      1 },
+		{ 0x0531, 0x0556, 1,     48 },
+		{ 0x1E00, 0x1E94, 2,      1 },
+		{ 0x1E9E, 0x1E9E, 1,  -7615 },
+		{ 0x1EA0, 0x1EFE, 2,      1 },
+		{ 0xFF21, 0xFF3A, 1,     32 },
+	};
+
+	static const FCaseRange UpperCaseRanges[] =
+	{
+		{ 0x00B5, 0x00B5, 1,    743 },
+		{ 0x00E0, 0x00F6, 1,    -32 },
+		{ 0x00F8, 0x00FE, 1,    -32 },
+		{ 0x00FF, 0x00FF, 1,    121 },
+		{ 0x0101, 0x012F, 2,     -1 },
+		{ 0x0131, 0x0131, 1,   -232 },
+		{ 0x0133, 0x0137, 2,     -1 },
+		{ 0x013A, 0x0148, 2,     -1 },
+		{ 0x014B, 0x0177, 2,     -1 },
+		{ 0x017A, 0x017E, 2,     -1 },
+		{ 0x017F, 0x017F, 1,   -300 },
+		{ 0x0371, 0x0373, 2,     -1 },
+		{ 0x0377, 0x0377, 1,     -1 },
+		{ 0x037B, 0x037D, 1,    130 },
+		{ 0x03AC, 0x03AC, 1,    -38 },
+		{ 0x03AD, 0x03AF, 1,    -37 },
+		{ 0x03B1, 0x03C1, 1,    -32 },
+		{ 0x03C2, 0x03C2, 1,    -31 },
+		{ 0x03C3, 0x03CB, 1,    -32 },
+		{ 0x03CC, 0x03CC, 1,    -64 },
+		{ 0x03CD, 0x03CE, 1,    -63 },
+		{ 0x03D0, 0x03D0, 1,    -62 },
+		{ 0x03D1, 0x03D1, 1,    -57 },
+		{ 0x03D5, 0x03D5, 1,    -47 },
+		{ 0x03D6, 0x03D6, 1,    -54 },
+		{ 0x03D7, 0x03D7, 1,     -8 },
+		{ 0x03D9, 0x03EF, 2,     -1 },
+		{ 0x03F0, 0x03F0, 1,    -86 },
+		{ 0x03F1, 0x03F1, 1,    -80 },
+		{ 0x03F2, 0x03F2, 1,      7 },
+		{ 0x03F3, 0x03F3, 1,   -116 },
+		{ 0x03F5, 0x03F5, 1,    -96 },
+		{ 0x03F8, 0x03F8, 1,     -1 },
+		{ 0x03FB, 0x03FB, 1,     -1 },
+		{ 0x0430, 0x044F, 1,    -32 },
+		{ 0x0450, 0x045F, 1,    -80 },
+		{ 0x0461, 0x0481, 2,     -1 },
+		{ 0x048B, 0x04BF, 2,     -1 },
+		{ 0x04C2, 0x04CE, 2,     -1 },
+		{ 0x04CF, 0x04CF, 1,    -15 },
+		{ 0x04D1, 0x052F, 2,     -1 },
+		{ 0x0561, 0x0586, 1,    -48 },
+		{ 0x1E01, 0x1E95, 2,     -1 },
+		{ 0x1E9B, 0x1E9B, 1,    -59 },
+		{ 0x1EA1, 0x1EFF, 2,     -1 },
+		{ 0xFF41, 0xFF5A, 1,    -32 },
+	};
+	static TCHAR MapCase(const FCaseRange* ranges, int32 numRanges, TCHAR c)
+	{
+		int32 low  = 0;
+		int32 high = numRanges;
+		while (low < high)
+		{
+			const int32 mid = (low + high) / 2;
+			if ((uint32)ranges[mid].Last < (uint32)c)
+			{
+				low = mid + 1;
+			}
+			else
+			{
+				high = mid;
+			}
+		}
+
+		if (low == numRanges || (uint32)c < ranges[low].First || (((uint32)c - ranges[low].First) & (ranges[low].Stride - 1)) != 0)
+		{
+			return c;
+		}
+
+		return (TCHAR)((int32)c + ranges[low].Delta);
+	}
+
+	static FORCE_INLINE bool MatchesAt(const TCHAR* str, const TCHAR* subStr, int32 subLen, bool ignoreCase)
+	{
+		return ignoreCase ? FUnicode::CompareIgnoreCase(str, subStr, subLen) == 0 : memcmp(str, subStr, subLen * sizeof(TCHAR)) == 0;
+	}
+
+	static FORCE_INLINE int32 CompareIgnoreCaseScalar(const TCHAR* a, const TCHAR* b, int32 count)
+	{
+		for (int32 i = 0; i < count; ++i)
+		{
+			const TCHAR lowerA = FUnicode::ToLower(a[i]);
+			const TCHAR lowerB = FUnicode::ToLower(b[i]);
+			if (lowerA != lowerB)
+			{
+				return lowerA < lowerB ? -1 : 1;
+			}
+		}
+
+		return 0;
+	}
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+
+	typedef TChooseClass<sizeof(TCHAR) == 2, CHAR16, CHAR32>::Result FTCHARUnit;
+	typedef TUnitBlock<FTCHARUnit> FTCHARBlock;
+
+	enum
+	{
+		TCHARS_PER_VECTOR = FTCHARBlock::NumPerVector,
+		TCHAR_VECTOR_MASK = 0xFFFF,
+	};
+
+	static FORCE_INLINE bool IsAsciiVector(__m128i v)
+	{
+		const __m128i nonAscii = FTCHARBlock::Splat(sizeof(TCHAR) == 2 ? 0xFF80 : 0xFFFFFF80);
+		return _mm_movemask_epi8(FTCHARBlock::Equal(_mm_and_si128(v, nonAscii), _mm_setzero_si128())) == TCHAR_VECTOR_MASK;
+	}
+
+	/** ToLower for vectors of ASCII characters. */
+	static FORCE_INLINE __m128i ToLowerAsciiVector(__m128i v)
+	{
+		const __m128i isUpper = _mm_and_si128(FTCHARBlock::Greater(v, FTCHARBlock::Splat('A' - 1)), FTCHARBlock::Greater(FTCHARBlock::Splat('Z' + 1), v));
+		return FTCHARBlock::Add(v, _mm_and_si128(isUpper, FTCHARBlock::Splat('a' - 'A')));
+	}
+
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS
+}
+
+bool FUnicode::ValidateUTF8(const ANSICHAR* src, int32 srcLen)
+{
+	using namespace Fly3DPrivateUnicode;
+
+	const uint8* it  = (const uint8*)src;
+	const uint8* end = it + srcLen;
+
+	while (it < end)
+	{
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+		it += ConvertAsciiPrefix((CHAR16*)nullptr, 0, it, end);
+		if (it >= end)
+		{
+			break;
+		}
+#endif
+
+		if (Decode(it, end) == INVALID_CODE_POINT)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FUnicode::CountCodePoints(const ANSICHAR* src, int32 srcLen)
+{
+	const uint8* it  = (const uint8*)src;
+	const uint8* end = it + srcLen;
+
+	int32 count = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	// Continuation bytes are 0x80-0xBF, which are the signed bytes -128 to -65.
+	const __m128i lastContinuation = _mm_set1_epi8((char)0xBF);
+	for (; end - it >= Fly3DPrivateUnicode::BLOCK_SIZE; it += Fly3DPrivateUnicode::BLOCK_SIZE)
+	{
+		const __m128i bytes = _mm_loadu_si128((const __m128i*)it);
+		count += (int32)FMath::CountBits((uint32)_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, lastContinuation)));
+	}
+#endif
+
+	for (; it < end; ++it)
+	{
+		count += (*it & 0xC0) != 0x80;
+	}
+
+	return count;
+}
+
+int32 FUnicode::UTF8ToUTF16(CHAR16* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)
+{
+	return Fly3DPrivateUnicode::Convert(dest, destLen, (const uint8*)src, srcLen);
+}
+
+int32 FUnicode::UTF8ToUTF32(CHAR32* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)
+{
+	return Fly3DPrivateUnicode::Convert(dest, destLen, (const uint8*)src, srcLen);
+}
+
+int32 FUnicode::UTF16ToUTF8(ANSICHAR* dest, int32 destLen, const CHAR16* src, int32 srcLen)
+{
+	return Fly3DPrivateUnicode::Convert(dest, destLen, src, srcLen);
+}
+
+int32 FUnicode::UTF32ToUTF8(ANSICHAR* dest, int32 destLen, const CHAR32* src, int32 srcLen)
+{
+	return Fly3DPrivateUnicode::Convert(dest, destLen, src, srcLen);
+}
+
+TCHAR FUnicode::ToLowerNonAscii(TCHAR c)
+{
+	using namespace Fly3DPrivateUnicode;
+	return MapCase(LowerCaseRanges, (int32)(sizeof(LowerCaseRanges) / sizeof(LowerCaseRanges[0])), c);
+}
+
+TCHAR FUnicode::ToUpperNonAscii(TCHAR c)
+{
+	using namespace Fly3DPrivateUnicode;
+	return MapCase(UpperCaseRanges, (int32)(sizeof(UpperCaseRanges) / sizeof(UpperCaseRanges[0])), c);
+}
+
+int32 FUnicode::CompareIgnoreCase(const TCHAR* a, const TCHAR* b, int32 count)
+{
+	using namespace Fly3DPrivateUnicode;
+
+	int32 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	for (; i + TCHARS_PER_VECTOR <= count; i += TCHARS_PER_VECTOR)
+	{
+		const __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		const __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+
+		// Equal vectors need no folding at all, which is the common case when comparing names and paths.
+		uint32 equal = (uint32)_mm_movemask_epi8(FTCHARBlock::Equal(va, vb));
+		if (equal == TCHAR_VECTOR_MASK)
+		{
+			continue;
+		}
+
+		if (!IsAsciiVector(_mm_or_si128(va, vb)))
+		{
+			const int32 result = CompareIgnoreCaseScalar(a + i, b + i, TCHARS_PER_VECTOR);
+			if (result != 0)
+			{
+				return result;
+			}
+
+			continue;
+		}
+
+		equal = (uint32)_mm_movemask_epi8(FTCHARBlock::Equal(ToLowerAsciiVector(va), ToLowerAsciiVector(vb)));
+		if (equal != TCHAR_VECTOR_MASK)
+		{
+			const int32 index = i + (int32)(FMath::CountTrailingZeros(~equal) / sizeof(TCHAR));
+			return ToLower(a[index]) < ToLower(b[index]) ? -1 : 1;
+		}
+	}
+#endif
+
+	return CompareIgnoreCaseScalar(a + i, b + i, count - i);
+}
+
+int32 FUnicode::Find(const TCHAR* str, int32 len, const TCHAR* subStr, int32 subLen, bool ignoreCase)
+{
+	using namespace Fly3DPrivateUnicode;
+
+	if (subLen == 0)
+	{
+		return 0;
+	}
+
+	const int32 lastStart = len - subLen;
+	int32 i = 0;
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+	// Candidates must match both the first and the last character of subStr, which rules out most positions
+	// a vector at a time. Folding case in vectors only works for ASCII, other blocks are scanned one by one.
+	const TCHAR first = ignoreCase ? ToLower(subStr[0]) : subStr[0];
+	const TCHAR last  = ignoreCase ? ToLower(subStr[subLen - 1]) : subStr[subLen - 1];
+
+	if (!ignoreCase || ((uint32)first < 0x80 && (uint32)last < 0x80))
+	{
+		const __m128i firstVector = FTCHARBlock::Splat((uint32)first);
+		const __m128i lastVector  = FTCHARBlock::Splat((uint32)last);
+		const uint32  laneBits    = (1u << sizeof(TCHAR)) - 1;
+
+		for (; i + TCHARS_PER_VECTOR - 1 <= lastStart; i += TCHARS_PER_VECTOR)
+		{
+			__m128i firstChars = _mm_loadu_si128((const __m128i*)(str + i));
+			__m128i lastChars  = _mm_loadu_si128((const __m128i*)(str + i + subLen - 1));
+
+			if (ignoreCase)
+			{
+				if (!IsAsciiVector(_mm_or_si128(firstChars, lastChars)))
+				{
+					for (int32 j = i; j < i + TCHARS_PER_VECTOR; ++j)
+					{
+						if (MatchesAt(str + j, subStr, subLen, true))
+						{
+							return j;
+						}
+					}
+
+					continue;
+				}
+
+				firstChars = ToLowerAsciiVector(firstChars);
+				lastChars  = ToLowerAsciiVector(lastChars);
+			}
+
+			uint32 candidates = (uint32)_mm_movemask_epi8(_mm_and_si128(FTCHARBlock::Equal(firstChars, firstVector), FTCHARBlock::Equal(lastChars, lastVector)));
+			while (candidates)
+			{
+				const uint32 bit = FMath::CountTrailingZeros(candidates);
+				const int32  j   = i + (int32)(bit / sizeof(TCHAR));
+
+				if (MatchesAt(str + j, subStr, subLen, ignoreCase))
+				{
+					return j;
+				}
+
+				candidates &= ~(laneBits << bit);
+			}
+		}
+	}
+#endif
+
+	for (; i <= lastStart; ++i)
+	{
+		if (MatchesAt(str + i, subStr, subLen, ignoreCase))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int32 FUnicode::FormatV(TCHAR* dest, int32 destLen, const TCHAR* format, va_list args)
+{
+	va_list argsCopy;
+	va_copy(argsCopy, args);
+	errno = 0;
+	const int32 written = vswprintf(dest, destLen, format, argsCopy);
+	va_end(argsCopy);
+
+	if (written >= 0)
+	{
+		return written;
+	}
+
+	// vswprintf returns -1 both when dest is too small and when an argument cannot be encoded, tell them apart.
+#if defined(_MSC_VER)
+	va_copy(argsCopy, args);
+	const int32 needed = _vscwprintf(format, argsCopy);
+	va_end(argsCopy);
+
+	return needed < 0 ? -1 : (needed < destLen ? destLen : needed);
+#else
+	return errno == EILSEQ ? -1 : destLen;
+#endif
+}
\ No newline at end of file
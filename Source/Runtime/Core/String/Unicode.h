@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+#include <cstdarg>
+
+/**
+* Transcoding and scanning kernels behind FStringConv and FString. Runs of ASCII are handled 16 code units at a
+* time with SSE2 and everything else one code point at a time, so mostly ASCII text such as script sources and
+* config files converts close to memcpy speed. Malformed input decodes to U+FFFD, see FStringConv.
+*
+* Lengths are in code units of the respective encoding. The converters return the length the full conversion
+* needs and write at most destLen code units, dest may be null to only measure. Past the last code point that
+* fit, the contents of dest are unspecified.
+*/
+struct FUnicode
+{
+	enum
+	{
+		REPLACEMENT_CHAR = 0xFFFD,
+	};
+
+	/** True if the bytes are well formed UTF-8: no overlong forms, truncated sequences, surrogates or code points past U+10FFFF. */
+	static bool ValidateUTF8(const ANSICHAR* src, int32 srcLen);
+
+	/** Number of code points in well formed UTF-8. Each byte that is not a continuation byte counts as one. */
+	static int32 CountCodePoints(const ANSICHAR* src, int32 srcLen);
+
+	static int32 UTF8ToUTF16(CHAR16* dest, int32 destLen, const ANSICHAR* src, int32 srcLen);
+
+	static int32 UTF8ToUTF32(CHAR32* dest, int32 destLen, const ANSICHAR* src, int32 srcLen);
+
+	static int32 UTF16ToUTF8(ANSICHAR* dest, int32 destLen, const CHAR16* src, int32 srcLen);
+
+	static int32 UTF32ToUTF8(ANSICHAR* dest, int32 destLen, const CHAR32* src, int32 srcLen);
+
+	/** Locale independent simple case mapping. Beyond ASCII it covers the Latin, Greek, Cyrillic, Armenian and fullwidth blocks. */
+	FORCE_INLINE static TCHAR ToLower(TCHAR c)
+	{
+		if ((uint32)c < 0x80)
+		{
+			return (c >= 'A' && c <= 'Z') ? (TCHAR)(c + ('a' - 'A')) : c;
+		}
+
+		return ToLowerNonAscii(c);
+	}
+
+	FORCE_INLINE static TCHAR ToUpper(TCHAR c)
+	{
+		if ((uint32)c < 0x80)
+		{
+			return (c >= 'a' && c <= 'z') ? (TCHAR)(c - ('a' - 'A')) : c;
+		}
+
+		return ToUpperNonAscii(c);
+	}
+
+	/** Compares count characters after ToLower, returns <0, 0 or >0. */
+	static int32 CompareIgnoreCase(const TCHAR* a, const TCHAR* b, int32 count);
+
+	/** Index of the first occurrence of subStr in str, INDEX_NONE (-1) if there is none. */
+	static int32 Find(const TCHAR* str, int32 len, const TCHAR* subStr, int32 subLen, bool ignoreCase);
+
+	/**
+	* vswprintf into destLen characters of dest, terminator included. Returns the formatted length when it fit, destLen
+	* or more when dest is too small, the exact need where the platform can measure it, and -1 when the arguments cannot
+	* be encoded at all, e.g. a narrow %s that is invalid in the current locale. A bigger buffer never fixes the latter.
+	*/
+	static int32 FormatV(TCHAR* dest, int32 destLen, const TCHAR* format, va_list args);
+
+private:
+
+	static TCHAR ToLowerNonAscii(TCHAR c);
+
+	static TCHAR ToUpperNonAscii(TCHAR c);
+};
\ No newline at end of file
@@ -4,6 +4,57 @@
 #include "Runtime/Windows/WindowsMisc.h"
 #include "Runtime/Math/Math.h"
 #include "Runtime/Core/Globals.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/PlatformTime.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Render/RenderThread.h"
+#include "Runtime/RHI/DynamicRHI.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Log/Log.h"
+
+#include <cfloat>
+#include <cwchar>
+#include <Windows.h>
+
+namespace Fly3DPrivateEngineLoop
+{
+	/** How early before the deadline WaitUntil stops sleeping and spins, a sleep can overshoot by about a timer period. */
+	static const double SPIN_SECONDS = 0.002;
+
+	static bool ParseIntOption(const WIDECHAR* commandLine, const WIDECHAR* option, int32& outValue)
+	{
+		const WIDECHAR* found = commandLine ? wcsstr(commandLine, option) : nullptr;
+		if (!found)
+		{
+			return false;
+		}
+
+		outValue = (int32)wcstol(found + wcslen(option), nullptr, 10);
+		return true;
+	}
+
+	/** Sleeps most of the way to targetTime and spins the rest, the sleep alone is not precise enough to pace frames. */
+	static void WaitUntil(double targetTime)
+	{
+		while (true)
+		{
+			const double remaining = targetTime - FPlatformTime::Seconds();
+			if (remaining <= 0.0)
+			{
+				return;
+			}
+
+			if (remaining > SPIN_SECONDS)
+			{
+				::Sleep((DWORD)((remaining - SPIN_SECONDS) * 1000.0));
+			}
+			else
+			{
+				FPlatformAtomics::Pause();
+			}
+		}
+	}
+}
 
 static void FitWindowSize(float widthBias, float heightBias, std::shared_ptr<FWindowDefinition>& def)
 {
@@ -21,6 +72,16 @@ static void FitWindowSize(float widthBias, float heightBias, std::shared_ptr<FWi
 }
 
 FEngineLoop::FEngineLoop()
+	: m_NumFramesInFlight(FRenderThread::DEFAULT_FRAMES_IN_FLIGHT)
+	, m_MaxFPS(0)
+	, m_NextFrameTime(0.0)
+	, m_LastFrameTime(0.0)
+	, m_DeltaTime(0.0)
+	, m_FrameCounter(0)
+	, m_TotalTickTime(0.0)
+	, m_MaxTickTime(0.0)
+	, m_MinTickTime(DBL_MAX)
+	, m_MaxFrameCounter(0)
 {
 
 }
@@ -32,6 +93,21 @@ FEngineLoop::~FEngineLoop()
 
 int32 FEngineLoop::PreInit(int32 argc, WIDECHAR* argv)
 {
+	int32 numFrames;
+	if (Fly3DPrivateEngineLoop::ParseIntOption(argv, TEXT("-FramesInFlight="), numFrames))
+	{
+		m_NumFramesInFlight = FMath::Min(FMath::Max(numFrames, 1), (int32)FRenderThread::MAX_FRAMES_IN_FLIGHT);
+	}
+
+	int32 maxFPS;
+	if (Fly3DPrivateEngineLoop::ParseIntOption(argv, TEXT("-MaxFPS="), maxFPS))
+	{
+		m_MaxFPS = FMath::Max(maxFPS, 0);
+	}
+
+	// Sleep rounds up to the timer period, 15.6 ms by default, which would make the frame limiter spin most of the frame.
+	::timeBeginPeriod(1);
+
 	std::shared_ptr<FWindowDefinition> def = std::make_shared<FWindowDefinition>();
 	FitWindowSize(0.8f, 0.8f, def);
 
@@ -43,6 +119,17 @@ int32 FEngineLoop::PreInit(int32 argc, WIDECHAR* argv)
 
 int32 FEngineLoop::Init()
 {
+	FJobSystem::Startup();
+
+	const FTaskGraph::FTaskHandle input      = m_FrameGraph.AddTask(TEXT("Input"), [this]() { TickInput(); }, ETaskThread::Main);
+	const FTaskGraph::FTaskHandle simulation = m_FrameGraph.AddTask(TEXT("Simulation"), [this]() { TickSimulation(); });
+	const FTaskGraph::FTaskHandle scripting  = m_FrameGraph.AddTask(TEXT("Scripting"), [this]() { TickScripting(); });
+	const FTaskGraph::FTaskHandle render     = m_FrameGraph.AddTask(TEXT("RenderSubmission"), [this]() { TickRenderSubmission(); });
+
+	m_FrameGraph.AddPrerequisite(simulation, input);
+	m_FrameGraph.AddPrerequisite(scripting, input);
+	m_FrameGraph.AddPrerequisite(render, simulation);
+	m_FrameGraph.AddPrerequisite(render, scripting);
 
 	return 0;
 }
@@ -55,29 +142,125 @@ int32 FEngineLoop::PostInit()
 
 void FEngineLoop::Exit()
 {
+	if (m_FrameCounter > 0)
+	{
+		LOGI("%llu frames, tick avg %.3f ms, min %.3f ms, max %.3f ms in frame %llu\n", (unsigned long long)m_FrameCounter, GetAverageTickTime() * 1000.0, m_MinTickTime * 1000.0, m_MaxTickTime * 1000.0, (unsigned long long)m_MaxFrameCounter);
+		LOGI("Last %d frames: tick p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, %d hitches (%llu in total)\n", m_TickTimes.GetNumFrames(), m_TickTimes.GetPercentile(50.0) * 1000.0, m_TickTimes.GetPercentile(95.0) * 1000.0, m_TickTimes.GetPercentile(99.0) * 1000.0, m_TickTimes.GetNumHitchesInWindow(), (unsigned long long)m_TickTimes.GetTotalNumHitches());
+	}
 
+	::timeEndPeriod(1);
+
+	if (GDynamicRHI)
+	{
+		FRenderThread::Enqueue([]() { GDynamicRHI->Shutdown(); });
+	}
+
+	FRenderThread::Shutdown();
+	FLY3D_DELETE(GDynamicRHI);
+
+	FJobSystem::Shutdown();
 }
 
 void FEngineLoop::Tick()
 {
-	FWindowsApplication::GetApplication()->PumpMessages(0.016f);
+	WaitForNextFrame();
+
+	const double frameTime = FPlatformTime::Seconds();
+	m_DeltaTime     = m_FrameCounter > 0 ? frameTime - m_LastFrameTime : 0.0;
+	m_LastFrameTime = frameTime;
+
+	const uint64 startCycles = FPlatformTime::Cycles64();
+
+	// The frame graph records frame N while the render thread may still work on the frames before.
+	FRenderThread::BeginFrame();
+	m_FrameGraph.Execute();
+	FRenderThread::EndFrame();
+
+	UpdateTickStats(FPlatformTime::ToSeconds(FPlatformTime::Cycles64() - startCycles));
 }
 
-void FEngineLoop::PreInitRHI()
+void FEngineLoop::WaitForNextFrame()
 {
+	int32 maxFPS = m_MaxFPS;
+	if (Globals::Minimized)
+	{
+		maxFPS = maxFPS > 0 ? FMath::Min(maxFPS, (int32)IDLE_MAX_FPS) : (int32)IDLE_MAX_FPS;
+	}
+
+	if (maxFPS <= 0)
+	{
+		m_NextFrameTime = 0.0;
+		return;
+	}
+
+	const double frameDuration = 1.0 / maxFPS;
 
+	double now = FPlatformTime::Seconds();
+	if (now < m_NextFrameTime)
+	{
+		Fly3DPrivateEngineLoop::WaitUntil(m_NextFrameTime);
+		now = m_NextFrameTime;
+	}
+
+	// Frames are paced from the last deadline so that the rate holds on average. A frame that missed its slot by a
+	// whole frame restarts the pacing instead, rather than running the missed frames back to back.
+	const double frameStart = now - m_NextFrameTime > frameDuration ? now : m_NextFrameTime;
+	m_NextFrameTime = frameStart + frameDuration;
 }
 
-void FEngineLoop::InitRHI()
+void FEngineLoop::UpdateTickStats(double tickTime)
 {
+	m_TickTimes.AddFrame(tickTime);
+
+	m_TotalTickTime += tickTime;
+	m_MinTickTime    = FMath::Min(m_MinTickTime, tickTime);
 
+	if (tickTime > m_MaxTickTime)
+	{
+		m_MaxTickTime     = tickTime;
+		m_MaxFrameCounter = m_FrameCounter;
+	}
+
+	++m_FrameCounter;
 }
 
-void FEngineLoop::PostInitRHI()
+void FEngineLoop::TickInput()
+{
+	FWindowsApplication::GetApplication()->PumpMessages((float)m_DeltaTime);
+}
+
+void FEngineLoop::TickSimulation()
+{
+
+}
+
+void FEngineLoop::TickScripting()
+{
+
+}
+
+void FEngineLoop::TickRenderSubmission()
 {
 
 }
 
+void FEngineLoop::PreInitRHI()
+{
+	// There is no device backend yet.
+	GDynamicRHI = FLY3D_NEW(FNullDynamicRHI, kMemTypeRegular)();
+}
+
+void FEngineLoop::InitRHI()
+{
+	FRenderThread::Startup(m_NumFramesInFlight);
+	FRenderThread::Enqueue([]() { GDynamicRHI->Init(); });
+}
+
+void FEngineLoop::PostInitRHI()
+{
+	FRenderThread::Flush();
+}
+
 void FEngineLoop::PreInitApp()
 {
 
@@ -1,9 +1,19 @@
 ﻿#pragma once
 
 #include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/Jobs/TaskGraph.h"
+#include "Runtime/Profiler/FrameTimeHistogram.h"
 
 class FEngineLoop
 {
+public:
+
+	enum
+	{
+		/** Frame rate cap while the window is minimized, frames then only pump messages and keep the engine alive. */
+		IDLE_MAX_FPS = 10,
+	};
+
 public:
 	FEngineLoop();
 
@@ -35,12 +45,80 @@ public:
 
 	virtual void ExitApp();
 
+	/** Frame phases, run by Tick as a task graph. Input runs on the main thread before the others. */
+	virtual void TickInput();
+
+	virtual void TickSimulation();
+
+	virtual void TickScripting();
+
+	/**
+	* Runs after both simulation and scripting, the place to enqueue the frame's render commands. Tick itself hands the
+	* frame to the render thread, it begins the RHI frame before the frame graph and ends it after.
+	*/
+	virtual void TickRenderSubmission();
+
+	/** Seconds between the start of the last frame and the one before it, 0 in the first frame. */
+	FORCE_INLINE double GetDeltaTime() const
+	{
+		return m_DeltaTime;
+	}
+
+	FORCE_INLINE uint64 GetFrameCounter() const
+	{
+		return m_FrameCounter;
+	}
+
+	/** Average seconds Tick took, over all frames so far. */
+	FORCE_INLINE double GetAverageTickTime() const
+	{
+		return m_FrameCounter > 0 ? m_TotalTickTime / (double)m_FrameCounter : 0.0;
+	}
+
+	/** The seconds Tick took over the last frames, for percentiles and hitches. */
+	FORCE_INLINE const FFrameTimeHistogram& GetTickTimeHistogram() const
+	{
+		return m_TickTimes;
+	}
+
+	/** 0 runs frames back to back. */
+	FORCE_INLINE void SetMaxFPS(int32 maxFPS)
+	{
+		m_MaxFPS = maxFPS;
+	}
+
+protected:
+
+	/** Waits until the frame limiter lets the next frame start. */
+	void WaitForNextFrame();
+
+	void UpdateTickStats(double tickTime);
+
 protected:
 
+	FTaskGraph	m_FrameGraph;
+
+	/** Frames the game thread may run ahead of the render thread, -FramesInFlight=N on the command line. */
+	int32		m_NumFramesInFlight;
+
+	/** Frame rate cap, -MaxFPS=N on the command line. */
+	int32		m_MaxFPS;
+
+	/** The earliest the frame limiter lets the next frame start. */
+	double		m_NextFrameTime;
+
+	double		m_LastFrameTime;
+	double		m_DeltaTime;
+	uint64		m_FrameCounter;
+
+	FFrameTimeHistogram	m_TickTimes;
+
+	/** Seconds spent in Tick, summed up over all frames and of the slowest and the fastest frame. */
 	double		m_TotalTickTime;
 	double		m_MaxTickTime;
 	double		m_MinTickTime;
 	
+	/** The frame that took m_MaxTickTime. */
 	uint64		m_MaxFrameCounter;
 };
 
@@ -69,6 +69,13 @@ struct FMath
 		return bitIndex;
 	}
 
+	static uint32 CountBits(uint32 value)
+	{
+		value = value - ((value >> 1) & 0x55555555u);
+		value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+		return (((value + (value >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+	}
+
 	static uint32 CeilLogTwo(uint32 arg)
 	{
 		int32 bitmask = ((int32)(CountLeadingZeros(arg) << 26)) >> 31;
@@ -8,6 +8,30 @@
 #define ENABLE_MEM_PROFILER FLY_DEBUG
 #endif // !ENABLE_MEM_PROFILER
 
+/** Reports reserved and used bytes of every TArray to the memory profiler. Opt-in, it adds a tracker to each array and atomics to every resize. */
+#ifndef ENABLE_CONTAINER_SLACK_TRACKING
+#define ENABLE_CONTAINER_SLACK_TRACKING 0
+#endif // !ENABLE_CONTAINER_SLACK_TRACKING
+
+#if ENABLE_CONTAINER_SLACK_TRACKING && !ENABLE_MEM_PROFILER
+#error ENABLE_CONTAINER_SLACK_TRACKING requires ENABLE_MEM_PROFILER
+#endif
+
+/** Functors up to this many bytes are stored inside TFunction and TUniqueFunction instead of on the heap. */
+#ifndef FUNCTION_INLINE_SIZE
+#define FUNCTION_INLINE_SIZE 32
+#endif // !FUNCTION_INLINE_SIZE
+
+/** Runs jobs on fibers, so that FJobSystem::Wait inside a job parks the job instead of holding on to its thread. */
+#ifndef JOB_SYSTEM_USE_FIBERS
+#define JOB_SYSTEM_USE_FIBERS 0
+#endif // !JOB_SYSTEM_USE_FIBERS
+
+/** Counts contended acquisitions and sleeps of FMutex, FTicketLock, FRWLock and FEvent. */
+#ifndef ENABLE_LOCK_STATS
+#define ENABLE_LOCK_STATS FLY_DEBUG
+#endif // !ENABLE_LOCK_STATS
+
 #ifndef ENABLE_ASSERTIONS
 #define ENABLE_ASSERTIONS FLY_DEBUG
 #endif // !ENABLE_ASSERTIONS
@@ -20,4 +44,10 @@
 #define PLATFORM_64BITS 1
 #endif // PLATFORM_32BITS
 
-
+#ifndef PLATFORM_ENABLE_VECTORINTRINSICS
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define PLATFORM_ENABLE_VECTORINTRINSICS 1
+#else
+#define PLATFORM_ENABLE_VECTORINTRINSICS 0
+#endif
+#endif // !PLATFORM_ENABLE_VECTORINTRINSICS
@@ -15,9 +15,24 @@ typedef wchar_t				WIDECHAR;
 typedef uint8				CHAR8;
 typedef uint16				CHAR16;
 typedef uint32				CHAR32;
+typedef WIDECHAR			TCHAR;
 
 typedef int32				TYPE_OF_NULL;
 typedef decltype(nullptr)	TYPE_OF_NULLPTR;
 
 #define FORCE_INLINE inline
-#define FORCE_NOINLINE 
+#if defined(_MSC_VER)
+#define FORCE_NOINLINE __declspec(noinline)
+#else
+#define FORCE_NOINLINE __attribute__((noinline))
+#endif
+
+#ifndef PLATFORM_CACHE_LINE_SIZE
+#define PLATFORM_CACHE_LINE_SIZE 64
+#endif // !PLATFORM_CACHE_LINE_SIZE
+
+// Spelled exactly like winnt.h so that Windows.h may be included before or after this header.
+#ifndef TEXT
+#define __TEXT(quote) L##quote
+#define TEXT(quote) __TEXT(quote)
+#endif // !TEXT
\ No newline at end of file
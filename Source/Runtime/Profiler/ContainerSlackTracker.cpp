@@ -0,0 +1,37 @@
+﻿#include "Runtime/Profiler/ContainerSlackTracker.h"
+#include "Runtime/Profiler/MemoryProfiler.h"
+
+#if ENABLE_CONTAINER_SLACK_TRACKING
+
+FContainerSlackTracker::~FContainerSlackTracker()
+{
+	FMemoryProfiler::TrackContainerSlack(m_Type, -m_ReservedBytes, -m_UsedBytes);
+
+	if (m_PeakReservedBytes)
+	{
+		FMemoryProfiler::RetireContainer(m_Type, m_PeakReservedBytes, m_PeakUsedBytes);
+	}
+}
+
+void FContainerSlackTracker::Update(EAllocatorType type, size_t reservedBytes, size_t usedBytes)
+{
+	Assert(m_Type == type || m_ReservedBytes == 0);
+
+	FMemoryProfiler::TrackContainerSlack(type, (int64)reservedBytes - m_ReservedBytes, (int64)usedBytes - m_UsedBytes);
+
+	m_Type          = type;
+	m_ReservedBytes = (int64)reservedBytes;
+	m_UsedBytes     = (int64)usedBytes;
+
+	if (m_ReservedBytes > m_PeakReservedBytes)
+	{
+		m_PeakReservedBytes = m_ReservedBytes;
+	}
+
+	if (m_UsedBytes > m_PeakUsedBytes)
+	{
+		m_PeakUsedBytes = m_UsedBytes;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Allocator/AllocatorType.h"
+
+#if ENABLE_CONTAINER_SLACK_TRACKING
+
+/**
+* Remembers what a container last reported to the memory profiler so that each update only sends the delta,
+* and keeps the container's high-water marks which are reported when it dies. Copies start out empty
+* since the copied container has reported nothing yet.
+*/
+class FContainerSlackTracker
+{
+public:
+
+	FContainerSlackTracker()
+		: m_Type(kMemTypeRegular)
+		, m_ReservedBytes(0)
+		, m_UsedBytes(0)
+		, m_PeakReservedBytes(0)
+		, m_PeakUsedBytes(0)
+	{
+
+	}
+
+	FContainerSlackTracker(const FContainerSlackTracker& other)
+		: FContainerSlackTracker()
+	{
+
+	}
+
+	FContainerSlackTracker& operator=(const FContainerSlackTracker& other)
+	{
+		return *this;
+	}
+
+	~FContainerSlackTracker();
+
+	void Update(EAllocatorType type, size_t reservedBytes, size_t usedBytes);
+
+	FORCE_INLINE int64 GetReservedBytes() const
+	{
+		return m_ReservedBytes;
+	}
+
+	FORCE_INLINE int64 GetUsedBytes() const
+	{
+		return m_UsedBytes;
+	}
+
+	FORCE_INLINE int64 GetPeakReservedBytes() const
+	{
+		return m_PeakReservedBytes;
+	}
+
+	FORCE_INLINE int64 GetPeakUsedBytes() const
+	{
+		return m_PeakUsedBytes;
+	}
+
+private:
+
+	EAllocatorType m_Type;
+	int64          m_ReservedBytes;
+	int64          m_UsedBytes;
+	int64          m_PeakReservedBytes;
+	int64          m_PeakUsedBytes;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+﻿#include "Runtime/Profiler/FrameTimeHistogram.h"
+#include "Runtime/Core/PlatformMemory.h"
+
+const double FFrameTimeHistogram::BUCKET_SECONDS = 0.0001;
+const double FFrameTimeHistogram::MAX_SECONDS    = FFrameTimeHistogram::BUCKET_SECONDS * FFrameTimeHistogram::NUM_BUCKETS;
+
+FFrameTimeHistogram::FFrameTimeHistogram()
+{
+	Reset();
+}
+
+void FFrameTimeHistogram::Reset()
+{
+	FPlatformMemory::Memzero(m_BucketCounts, sizeof(m_BucketCounts));
+
+	m_NextFrame          = 0;
+	m_NumFrames          = 0;
+	m_NumHitchesInWindow = 0;
+	m_TotalNumHitches    = 0;
+}
+
+void FFrameTimeHistogram::AddFrame(double seconds)
+{
+	const int32 bucket  = seconds <= 0.0 ? 0 : seconds >= MAX_SECONDS ? NUM_BUCKETS - 1 : (int32)(seconds / BUCKET_SECONDS);
+	const bool  isHitch = m_NumFrames >= MIN_FRAMES_FOR_HITCHES && seconds > GetPercentile(50.0) * HITCH_MEDIAN_MULTIPLE;
+
+	if (m_NumFrames == WINDOW_SIZE)
+	{
+		const uint16 oldest = m_Frames[m_NextFrame];
+		m_BucketCounts[oldest & ~HITCH_FLAG] -= 1;
+		m_NumHitchesInWindow -= (oldest & HITCH_FLAG) ? 1 : 0;
+	}
+	else
+	{
+		m_NumFrames += 1;
+	}
+
+	m_Frames[m_NextFrame] = (uint16)(bucket | (isHitch ? HITCH_FLAG : 0));
+	m_NextFrame           = (m_NextFrame + 1) % WINDOW_SIZE;
+	m_BucketCounts[bucket] += 1;
+
+	if (isHitch)
+	{
+		m_NumHitchesInWindow += 1;
+		m_TotalNumHitches    += 1;
+	}
+}
+
+double FFrameTimeHistogram::GetPercentile(double percentile) const
+{
+	if (m_NumFrames == 0)
+	{
+		return 0.0;
+	}
+
+	// The number of frames at or below the percentile, at least one so that 0 gives the fastest frame.
+	int32 rank = (int32)(percentile * 0.01 * m_NumFrames + 0.5);
+	rank = rank < 1 ? 1 : rank > m_NumFrames ? m_NumFrames : rank;
+
+	int32 count = 0;
+	for (int32 bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+	{
+		count += m_BucketCounts[bucket];
+		if (count >= rank)
+		{
+			return (bucket + 1) * BUCKET_SECONDS;
+		}
+	}
+
+	return MAX_SECONDS;
+}
\ No newline at end of file
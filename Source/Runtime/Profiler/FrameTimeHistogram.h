@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+/**
+* Frame times of the last WINDOW_SIZE frames, counted in buckets of BUCKET_SECONDS so that adding a frame and
+* reading a percentile cost the same however long the engine runs. Percentiles are the upper edge of their
+* bucket; frames of MAX_SECONDS and more all land in the last bucket.
+*
+* A frame is a hitch if it took more than HITCH_MEDIAN_MULTIPLE times the median of the window before it.
+*/
+class FFrameTimeHistogram
+{
+public:
+
+	enum
+	{
+		WINDOW_SIZE = 1024,
+
+		NUM_BUCKETS = 1000,
+
+		/** Frames in the window before hitches are counted, the median of the first few frames means little. */
+		MIN_FRAMES_FOR_HITCHES = 32,
+
+		HITCH_MEDIAN_MULTIPLE = 2,
+	};
+
+	static const double BUCKET_SECONDS;
+	static const double MAX_SECONDS;
+
+public:
+
+	FFrameTimeHistogram();
+
+	void AddFrame(double seconds);
+
+	void Reset();
+
+	/** Seconds that percentile (0 to 100) of the frames in the window took at most, 0 while it is empty. */
+	double GetPercentile(double percentile) const;
+
+	FORCE_INLINE int32 GetNumFrames() const
+	{
+		return m_NumFrames;
+	}
+
+	FORCE_INLINE int32 GetNumHitchesInWindow() const
+	{
+		return m_NumHitchesInWindow;
+	}
+
+	FORCE_INLINE uint64 GetTotalNumHitches() const
+	{
+		return m_TotalNumHitches;
+	}
+
+private:
+
+	enum : uint16
+	{
+		/** Set in a ring entry next to its bucket if the frame was a hitch. */
+		HITCH_FLAG = 0x8000,
+	};
+
+private:
+
+	/** Bucket of each frame in the window, oldest at m_NextFrame once the window is full. */
+	uint16 m_Frames[WINDOW_SIZE];
+	int32  m_BucketCounts[NUM_BUCKETS];
+	int32  m_NextFrame;
+	int32  m_NumFrames;
+	int32  m_NumHitchesInWindow;
+	uint64 m_TotalNumHitches;
+};
\ No newline at end of file
@@ -1,10 +1,18 @@
 ﻿#include "Runtime/Profiler/MemoryProfiler.h"
 #include "Runtime/Log/Assert.h"
+#include "Runtime/Core/PlatformAtomics.h"
 
 #if ENABLE_MEM_PROFILER
 
 static FMemoryProfiler g_MemoryProfiler;
 
+// Zero initialized before any static constructor runs, so global containers can report at any time.
+static volatile int64 g_ContainerReservedBytes[kMemTypeCout];
+static volatile int64 g_ContainerUsedBytes[kMemTypeCout];
+static volatile int64 g_ContainerNumRetired[kMemTypeCout];
+static volatile int64 g_ContainerRetiredPeakReservedBytes[kMemTypeCout];
+static volatile int64 g_ContainerRetiredPeakUsedBytes[kMemTypeCout];
+
 FMemoryProfiler* GetMemoryProfiler()
 {
 	return &g_MemoryProfiler;
@@ -85,4 +93,54 @@ bool FMemoryProfiler::UnRegisterAllocation(const FMemorySalt* salt)
 	return true;
 }
 
+void FMemoryProfiler::TrackContainerSlack(EAllocatorType type, int64 reservedBytesDelta, int64 usedBytesDelta)
+{
+	if (reservedBytesDelta)
+	{
+		FPlatformAtomics::InterlockedAdd(&g_ContainerReservedBytes[type], reservedBytesDelta, EMemoryOrder::Relaxed);
+	}
+
+	if (usedBytesDelta)
+	{
+		FPlatformAtomics::InterlockedAdd(&g_ContainerUsedBytes[type], usedBytesDelta, EMemoryOrder::Relaxed);
+	}
+}
+
+void FMemoryProfiler::RetireContainer(EAllocatorType type, int64 peakReservedBytes, int64 peakUsedBytes)
+{
+	FPlatformAtomics::InterlockedIncrement(&g_ContainerNumRetired[type], EMemoryOrder::Relaxed);
+	FPlatformAtomics::InterlockedAdd(&g_ContainerRetiredPeakReservedBytes[type], peakReservedBytes, EMemoryOrder::Relaxed);
+	FPlatformAtomics::InterlockedAdd(&g_ContainerRetiredPeakUsedBytes[type], peakUsedBytes, EMemoryOrder::Relaxed);
+}
+
+FContainerSlackStats FMemoryProfiler::GetContainerSlackStats(EAllocatorType type) const
+{
+	FContainerSlackStats stats;
+	stats.ReservedBytes            = FPlatformAtomics::AtomicRead(&g_ContainerReservedBytes[type], EMemoryOrder::Relaxed);
+	stats.UsedBytes                = FPlatformAtomics::AtomicRead(&g_ContainerUsedBytes[type], EMemoryOrder::Relaxed);
+	stats.NumRetired               = FPlatformAtomics::AtomicRead(&g_ContainerNumRetired[type], EMemoryOrder::Relaxed);
+	stats.RetiredPeakReservedBytes = FPlatformAtomics::AtomicRead(&g_ContainerRetiredPeakReservedBytes[type], EMemoryOrder::Relaxed);
+	stats.RetiredPeakUsedBytes     = FPlatformAtomics::AtomicRead(&g_ContainerRetiredPeakUsedBytes[type], EMemoryOrder::Relaxed);
+	return stats;
+}
+
+void FMemoryProfiler::DumpContainerSlackStats() const
+{
+	for (int32 type = 0; type < kMemTypeCout; ++type)
+	{
+		const FContainerSlackStats stats = GetContainerSlackStats((EAllocatorType)type);
+		if (stats.ReservedBytes == 0 && stats.NumRetired == 0)
+		{
+			continue;
+		}
+
+		LOGI("%s: live %lld/%lld bytes used (slack %lld), retired %lld containers peaked at %lld/%lld bytes used (slack %lld)\n",
+			GetAllocatorTypeName((EAllocatorType)type),
+			stats.UsedBytes, stats.ReservedBytes, stats.ReservedBytes - stats.UsedBytes,
+			stats.NumRetired,
+			stats.RetiredPeakUsedBytes, stats.RetiredPeakReservedBytes, stats.RetiredPeakReservedBytes - stats.RetiredPeakUsedBytes
+		);
+	}
+}
+
 #endif
\ No newline at end of file
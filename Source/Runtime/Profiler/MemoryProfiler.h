@@ -10,6 +10,7 @@
 class FMemoryProfiler;
 struct FMemorySalt;
 
+/** Sits right before the returned pointer, offset is the alignment padding between the allocator block and the salt. */
 struct FMemorySalt
 {
 #if ENABLE_MEM_PROFILER
@@ -18,22 +19,42 @@ struct FMemorySalt
 #endif
 	uint32				size;
 	EAllocatorType		type;
+	uint32				offset;
 	FBaseAllocator*		owner;
 
-	void Fill(uint32 inSize, EAllocatorType inType, FBaseAllocator* inOwner, const char* inFile, int32 inLine)
+	void Fill(uint32 inSize, uint32 inOffset, EAllocatorType inType, FBaseAllocator* inOwner, const char* inFile, int32 inLine)
 	{
 #if ENABLE_MEM_PROFILER
 		file = inFile;
 		line = inLine;
 #endif
-		size  = inSize;
-		type  = inType;
-		owner = inOwner;
+		size   = inSize;
+		offset = inOffset;
+		type   = inType;
+		owner  = inOwner;
+	}
+
+	FORCE_INLINE void* GetBlock() const
+	{
+		return (uint8*)this - offset;
 	}
 };
 
 #if ENABLE_MEM_PROFILER
 
+/** Aggregated container slack for one allocator label. */
+struct FContainerSlackStats
+{
+	/** Bytes currently reserved and used by live containers. */
+	int64 ReservedBytes;
+	int64 UsedBytes;
+
+	/** Peak reserved and used bytes summed over destroyed containers, the gap is what the slack policies wasted. */
+	int64 NumRetired;
+	int64 RetiredPeakReservedBytes;
+	int64 RetiredPeakUsedBytes;
+};
+
 class FMemoryProfiler : public Noncopyable
 {
 public:
@@ -57,6 +78,15 @@ public:
 
 	bool UnRegisterAllocation(const FMemorySalt* salt);
 
+	/** Thread safe, may be called before the profiler itself is constructed. */
+	static void TrackContainerSlack(EAllocatorType type, int64 reservedBytesDelta, int64 usedBytesDelta);
+
+	static void RetireContainer(EAllocatorType type, int64 peakReservedBytes, int64 peakUsedBytes);
+
+	FContainerSlackStats GetContainerSlackStats(EAllocatorType type) const;
+
+	void DumpContainerSlackStats() const;
+
 private:
 
 	std::unordered_set<const FMemorySalt*> m_Salts;
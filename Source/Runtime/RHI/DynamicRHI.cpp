@@ -0,0 +1,3 @@
+﻿#include "Runtime/RHI/DynamicRHI.h"
+
+FDynamicRHI* GDynamicRHI = nullptr;
\ No newline at end of file
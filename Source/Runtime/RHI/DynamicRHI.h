@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+/** The rendering backend. Created on the game thread, everything else is called on the render thread. */
+class FDynamicRHI
+{
+public:
+
+	virtual ~FDynamicRHI()
+	{
+
+	}
+
+	virtual const TCHAR* GetName() const = 0;
+
+	virtual void Init() = 0;
+
+	virtual void Shutdown() = 0;
+
+	virtual void BeginFrame() = 0;
+
+	/** Submits the frame's work and presents it. */
+	virtual void EndFrame() = 0;
+};
+
+/** Renders nothing. Runs the game and render threads without a device, such as headless and on platforms without a backend. */
+class FNullDynamicRHI : public FDynamicRHI
+{
+public:
+
+	virtual const TCHAR* GetName() const override
+	{
+		return TEXT("Null");
+	}
+
+	virtual void Init() override
+	{
+
+	}
+
+	virtual void Shutdown() override
+	{
+
+	}
+
+	virtual void BeginFrame() override
+	{
+
+	}
+
+	virtual void EndFrame() override
+	{
+
+	}
+};
+
+extern FDynamicRHI* GDynamicRHI;
\ No newline at end of file
@@ -0,0 +1,225 @@
+﻿#include "Runtime/Render/RenderThread.h"
+#include "Runtime/RHI/DynamicRHI.h"
+#include "Runtime/Core/Containers/MpmcQueue.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Fly3DPrivateRenderThread
+{
+	enum
+	{
+		/** Rounds of looking for commands with a pause in between before the render thread goes to sleep. */
+		IDLE_SPIN_COUNT = 64,
+	};
+
+	static thread_local bool s_IsRenderThread = false;
+
+	/** Until the render thread or the queue is done, the waiting thread helps out with jobs. */
+	template <typename PredicateType>
+	static FORCE_INLINE void WaitUntil(PredicateType predicate)
+	{
+		while (!predicate())
+		{
+			if (!FJobSystem::TryExecuteOne())
+			{
+				FPlatformAtomics::YieldThread();
+			}
+		}
+	}
+
+	class FRenderCommandQueue : public Noncopyable
+	{
+	public:
+
+		explicit FRenderCommandQueue(int32 numFramesInFlight)
+			: m_Commands(FRenderThread::COMMAND_QUEUE_CAPACITY)
+			, m_NumFramesInFlight(numFramesInFlight)
+			, m_FrameIndex(0)
+			, m_IsStopping(0)
+			, m_NumSleeping(0)
+		{
+			m_Thread = std::thread([this]() { ThreadMain(); });
+		}
+
+		~FRenderCommandQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				FPlatformAtomics::AtomicStore(&m_IsStopping, 1);
+			}
+			m_WakeUp.notify_one();
+
+			m_Thread.join();
+		}
+
+		FORCE_INLINE int32 GetNumFramesInFlight() const
+		{
+			return m_NumFramesInFlight;
+		}
+
+		void Enqueue(TUniqueFunction<void()>&& command)
+		{
+			// A failed push leaves command untouched.
+			if (!m_Commands.Push(MoveTemp(command)))
+			{
+				WaitUntil([this, &command]() { return m_Commands.Push(MoveTemp(command)); });
+			}
+
+			// A full barrier between the push and this read, pairs with the increment in ThreadMain.
+			if (FPlatformAtomics::InterlockedAdd(&m_NumSleeping, 0) > 0)
+			{
+				std::lock_guard<std::mutex> lock(m_SleepMutex);
+				m_WakeUp.notify_one();
+			}
+		}
+
+		void EndFrame()
+		{
+			m_FrameFences[m_FrameIndex].BeginFence();
+			m_FrameIndex = (m_FrameIndex + 1) % m_NumFramesInFlight;
+
+			// The fence the next frame is about to reuse is the one of the frame NumFramesInFlight frames back.
+			m_FrameFences[m_FrameIndex].Wait();
+		}
+
+	private:
+
+		void ThreadMain()
+		{
+			s_IsRenderThread = true;
+
+			TUniqueFunction<void()> command;
+			int32                   spin = 0;
+
+			while (true)
+			{
+				if (m_Commands.Pop(command))
+				{
+					command();
+					command = nullptr;
+
+					spin = 0;
+					continue;
+				}
+
+				if (++spin < IDLE_SPIN_COUNT)
+				{
+					FPlatformAtomics::Pause();
+					continue;
+				}
+
+				spin = 0;
+
+				std::unique_lock<std::mutex> lock(m_SleepMutex);
+
+				// Announce the sleep before the last look, a thread pushing after that look sees it in Enqueue.
+				FPlatformAtomics::InterlockedIncrement(&m_NumSleeping);
+				if (m_Commands.IsEmpty() && !FPlatformAtomics::AtomicRead_Relaxed(&m_IsStopping))
+				{
+					m_WakeUp.wait(lock);
+				}
+				FPlatformAtomics::InterlockedDecrement(&m_NumSleeping);
+
+				// Stopping only once every command enqueued before Shutdown ran.
+				if (FPlatformAtomics::AtomicRead_Relaxed(&m_IsStopping) && m_Commands.IsEmpty())
+				{
+					break;
+				}
+			}
+
+			s_IsRenderThread = false;
+		}
+
+	private:
+
+		TMpmcQueue<TUniqueFunction<void()>> m_Commands;
+
+		FRenderFence m_FrameFences[FRenderThread::MAX_FRAMES_IN_FLIGHT];
+		int32        m_NumFramesInFlight;
+		int32        m_FrameIndex;
+
+		std::thread             m_Thread;
+		volatile int32          m_IsStopping;
+		volatile int32          m_NumSleeping;
+		std::mutex              m_SleepMutex;
+		std::condition_variable m_WakeUp;
+	};
+
+	static FRenderCommandQueue* s_Queue = nullptr;
+}
+
+void FRenderFence::BeginFence()
+{
+	FPlatformAtomics::AtomicStore(&m_IsSignaled, 0, EMemoryOrder::Relaxed);
+	FRenderThread::Enqueue([this]() { FPlatformAtomics::AtomicStore(&m_IsSignaled, 1, EMemoryOrder::Release); });
+}
+
+void FRenderFence::Wait() const
+{
+	Fly3DPrivateRenderThread::WaitUntil([this]() { return IsComplete(); });
+}
+
+void FRenderThread::Startup(int32 numFramesInFlight)
+{
+	AssertMsg(Fly3DPrivateRenderThread::s_Queue == nullptr, "Render thread is already running\n");
+	AssertMsg(numFramesInFlight >= 1 && numFramesInFlight <= MAX_FRAMES_IN_FLIGHT, "%d frames in flight are not supported\n", numFramesInFlight);
+
+	Fly3DPrivateRenderThread::s_Queue = FLY3D_NEW(Fly3DPrivateRenderThread::FRenderCommandQueue, kMemTypeRegular)(numFramesInFlight);
+}
+
+void FRenderThread::Shutdown()
+{
+	FLY3D_DELETE(Fly3DPrivateRenderThread::s_Queue);
+}
+
+bool FRenderThread::IsRunning()
+{
+	return Fly3DPrivateRenderThread::s_Queue != nullptr;
+}
+
+bool FRenderThread::IsInRenderThread()
+{
+	return Fly3DPrivateRenderThread::s_IsRenderThread;
+}
+
+int32 FRenderThread::GetNumFramesInFlight()
+{
+	return Fly3DPrivateRenderThread::s_Queue ? Fly3DPrivateRenderThread::s_Queue->GetNumFramesInFlight() : 1;
+}
+
+void FRenderThread::Enqueue(TUniqueFunction<void()>&& command)
+{
+	if (Fly3DPrivateRenderThread::s_Queue == nullptr || Fly3DPrivateRenderThread::s_IsRenderThread)
+	{
+		command();
+		return;
+	}
+
+	Fly3DPrivateRenderThread::s_Queue->Enqueue(MoveTemp(command));
+}
+
+void FRenderThread::Flush()
+{
+	FRenderFence fence;
+	fence.BeginFence();
+	fence.Wait();
+}
+
+void FRenderThread::BeginFrame()
+{
+	Enqueue([]() { GDynamicRHI->BeginFrame(); });
+}
+
+void FRenderThread::EndFrame()
+{
+	Enqueue([]() { GDynamicRHI->EndFrame(); });
+
+	if (Fly3DPrivateRenderThread::s_Queue)
+	{
+		Fly3DPrivateRenderThread::s_Queue->EndFrame();
+	}
+}
\ No newline at end of file
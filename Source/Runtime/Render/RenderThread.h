@@ -0,0 +1,84 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Template/Function.h"
+#include "Runtime/Template/Noncopyable.h"
+
+/** Lets the game thread wait until the render thread executed every command enqueued before the fence. */
+class FRenderFence : public Noncopyable
+{
+public:
+
+	FRenderFence()
+		: m_IsSignaled(1)
+	{
+
+	}
+
+	/** Enqueues the fence behind the commands enqueued so far. */
+	void BeginFence();
+
+	FORCE_INLINE bool IsComplete() const
+	{
+		return FPlatformAtomics::AtomicRead(&m_IsSignaled, EMemoryOrder::Acquire) != 0;
+	}
+
+	/** Executes queued jobs meanwhile. */
+	void Wait() const;
+
+private:
+
+	volatile int32 m_IsSignaled;
+};
+
+/**
+* The render thread and the bounded command queue that feeds it. The game thread records a frame as commands and
+* goes on with the next frame while the render thread executes them, up to GetNumFramesInFlight() frames ahead;
+* EndFrame blocks once the game thread would get further ahead than that.
+*
+* Commands run in the order they were enqueued. Without a render thread, and on the render thread itself, Enqueue
+* executes the command immediately.
+*/
+class FRenderThread
+{
+public:
+
+	enum
+	{
+		DEFAULT_FRAMES_IN_FLIGHT = 2,
+
+		MAX_FRAMES_IN_FLIGHT = 4,
+
+		/** Commands the queue holds, Enqueue waits for the render thread while it is full. */
+		COMMAND_QUEUE_CAPACITY = 4096,
+	};
+
+public:
+
+	/** numFramesInFlight of 1 keeps the threads in lockstep: the game thread waits for each frame to finish. */
+	static void Startup(int32 numFramesInFlight = DEFAULT_FRAMES_IN_FLIGHT);
+
+	/** Executes the remaining commands and stops the render thread. */
+	static void Shutdown();
+
+	static bool IsRunning();
+
+	static bool IsInRenderThread();
+
+	static int32 GetNumFramesInFlight();
+
+	static void Enqueue(TUniqueFunction<void()>&& command);
+
+	/** Waits until the render thread executed every command enqueued so far. */
+	static void Flush();
+
+	/** Starts a frame of the RHI. */
+	static void BeginFrame();
+
+	/**
+	* Ends the frame of the RHI, then waits until the render thread finished the frame NumFramesInFlight frames back.
+	* Called by the game thread only.
+	*/
+	static void EndFrame();
+};
\ No newline at end of file
@@ -1262,3 +1262,49 @@ void* tlsf_realloc(tlsf_t tlsf, void* ptr, size_t size)
 
 	return p;
 }
+
+/*
+** Resizes an allocated block without moving it. Growing succeeds only
+** when the next physical block is free and large enough to absorb the
+** difference; shrinking always succeeds. Returns 1 on success and 0
+** otherwise, in which case the block is left untouched.
+*/
+int tlsf_expand_in_place(tlsf_t tlsf, void* ptr, size_t size)
+{
+	control_t* control = tlsf_cast(control_t*, tlsf);
+	block_header_t* block;
+	block_header_t* next;
+	size_t cursize;
+	size_t adjust;
+
+	if (!ptr || size == 0)
+	{
+		return 0;
+	}
+
+	block = block_from_ptr(ptr);
+	next = block_next(block);
+	cursize = block_size(block);
+	adjust = adjust_request_size(size, ALIGN_SIZE);
+
+	tlsf_assert(!block_is_free(block) && "block already marked as free");
+
+	if (adjust == 0)
+	{
+		return 0;
+	}
+
+	if (adjust > cursize)
+	{
+		if (!block_is_free(next) || adjust > cursize + block_size(next) + block_header_overhead)
+		{
+			return 0;
+		}
+
+		block_merge_next(control, block);
+		block_mark_as_used(block);
+	}
+
+	block_trim_used(control, block, adjust);
+	return 1;
+}
@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/Template.h"
+
+/**
+* Implicit d-ary heap helpers shared by TArray and TPriorityQueue.
+* Predicate(a, b) returns true when a must be closer to the top than b, so TLess gives a min-heap.
+* An Arity greater than 2 makes the heap shallower and keeps the children of a node in one cache line.
+*/
+namespace Fly3DPrivateHeap
+{
+	template <uint32 Arity, typename IndexType>
+	FORCE_INLINE IndexType HeapGetParentIndex(IndexType index)
+	{
+		return (index - 1) / (IndexType)Arity;
+	}
+
+	template <uint32 Arity, typename IndexType>
+	FORCE_INLINE IndexType HeapGetFirstChildIndex(IndexType index)
+	{
+		return index * (IndexType)Arity + 1;
+	}
+
+	template <uint32 Arity, typename RangeValueType, typename IndexType, typename PredicateType>
+	FORCE_INLINE void HeapSiftDown(RangeValueType* heap, IndexType index, const IndexType count, const PredicateType& predicate)
+	{
+		static_assert(Arity >= 2, "Heap arity must be at least 2.");
+
+		if (HeapGetFirstChildIndex<Arity>(index) >= count)
+		{
+			return;
+		}
+
+		RangeValueType temp = MoveTemp(heap[index]);
+
+		while (true)
+		{
+			const IndexType firstChild = HeapGetFirstChildIndex<Arity>(index);
+			if (firstChild >= count)
+			{
+				break;
+			}
+
+			const IndexType lastChild = (count - firstChild > (IndexType)Arity) ? firstChild + (IndexType)Arity : count;
+
+			IndexType bestChild = firstChild;
+			for (IndexType child = firstChild + 1; child < lastChild; ++child)
+			{
+				if (predicate(heap[child], heap[bestChild]))
+				{
+					bestChild = child;
+				}
+			}
+
+			if (!predicate(heap[bestChild], temp))
+			{
+				break;
+			}
+
+			heap[index] = MoveTemp(heap[bestChild]);
+			index = bestChild;
+		}
+
+		heap[index] = MoveTemp(temp);
+	}
+
+	template <uint32 Arity, typename RangeValueType, typename IndexType, typename PredicateType>
+	FORCE_INLINE IndexType HeapSiftUp(RangeValueType* heap, IndexType rootIndex, IndexType nodeIndex, const PredicateType& predicate)
+	{
+		static_assert(Arity >= 2, "Heap arity must be at least 2.");
+
+		if (nodeIndex <= rootIndex || !predicate(heap[nodeIndex], heap[HeapGetParentIndex<Arity>(nodeIndex)]))
+		{
+			return nodeIndex;
+		}
+
+		RangeValueType temp = MoveTemp(heap[nodeIndex]);
+
+		while (nodeIndex > rootIndex)
+		{
+			const IndexType parentIndex = HeapGetParentIndex<Arity>(nodeIndex);
+			if (!predicate(temp, heap[parentIndex]))
+			{
+				break;
+			}
+
+			heap[nodeIndex] = MoveTemp(heap[parentIndex]);
+			nodeIndex = parentIndex;
+		}
+
+		heap[nodeIndex] = MoveTemp(temp);
+
+		return nodeIndex;
+	}
+
+	template <uint32 Arity, typename RangeValueType, typename IndexType, typename PredicateType>
+	FORCE_INLINE void Heapify(RangeValueType* heap, IndexType count, const PredicateType& predicate)
+	{
+		if (count < 2)
+		{
+			return;
+		}
+
+		IndexType index = HeapGetParentIndex<Arity>(count - 1);
+		while (true)
+		{
+			HeapSiftDown<Arity>(heap, index, count, predicate);
+			if (index == 0)
+			{
+				break;
+			}
+			--index;
+		}
+	}
+
+	template <uint32 Arity, typename RangeValueType, typename IndexType, typename PredicateType>
+	bool IsHeap(const RangeValueType* heap, IndexType count, const PredicateType& predicate)
+	{
+		for (IndexType index = 1; index < count; ++index)
+		{
+			if (predicate(heap[index], heap[HeapGetParentIndex<Arity>(index)]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
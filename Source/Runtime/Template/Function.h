@@ -15,6 +15,7 @@
 #include "Runtime/Template/IsConstructible.h"
 #include "Runtime/Template/RemovePointer.h"
 #include "Runtime/Template/Template.h"
+#include "Runtime/Template/TypeCompatibleBytes.h"
 
 template <typename FuncType>
 class TFunction;
@@ -162,15 +163,24 @@ struct TIsTFunctionRef<const volatile T>
 
 namespace Fly3DPrivateFunction
 {
-	template <typename T>
-	struct TFunctionOwnedObject;
+	enum
+	{
+		/** The inline buffer also holds the owned object's vtable pointer. */
+		INLINE_STORAGE_SIZE      = FUNCTION_INLINE_SIZE + sizeof(void*),
+		INLINE_STORAGE_ALIGNMENT = 16,
+	};
+
+	struct FFunctionStorage;
 
 	template <bool unique>
 	struct TFunctionStorage;
 
 	struct IFunctionOwnedObject
 	{
-		virtual void* CloneToStorage(void* storage) const = 0;
+		virtual void* CloneToStorage(FFunctionStorage& storage) const = 0;
+
+		/** Moves the object into an empty storage and destroys this one. Only called for inline objects, heap ones are moved by pointer. */
+		virtual void* MoveToStorage(FFunctionStorage& storage) = 0;
 
 		virtual void* GetAddress() = 0;
 
@@ -179,70 +189,166 @@ namespace Fly3DPrivateFunction
 		virtual ~IFunctionOwnedObject() = default;
 	};
 
-	template <typename T>
-	struct IFunctionOwnedObjectOnHeap : public IFunctionOwnedObject
+	template <typename T, bool onHeap>
+	struct TFunctionOwnedObject : public IFunctionOwnedObject
 	{
-		virtual void Destroy() override
+		template <typename... ArgTypes>
+		explicit TFunctionOwnedObject(ArgTypes&&... args)
+			: obj(Forward<ArgTypes>(args)...)
 		{
-			void* This = this;
-			this->~IFunctionOwnedObjectOnHeap();
-			GetAllocator()->Deallocate((uint8*)This);
+
 		}
 
-		~IFunctionOwnedObjectOnHeap() override
+		virtual void* GetAddress() override
 		{
+			return &obj;
+		}
+
+		virtual void Destroy() override
+		{
+			void* This = this;
+			this->~TFunctionOwnedObject();
 
+			if (onHeap)
+			{
+				GetAllocator()->Deallocate((uint8*)This);
+			}
 		}
+
+		T obj;
 	};
 
+	/** Functors that fit the inline buffer are stored in the TFunction itself, larger or over-aligned ones on the heap. */
 	template <typename T>
-	struct TFunctionOwnedObject : public IFunctionOwnedObjectOnHeap<T>
+	struct TFunctionFitsInline
 	{
-		template <typename... ArgTypes>
-		explicit TFunctionOwnedObject(ArgTypes&&... args)
-			: obj(Forward<ArgTypes>(args)...)
+		enum
+		{
+			Value = sizeof(TFunctionOwnedObject<T, false>) <= INLINE_STORAGE_SIZE && alignof(T) <= INLINE_STORAGE_ALIGNMENT
+		};
+	};
+
+	struct FFunctionStorage
+	{
+		FFunctionStorage()
+			: heapAllocation(nullptr)
 		{
 
 		}
 
-		virtual void* GetAddress() override
+		FFunctionStorage(const FFunctionStorage& other) = delete;
+
+		FFunctionStorage& operator=(FFunctionStorage&& other) = delete;
+
+		FFunctionStorage& operator=(const FFunctionStorage& other) = delete;
+
+		/** Memory for a new owned object, which must not be bound yet. */
+		template <typename OwnedType, bool onHeap>
+		void* Allocate()
 		{
-			return &obj;
+			if (!onHeap)
+			{
+				return &inlineAllocation;
+			}
+
+			heapAllocation = GetAllocator()->Allocate(sizeof(OwnedType), alignof(OwnedType), EAllocatorType::kMemTypeFunction, __FILE__, __LINE__);
+			return heapAllocation;
 		}
 
-		T obj;
+		void* BindCopy(const FFunctionStorage& other)
+		{
+			return other.GetBoundObject()->CloneToStorage(*this);
+		}
+
+		/** Takes over the object bound to other, which is left unbound. */
+		void* BindMove(FFunctionStorage& other)
+		{
+			if (other.heapAllocation)
+			{
+				heapAllocation       = other.heapAllocation;
+				other.heapAllocation = nullptr;
+				return GetPtr();
+			}
+
+			return other.GetBoundObject()->MoveToStorage(*this);
+		}
+
+		IFunctionOwnedObject* GetBoundObject() const
+		{
+			return heapAllocation ? (IFunctionOwnedObject*)heapAllocation : (IFunctionOwnedObject*)&inlineAllocation;
+		}
+
+		void* GetPtr() const
+		{
+			return GetBoundObject()->GetAddress();
+		}
+
+		void Unbind()
+		{
+			GetBoundObject()->Destroy();
+			heapAllocation = nullptr;
+		}
+
+		void* heapAllocation;
+
+		TAlignedBytes<INLINE_STORAGE_SIZE, INLINE_STORAGE_ALIGNMENT> inlineAllocation;
 	};
 
-	template <typename T>
-	struct TFunctionCopyableOwnedObject final : public TFunctionOwnedObject<T>
+	template <typename T, bool onHeap>
+	struct TFunctionCopyableOwnedObject final : public TFunctionOwnedObject<T, onHeap>
 	{
 		explicit TFunctionCopyableOwnedObject(const T& inObj)
-			: TFunctionOwnedObject<T>(inObj)
+			: TFunctionOwnedObject<T, onHeap>(inObj)
 		{
 
 		}
 
 		explicit TFunctionCopyableOwnedObject(T&& inObj)
-			: TFunctionOwnedObject<T>(MoveTemp(inObj))
+			: TFunctionOwnedObject<T, onHeap>(MoveTemp(inObj))
 		{
+
+		}
+
+		void* CloneToStorage(FFunctionStorage& storage) const override
+		{
+			void* newAlloc = storage.Allocate<TFunctionCopyableOwnedObject, onHeap>();
+			auto* newOwned = new (newAlloc) TFunctionCopyableOwnedObject(this->obj);
+
+			return &newOwned->obj;
 		}
 
-		void* CloneToStorage(void* inStorage) const override;
+		void* MoveToStorage(FFunctionStorage& storage) override
+		{
+			void* newAlloc = storage.Allocate<TFunctionCopyableOwnedObject, onHeap>();
+			auto* newOwned = new (newAlloc) TFunctionCopyableOwnedObject(MoveTemp(this->obj));
+
+			this->Destroy();
+			return &newOwned->obj;
+		}
 	};
 
-	template <typename T>
-	struct TFunctionUniqueOwnedObject final : public TFunctionOwnedObject<T>
+	template <typename T, bool onHeap>
+	struct TFunctionUniqueOwnedObject final : public TFunctionOwnedObject<T, onHeap>
 	{
 		explicit TFunctionUniqueOwnedObject(T&& inObj)
-			: TFunctionOwnedObject<T>(MoveTemp(inObj))
+			: TFunctionOwnedObject<T, onHeap>(MoveTemp(inObj))
 		{
 
 		}
 
-		void* CloneToStorage(void* storage) const override
+		void* CloneToStorage(FFunctionStorage& storage) const override
 		{
 			return nullptr;
 		}
+
+		void* MoveToStorage(FFunctionStorage& storage) override
+		{
+			void* newAlloc = storage.Allocate<TFunctionUniqueOwnedObject, onHeap>();
+			auto* newOwned = new (newAlloc) TFunctionUniqueOwnedObject(MoveTemp(this->obj));
+
+			this->Destroy();
+			return &newOwned->obj;
+		}
 	};
 
 	template <typename T>
@@ -274,75 +380,25 @@ namespace Fly3DPrivateFunction
 	template <typename FunctorType>
 	struct TStorageOwnerType<FunctorType, true>
 	{
-		using Type = TFunctionUniqueOwnedObject<typename TDecay<FunctorType>::Type>;
+		using DecayedType = typename TDecay<FunctorType>::Type;
+		using Type        = TFunctionUniqueOwnedObject<DecayedType, !TFunctionFitsInline<DecayedType>::Value>;
 	};
 
 	template <typename FunctorType>
 	struct TStorageOwnerType<FunctorType, false>
 	{
-		using Type = TFunctionCopyableOwnedObject<typename TDecay<FunctorType>::Type>;
+		using DecayedType = typename TDecay<FunctorType>::Type;
+		using Type        = TFunctionCopyableOwnedObject<DecayedType, !TFunctionFitsInline<DecayedType>::Value>;
 	};
 
 	template <typename FunctorType, bool unique>
 	using TStorageOwnerTypeT = typename TStorageOwnerType<FunctorType, unique>::Type;
 
-	struct FFunctionStorage
-	{
-		FFunctionStorage()
-			: heapAllocation(nullptr)
-		{
-
-		}
-
-		FFunctionStorage(FFunctionStorage&& other)
-			: heapAllocation(other.heapAllocation)
-		{
-			other.heapAllocation = nullptr;
-		}
-
-		FFunctionStorage(const FFunctionStorage& other) = delete;
-
-		FFunctionStorage& operator=(FFunctionStorage&& other) = delete;
-
-		FFunctionStorage& operator=(const FFunctionStorage& other) = delete;
-
-		void* BindCopy(const FFunctionStorage& other)
-		{
-			void* newObj = other.GetBoundObject()->CloneToStorage(this);
-			return newObj;
-		}
-
-		IFunctionOwnedObject* GetBoundObject() const
-		{
-			IFunctionOwnedObject* result = (IFunctionOwnedObject*)heapAllocation;
-			return result;
-		}
-
-		void* GetPtr() const
-		{
-			return ((IFunctionOwnedObject*)heapAllocation)->GetAddress();
-		}
-
-		void Unbind()
-		{
-			IFunctionOwnedObject* owned = GetBoundObject();
-			owned->Destroy();
-		}
-
-		void* heapAllocation;
-	};
-
 	template <bool unique>
 	struct TFunctionStorage : FFunctionStorage
 	{
 		TFunctionStorage() = default;
 
-		TFunctionStorage(FFunctionStorage&& other)
-			: FFunctionStorage(MoveTemp(other))
-		{
-
-		}
-
 		template <typename FunctorType>
 		typename TDecay<FunctorType>::Type* Bind(FunctorType&& inFunc)
 		{
@@ -352,29 +408,15 @@ namespace Fly3DPrivateFunction
 			}
 
 			using OwnedType = TStorageOwnerTypeT<FunctorType, unique>;
+			using DecayedType = typename TDecay<FunctorType>::Type;
 
-			void* newAlloc = GetAllocator()->Allocate(sizeof(OwnedType), alignof(OwnedType), EAllocatorType::kMemTypeFunction, __FILE__, __LINE__);
+			void* newAlloc = Allocate<OwnedType, !TFunctionFitsInline<DecayedType>::Value>();
 			auto* newOwned = new (newAlloc) OwnedType(Forward<FunctorType>(inFunc));
 
-			heapAllocation = newAlloc;
-
 			return &newOwned->obj;
 		}
 	};
 
-	template <typename T>
-	void* TFunctionCopyableOwnedObject<T>::CloneToStorage(void* inStorage) const
-	{
-		TFunctionStorage<false>& storage = *(TFunctionStorage<false>*)inStorage;
-
-		void* newAlloc = GetAllocator()->Allocate(sizeof(TFunctionCopyableOwnedObject), alignof(TFunctionCopyableOwnedObject), EAllocatorType::kMemTypeFunction, __FILE__, __LINE__);
-		storage.heapAllocation = newAlloc;
-
-		auto* newOwned = new (newAlloc) TFunctionCopyableOwnedObject(this->obj);
-
-		return &newOwned->obj;
-	}
-
 	template <typename Functor, typename FuncType>
 	struct TFunctionRefCaller;
 
@@ -413,10 +455,10 @@ namespace Fly3DPrivateFunction
 
 		TFunctionRefBase(TFunctionRefBase&& other)
 			: callable(other.callable)
-			, storage (MoveTemp(other.storage))
 		{
 			if (callable)
 			{
+				storage.BindMove(other.storage);
 				other.callable = nullptr;
 			}
 		}
@@ -424,10 +466,10 @@ namespace Fly3DPrivateFunction
 		template <typename OtherStorage>
 		TFunctionRefBase(TFunctionRefBase<OtherStorage, Ret (ParamTypes...)>&& other)
 			: callable(other.callable)
-			, storage (MoveTemp(other.storage))
 		{
 			if (callable)
 			{
+				storage.BindMove(other.storage);
 				other.callable = nullptr;
 			}
 		}
@@ -498,6 +540,27 @@ namespace Fly3DPrivateFunction
 			return !!callable;
 		}
 
+		/** Unbinds this function and takes over the binding of other. */
+		void MoveAssign(TFunctionRefBase& other)
+		{
+			if (this == &other)
+			{
+				return;
+			}
+
+			if (callable)
+			{
+				storage.Unbind();
+			}
+
+			callable = other.callable;
+			if (callable)
+			{
+				storage.BindMove(other.storage);
+				other.callable = nullptr;
+			}
+		}
+
 	private:
 
 		Ret (*callable)(void*, ParamTypes&...);
@@ -568,6 +631,11 @@ namespace Fly3DPrivateFunction
 			return otherPtr;
 		}
 
+		void* BindMove(FFunctionRefStoragePolicy& other)
+		{
+			return BindCopy(other);
+		}
+
 		void* GetPtr() const
 		{
 			return ptr;
@@ -648,14 +716,14 @@ public:
 
 	TFunction& operator=(TFunction&& other)
 	{
-		Swap(*this, other);
+		Super::MoveAssign(other);
 		return *this;
 	}
 
 	TFunction& operator=(const TFunction& other)
 	{
 		TFunction temp = other;
-		Swap(*this, temp);
+		Super::MoveAssign(temp);
 		return *this;
 	}
 
@@ -706,7 +774,7 @@ public:
 
 	TUniqueFunction& operator=(TUniqueFunction&& other)
 	{
-		Swap(*this, other);
+		Super::MoveAssign(other);
 		return *this;
 	}
 
@@ -0,0 +1,27 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+template <typename T, T... Indices>
+struct TIntegerSequence
+{
+
+};
+
+namespace Fly3DPrivateIntegerSequence
+{
+	template <typename T, bool done, T N, T... Indices>
+	struct TMakeIntegerSequenceImpl
+	{
+		typedef typename TMakeIntegerSequenceImpl<T, N - 1 == 0, N - 1, N - 1, Indices...>::Type Type;
+	};
+
+	template <typename T, T N, T... Indices>
+	struct TMakeIntegerSequenceImpl<T, true, N, Indices...>
+	{
+		typedef TIntegerSequence<T, Indices...> Type;
+	};
+}
+
+template <typename T, T N>
+using TMakeIntegerSequence = typename Fly3DPrivateIntegerSequence::TMakeIntegerSequenceImpl<T, N == 0, N>::Type;
@@ -23,7 +23,7 @@ struct TIsMemberPointer<const T>
 { 
 	enum 
 	{ 
-		Value = TIsPointer<T>::Value 
+		Value = TIsMemberPointer<T>::Value 
 	}; 
 };
 
@@ -32,7 +32,7 @@ struct TIsMemberPointer<volatile T>
 { 
 	enum 
 	{ 
-		Value = TIsPointer<T>::Value 
+		Value = TIsMemberPointer<T>::Value 
 	}; 
 };
 
@@ -41,6 +41,6 @@ struct TIsMemberPointer<const volatile T>
 { 
 	enum 
 	{ 
-		Value = TIsPointer<T>::Value 
+		Value = TIsMemberPointer<T>::Value 
 	}; 
 };
\ No newline at end of file
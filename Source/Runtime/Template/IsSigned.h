@@ -0,0 +1,31 @@
+﻿#pragma once
+
+#include "Runtime/Template/IsEnum.h"
+
+namespace Fly3DPrivateIsSigned
+{
+	template <typename T, bool IsEnum = TIsEnum<T>::Value>
+	struct TIsSignedImpl
+	{
+		enum
+		{
+			Value = (T)-1 < (T)0
+		};
+	};
+
+	template <typename T>
+	struct TIsSignedImpl<T, true>
+	{
+		enum
+		{
+			Value = TIsSignedImpl<__underlying_type(T)>::Value
+		};
+	};
+}
+
+/** Whether an arithmetic type holds negative values. Enums answer for their underlying type. */
+template <typename T>
+struct TIsSigned : public Fly3DPrivateIsSigned::TIsSignedImpl<T>
+{
+
+};
\ No newline at end of file
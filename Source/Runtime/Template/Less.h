@@ -0,0 +1,23 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/Template.h"
+
+template <typename T = void>
+struct TLess
+{
+	FORCE_INLINE bool operator()(const T& a, const T& b) const
+	{
+		return a < b;
+	}
+};
+
+template <>
+struct TLess<void>
+{
+	template <typename T>
+	FORCE_INLINE bool operator()(const T& a, const T& b) const
+	{
+		return a < b;
+	}
+};
\ No newline at end of file
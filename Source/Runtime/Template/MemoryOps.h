@@ -1,11 +1,54 @@
 ﻿#pragma once
 
 #include "Runtime/Platform/Platform.h"
+#include "Runtime/Template/AreTypesEqual.h"
 #include "Runtime/Template/EnableIf.h"
 #include "Runtime/Template/IsTriviallyDestructible.h"
+#include "Runtime/Template/Template.h"
 #include "Runtime/Template/TypeTraits.h"
 
 #include <memory>
+#include <string.h>
+
+namespace Fly3DPrivateMemoryOps
+{
+	template <typename DestinationElementType, typename SourceElementType>
+	struct TCanBitwiseRelocate
+	{
+		enum
+		{
+			Value =
+				TOr<
+					TAnd<
+						TIsSame<DestinationElementType, SourceElementType>,
+						TIsBitwiseRelocatable<SourceElementType>
+					>,
+					TAnd<
+						TIsBitwiseConstructible<DestinationElementType, SourceElementType>,
+						TIsTriviallyDestructible<SourceElementType>
+					>
+				>::Value
+		};
+	};
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* address, SizeType count)
+{
+	ElementType* element = (ElementType*)address;
+	while (count)
+	{
+		new (element) ElementType;
+		++element;
+		--count;
+	}
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsZeroConstructType<ElementType>::Value>::Type DefaultConstructItems(void* elements, SizeType count)
+{
+	memset(elements, 0, sizeof(ElementType) * count);
+}
 
 template <typename ElementType>
 FORCE_INLINE typename TEnableIf<!TIsTriviallyDestructible<ElementType>::Value>::Type DestructItem(ElementType* element)
@@ -61,4 +104,70 @@ FORCE_INLINE typename TEnableIf<!TTypeTraits<ElementType>::IsBytewiseComparable,
 	}
 
 	return true;
-}
\ No newline at end of file
+}
+
+template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* dest, const SourceElementType* source, SizeType count)
+{
+	while (count)
+	{
+		new (dest) DestinationElementType(*source);
+		++(DestinationElementType*&)dest;
+		++source;
+		--count;
+	}
+}
+
+template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsBitwiseConstructible<DestinationElementType, SourceElementType>::Value>::Type ConstructItems(void* dest, const SourceElementType* source, SizeType count)
+{
+	if (count)
+	{
+		memcpy(dest, source, sizeof(SourceElementType) * count);
+	}
+}
+
+/**
+* Move-constructs count elements at dest from source and destructs the sources. The ranges may overlap,
+* the walk direction is chosen so that no source element is overwritten before it has been moved.
+*/
+template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!Fly3DPrivateMemoryOps::TCanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* dest, SourceElementType* source, SizeType count)
+{
+	typedef SourceElementType RelocateConstructItemsElementTypeTypedef;
+
+	DestinationElementType* destElement = (DestinationElementType*)dest;
+	if ((void*)destElement <= (void*)source)
+	{
+		while (count)
+		{
+			new (destElement) DestinationElementType(MoveTemp(*source));
+			source->RelocateConstructItemsElementTypeTypedef::~RelocateConstructItemsElementTypeTypedef();
+			++destElement;
+			++source;
+			--count;
+		}
+	}
+	else
+	{
+		destElement += count;
+		source      += count;
+		while (count)
+		{
+			--destElement;
+			--source;
+			new (destElement) DestinationElementType(MoveTemp(*source));
+			source->RelocateConstructItemsElementTypeTypedef::~RelocateConstructItemsElementTypeTypedef();
+			--count;
+		}
+	}
+}
+
+template <typename DestinationElementType, typename SourceElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<Fly3DPrivateMemoryOps::TCanBitwiseRelocate<DestinationElementType, SourceElementType>::Value>::Type RelocateConstructItems(void* dest, SourceElementType* source, SizeType count)
+{
+	if (count)
+	{
+		memmove(dest, source, sizeof(SourceElementType) * count);
+	}
+}
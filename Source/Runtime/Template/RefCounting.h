@@ -0,0 +1,333 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Allocator/MemoryMacros.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Template/Noncopyable.h"
+#include "Runtime/Template/Template.h"
+#include "Runtime/Template/TypeTraits.h"
+
+/**
+* Base for objects whose reference count lives in the object itself, held through TRefCountPtr. Unlike
+* TSharedPtr there is no controller block and no weak references: a handle is a single pointer and copying
+* it only touches the object. The object deletes itself from the engine heap when the count drops to zero, so
+* it must be allocated with FLY3D_NEW, as MakeRefCount does. Not thread safe, see FThreadSafeRefCountedObject.
+*/
+class FRefCountedObject : public Noncopyable
+{
+public:
+
+	FRefCountedObject()
+		: m_RefCount(0)
+	{
+
+	}
+
+	virtual ~FRefCountedObject()
+	{
+		Assert(m_RefCount == 0);
+	}
+
+	FORCE_INLINE uint32 AddRef() const
+	{
+		return (uint32)++m_RefCount;
+	}
+
+	uint32 Release() const
+	{
+		const int32 refCount = --m_RefCount;
+		Assert(refCount >= 0);
+
+		if (refCount == 0)
+		{
+			Fly3DPrivateMemory::Delete(this);
+		}
+
+		return (uint32)refCount;
+	}
+
+	FORCE_INLINE uint32 GetRefCount() const
+	{
+		return (uint32)m_RefCount;
+	}
+
+private:
+
+	mutable int32 m_RefCount;
+};
+
+/** FRefCountedObject whose count is updated with interlocked operations, for objects shared between threads. */
+class FThreadSafeRefCountedObject : public Noncopyable
+{
+public:
+
+	FThreadSafeRefCountedObject()
+		: m_RefCount(0)
+	{
+
+	}
+
+	virtual ~FThreadSafeRefCountedObject()
+	{
+		Assert(m_RefCount == 0);
+	}
+
+	FORCE_INLINE uint32 AddRef() const
+	{
+		return (uint32)FPlatformAtomics::InterlockedIncrement(&m_RefCount, EMemoryOrder::Relaxed);
+	}
+
+	uint32 Release() const
+	{
+		const int32 refCount = FPlatformAtomics::InterlockedDecrement(&m_RefCount, EMemoryOrder::AcquireRelease);
+		Assert(refCount >= 0);
+
+		if (refCount == 0)
+		{
+			Fly3DPrivateMemory::Delete(this);
+		}
+
+		return (uint32)refCount;
+	}
+
+	FORCE_INLINE uint32 GetRefCount() const
+	{
+		return (uint32)FPlatformAtomics::AtomicRead(&m_RefCount, EMemoryOrder::Relaxed);
+	}
+
+private:
+
+	mutable volatile int32 m_RefCount;
+};
+
+/**
+* Pointer to an intrusively reference counted object. Works with any type that has AddRef() and Release(),
+* typically one derived from FRefCountedObject or FThreadSafeRefCountedObject. A raw pointer can be turned
+* back into a TRefCountPtr at any time since the count travels with the object.
+*/
+template <typename ReferencedType>
+class TRefCountPtr
+{
+	template <typename OtherType>
+	friend class TRefCountPtr;
+
+public:
+
+	FORCE_INLINE TRefCountPtr()
+		: m_Reference(nullptr)
+	{
+
+	}
+
+	TRefCountPtr(ReferencedType* reference, bool addRef = true)
+		: m_Reference(reference)
+	{
+		if (m_Reference && addRef)
+		{
+			m_Reference->AddRef();
+		}
+	}
+
+	TRefCountPtr(const TRefCountPtr& other)
+		: m_Reference(other.m_Reference)
+	{
+		if (m_Reference)
+		{
+			m_Reference->AddRef();
+		}
+	}
+
+	template <typename OtherType, typename = decltype(ImplicitConv<ReferencedType*>((OtherType*)nullptr))>
+	TRefCountPtr(const TRefCountPtr<OtherType>& other)
+		: m_Reference(other.m_Reference)
+	{
+		if (m_Reference)
+		{
+			m_Reference->AddRef();
+		}
+	}
+
+	FORCE_INLINE TRefCountPtr(TRefCountPtr&& other)
+		: m_Reference(other.m_Reference)
+	{
+		other.m_Reference = nullptr;
+	}
+
+	template <typename OtherType, typename = decltype(ImplicitConv<ReferencedType*>((OtherType*)nullptr))>
+	FORCE_INLINE TRefCountPtr(TRefCountPtr<OtherType>&& other)
+		: m_Reference(other.m_Reference)
+	{
+		other.m_Reference = nullptr;
+	}
+
+	~TRefCountPtr()
+	{
+		if (m_Reference)
+		{
+			m_Reference->Release();
+		}
+	}
+
+	TRefCountPtr& operator=(ReferencedType* reference)
+	{
+		// AddRef first, reference may only be kept alive by the object being released.
+		ReferencedType* oldReference = m_Reference;
+		m_Reference = reference;
+
+		if (m_Reference)
+		{
+			m_Reference->AddRef();
+		}
+
+		if (oldReference)
+		{
+			oldReference->Release();
+		}
+
+		return *this;
+	}
+
+	FORCE_INLINE TRefCountPtr& operator=(const TRefCountPtr& other)
+	{
+		return *this = other.m_Reference;
+	}
+
+	template <typename OtherType, typename = decltype(ImplicitConv<ReferencedType*>((OtherType*)nullptr))>
+	FORCE_INLINE TRefCountPtr& operator=(const TRefCountPtr<OtherType>& other)
+	{
+		return *this = other.m_Reference;
+	}
+
+	TRefCountPtr& operator=(TRefCountPtr&& other)
+	{
+		if (this != &other)
+		{
+			ReferencedType* oldReference = m_Reference;
+			m_Reference = other.m_Reference;
+			other.m_Reference = nullptr;
+
+			if (oldReference)
+			{
+				oldReference->Release();
+			}
+		}
+
+		return *this;
+	}
+
+	template <typename OtherType, typename = decltype(ImplicitConv<ReferencedType*>((OtherType*)nullptr))>
+	TRefCountPtr& operator=(TRefCountPtr<OtherType>&& other)
+	{
+		ReferencedType* oldReference = m_Reference;
+		m_Reference = other.m_Reference;
+		other.m_Reference = nullptr;
+
+		if (oldReference)
+		{
+			oldReference->Release();
+		}
+
+		return *this;
+	}
+
+	FORCE_INLINE ReferencedType* operator->() const
+	{
+		return m_Reference;
+	}
+
+	FORCE_INLINE ReferencedType& operator*() const
+	{
+		Assert(m_Reference);
+		return *m_Reference;
+	}
+
+	FORCE_INLINE ReferencedType* GetReference() const
+	{
+		return m_Reference;
+	}
+
+	FORCE_INLINE bool IsValid() const
+	{
+		return m_Reference != nullptr;
+	}
+
+	FORCE_INLINE explicit operator bool() const
+	{
+		return m_Reference != nullptr;
+	}
+
+	FORCE_INLINE void SafeRelease()
+	{
+		*this = nullptr;
+	}
+
+	/** Gives up the reference without releasing it, the caller takes over the count. */
+	FORCE_INLINE ReferencedType* Detach()
+	{
+		ReferencedType* reference = m_Reference;
+		m_Reference = nullptr;
+		return reference;
+	}
+
+	uint32 GetRefCount() const
+	{
+		return m_Reference ? m_Reference->GetRefCount() : 0;
+	}
+
+	FORCE_INLINE void Swap(TRefCountPtr& other)
+	{
+		ReferencedType* reference = m_Reference;
+		m_Reference = other.m_Reference;
+		other.m_Reference = reference;
+	}
+
+private:
+
+	ReferencedType* m_Reference;
+};
+
+template <typename ReferencedType, typename OtherType>
+FORCE_INLINE bool operator==(const TRefCountPtr<ReferencedType>& lhs, const TRefCountPtr<OtherType>& rhs)
+{
+	return lhs.GetReference() == rhs.GetReference();
+}
+
+template <typename ReferencedType, typename OtherType>
+FORCE_INLINE bool operator!=(const TRefCountPtr<ReferencedType>& lhs, const TRefCountPtr<OtherType>& rhs)
+{
+	return lhs.GetReference() != rhs.GetReference();
+}
+
+template <typename ReferencedType>
+FORCE_INLINE bool operator==(const TRefCountPtr<ReferencedType>& lhs, const ReferencedType* rhs)
+{
+	return lhs.GetReference() == rhs;
+}
+
+template <typename ReferencedType>
+FORCE_INLINE bool operator!=(const TRefCountPtr<ReferencedType>& lhs, const ReferencedType* rhs)
+{
+	return lhs.GetReference() != rhs;
+}
+
+template <typename ReferencedType, typename... ArgTypes>
+FORCE_INLINE TRefCountPtr<ReferencedType> MakeRefCount(ArgTypes&&... args)
+{
+	return TRefCountPtr<ReferencedType>(FLY3D_NEW(ReferencedType, kMemTypeRefCounted)(Forward<ArgTypes>(args)...));
+}
+
+template <typename ReferencedType>
+FORCE_INLINE uint32 GetTypeHash(const TRefCountPtr<ReferencedType>& ptr)
+{
+	return (uint32)(((size_t)ptr.GetReference()) >> 4);
+}
+
+/** A handle is just the pointer, so arrays of them grow with memcpy. */
+template <typename ReferencedType>
+struct TIsBitwiseRelocatable<TRefCountPtr<ReferencedType>>
+{
+	enum
+	{
+		Value = true
+	};
+};
\ No newline at end of file
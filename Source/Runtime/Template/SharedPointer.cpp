@@ -0,0 +1,82 @@
+﻿#include "Runtime/Template/SharedPointer.h"
+#include "Runtime/Core/HAL/Mutex.h"
+
+namespace Fly3DPrivateSharedPointer
+{
+	struct FFreeBlock
+	{
+		FFreeBlock* Next;
+	};
+
+	/** One cache line per size class, so threads contending on one lock do not slow down the neighbouring classes. */
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSizeClass
+	{
+		FFreeBlock* FreeList;
+		FMutex      Lock;
+	};
+
+	static FSizeClass s_SizeClasses[FReferenceControllerPool::NUM_SIZE_CLASSES];
+
+	static FORCE_INLINE bool UsesPool(uint32 size, uint32 align)
+	{
+		return size <= FReferenceControllerPool::MAX_BLOCK_SIZE && align <= FReferenceControllerPool::BLOCK_GRANULARITY;
+	}
+
+	static FORCE_INLINE FSizeClass& GetSizeClass(uint32 size)
+	{
+		return s_SizeClasses[(size - 1) / FReferenceControllerPool::BLOCK_GRANULARITY];
+	}
+
+	/** Carves a new page into blocks of blockSize and returns the first, the rest go on the free list. Called with the lock held. */
+	static FFreeBlock* RefillSizeClass(FSizeClass& sizeClass, uint32 blockSize)
+	{
+		uint8* page = (uint8*)FLY3D_MALLOC_ALIGNED(FReferenceControllerPool::PAGE_SIZE, FReferenceControllerPool::BLOCK_GRANULARITY, EAllocatorType::kMemTypeSharedPointer);
+
+		const uint32 numBlocks = FReferenceControllerPool::PAGE_SIZE / blockSize;
+		for (uint32 i = numBlocks - 1; i > 0; --i)
+		{
+			FFreeBlock* block = (FFreeBlock*)(page + i * blockSize);
+			block->Next = sizeClass.FreeList;
+			sizeClass.FreeList = block;
+		}
+
+		return (FFreeBlock*)page;
+	}
+
+	void* FReferenceControllerPool::Allocate(uint32 size, uint32 align)
+	{
+		if (!UsesPool(size, align))
+		{
+			return FLY3D_MALLOC_ALIGNED(size, align, EAllocatorType::kMemTypeSharedPointer);
+		}
+
+		FSizeClass&        sizeClass = GetSizeClass(size);
+		TScopeLock<FMutex> lock(sizeClass.Lock);
+
+		FFreeBlock* block = sizeClass.FreeList;
+		if (block)
+		{
+			sizeClass.FreeList = block->Next;
+			return block;
+		}
+
+		return RefillSizeClass(sizeClass, (size + BLOCK_GRANULARITY - 1) & ~(BLOCK_GRANULARITY - 1));
+	}
+
+	void FReferenceControllerPool::Free(void* block, uint32 size, uint32 align)
+	{
+		if (!UsesPool(size, align))
+		{
+			FLY3D_FREE(block);
+			return;
+		}
+
+		// The pool only grows. Pages are kept for the lifetime of the process, a freed block only goes back on its free list.
+		FSizeClass&        sizeClass = GetSizeClass(size);
+		TScopeLock<FMutex> lock(sizeClass.Lock);
+
+		FFreeBlock* freeBlock = (FFreeBlock*)block;
+		freeBlock->Next = sizeClass.FreeList;
+		sizeClass.FreeList = freeBlock;
+	}
+}
\ No newline at end of file
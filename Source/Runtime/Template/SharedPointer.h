@@ -3,6 +3,7 @@
 #include "Runtime/Platform/Platform.h"
 #include "Runtime/Core/PlatformAtomics.h"
 #include "Runtime/Core/PlatformMemory.h"
+#include "Runtime/Allocator/MemoryMacros.h"
 #include "Runtime/Template/AndOrNot.h"
 #include "Runtime/Template/RemoveReference.h"
 #include "Runtime/Template/TypeCompatibleBytes.h"
@@ -50,6 +51,31 @@ namespace Fly3DPrivateSharedPointer
 
 	};
 
+	/**
+	* Size-class pool for reference controllers. Controllers are small, of a handful of distinct sizes and churn
+	* with every shared pointer, so they come from per-size free lists carved out of engine allocated pages
+	* instead of going through the general heap each time. Blocks past MAX_BLOCK_SIZE or over-aligned ones
+	* fall back to the engine heap. Thread safe, a controller may be freed on another thread than it was allocated on.
+	*
+	* The pool only grows: pages are never handed back to the engine heap, so its footprint is the peak number of
+	* live controllers per size class, kept until the process exits.
+	*/
+	struct FReferenceControllerPool
+	{
+		enum
+		{
+			BLOCK_GRANULARITY = 16,
+			MAX_BLOCK_SIZE    = 128,
+			NUM_SIZE_CLASSES  = MAX_BLOCK_SIZE / BLOCK_GRANULARITY,
+			PAGE_SIZE         = 16 * 1024,
+		};
+
+		static void* Allocate(uint32 size, uint32 align);
+
+		/** size and align must be the ones the block was allocated with. */
+		static void Free(void* block, uint32 size, uint32 align);
+	};
+
 	class FReferenceControllerBase
 	{
 	public:
@@ -68,6 +94,9 @@ namespace Fly3DPrivateSharedPointer
 
 		virtual void DestroyObject() = 0;
 
+		/** Destroys the controller and returns its memory, once the last weak reference is gone. */
+		virtual void DeleteThis() = 0;
+
 	public:
 
 		int32 sharedReferenceCount;
@@ -96,6 +125,12 @@ namespace Fly3DPrivateSharedPointer
 			(*static_cast<DeleterType*>(this))(object);
 		}
 
+		virtual void DeleteThis() override
+		{
+			this->~TReferenceControllerWithDeleter();
+			FReferenceControllerPool::Free(this, sizeof(TReferenceControllerWithDeleter), alignof(TReferenceControllerWithDeleter));
+		}
+
 		TReferenceControllerWithDeleter(const TReferenceControllerWithDeleter& controller) = delete;
 
 		TReferenceControllerWithDeleter& operator=(const TReferenceControllerWithDeleter& controller) = delete;
@@ -125,6 +160,12 @@ namespace Fly3DPrivateSharedPointer
 			DestructItem((ObjectType*)&objectStorage);
 		}
 
+		virtual void DeleteThis() override
+		{
+			this->~TIntrusiveReferenceController();
+			FReferenceControllerPool::Free(this, sizeof(TIntrusiveReferenceController), alignof(TIntrusiveReferenceController));
+		}
+
 		TIntrusiveReferenceController(const TIntrusiveReferenceController& controller) = delete;
 
 		TIntrusiveReferenceController& operator=(const TIntrusiveReferenceController& controller) = delete;
@@ -142,22 +183,32 @@ namespace Fly3DPrivateSharedPointer
 		}
 	};
 
+	template <typename ControllerType>
+	FORCE_INLINE void* AllocateReferenceController()
+	{
+		return FReferenceControllerPool::Allocate(sizeof(ControllerType), alignof(ControllerType));
+	}
+
 	template <typename ObjectType>
 	FORCE_INLINE FReferenceControllerBase* NewDefaultReferenceController(ObjectType* object)
 	{
-		return new TReferenceControllerWithDeleter<ObjectType, DefaultDeleter<ObjectType>>(object, DefaultDeleter<ObjectType>());
+		typedef TReferenceControllerWithDeleter<ObjectType, DefaultDeleter<ObjectType>> ControllerType;
+		return new (AllocateReferenceController<ControllerType>()) ControllerType(object, DefaultDeleter<ObjectType>());
 	}
 
 	template <typename ObjectType, typename DeleterType>
 	FORCE_INLINE FReferenceControllerBase* NewCustomReferenceController(ObjectType* object, DeleterType&& deleter)
 	{
-		return new TReferenceControllerWithDeleter<ObjectType, typename TRemoveReference<DeleterType>::Type>(object, Forward<DeleterType>(deleter));
+		typedef TReferenceControllerWithDeleter<ObjectType, typename TRemoveReference<DeleterType>::Type> ControllerType;
+		return new (AllocateReferenceController<ControllerType>()) ControllerType(object, Forward<DeleterType>(deleter));
 	}
 
+	/** The object lives inside the controller, so MakeShared costs a single allocation. */
 	template <typename ObjectType, typename... ArgTypes>
 	FORCE_INLINE TIntrusiveReferenceController<ObjectType>* NewIntrusiveReferenceController(ArgTypes&&... args)
 	{
-		return new TIntrusiveReferenceController<ObjectType>(Forward<ArgTypes>(args)...);
+		typedef TIntrusiveReferenceController<ObjectType> ControllerType;
+		return new (AllocateReferenceController<ControllerType>()) ControllerType(Forward<ArgTypes>(args)...);
 	}
 
 	template<class ObjectType>
@@ -190,25 +241,26 @@ namespace Fly3DPrivateSharedPointer
 	{
 		static FORCE_INLINE const int32 GetSharedReferenceCount(const FReferenceControllerBase* referenceController)
 		{
-			return FPlatformAtomics::AtomicRead((int32 volatile*)&referenceController->sharedReferenceCount);
+			return FPlatformAtomics::AtomicRead((int32 volatile*)&referenceController->sharedReferenceCount, EMemoryOrder::Relaxed);
 		}
 
+		/** Taking a new reference needs no ordering, the caller already holds one. */
 		static FORCE_INLINE void AddSharedReference(FReferenceControllerBase* referenceController)
 		{
-			FPlatformAtomics::InterlockedIncrement(&referenceController->sharedReferenceCount);
+			FPlatformAtomics::InterlockedIncrement(&referenceController->sharedReferenceCount, EMemoryOrder::Relaxed);
 		}
 
 		static bool ConditionallyAddSharedReference(FReferenceControllerBase* referenceController)
 		{
 			while (true)
 			{
-				const int32 originalCount = FPlatformAtomics::AtomicRead((int32 volatile*)&referenceController->sharedReferenceCount);
+				const int32 originalCount = FPlatformAtomics::AtomicRead((int32 volatile*)&referenceController->sharedReferenceCount, EMemoryOrder::Relaxed);
 				if (originalCount == 0)
 				{
 					return false;
 				}
 
-				const int32 actualOriginalCount = FPlatformAtomics::InterlockedCompareExchange(&referenceController->sharedReferenceCount, originalCount + 1, originalCount);
+				const int32 actualOriginalCount = FPlatformAtomics::InterlockedCompareExchange(&referenceController->sharedReferenceCount, originalCount + 1, originalCount, EMemoryOrder::AcquireRelease);
 				if (actualOriginalCount == originalCount)
 				{
 					return true;
@@ -216,9 +268,10 @@ namespace Fly3DPrivateSharedPointer
 			}
 		}
 
+		/** The releasing decrement makes every other owner's writes to the object visible to the one that destroys it. */
 		static FORCE_INLINE void ReleaseSharedReference(FReferenceControllerBase* referenceController)
 		{
-			if (FPlatformAtomics::InterlockedDecrement(&referenceController->sharedReferenceCount) == 0)
+			if (FPlatformAtomics::InterlockedDecrement(&referenceController->sharedReferenceCount, EMemoryOrder::AcquireRelease) == 0)
 			{
 				referenceController->DestroyObject();
 				ReleaseWeakReference(referenceController);
@@ -227,14 +280,14 @@ namespace Fly3DPrivateSharedPointer
 
 		static FORCE_INLINE void AddWeakReference(FReferenceControllerBase* referenceController)
 		{
-			FPlatformAtomics::InterlockedIncrement(&referenceController->weakReferenceCount);
+			FPlatformAtomics::InterlockedIncrement(&referenceController->weakReferenceCount, EMemoryOrder::Relaxed);
 		}
 
 		static void ReleaseWeakReference(FReferenceControllerBase* referenceController)
 		{
-			if (FPlatformAtomics::InterlockedDecrement(&referenceController->weakReferenceCount) == 0)
+			if (FPlatformAtomics::InterlockedDecrement(&referenceController->weakReferenceCount, EMemoryOrder::AcquireRelease) == 0)
 			{
-				delete referenceController;
+				referenceController->DeleteThis();
 			}
 		}
 	};
@@ -281,7 +334,7 @@ namespace Fly3DPrivateSharedPointer
 		{
 			if (--referenceController->weakReferenceCount == 0)
 			{
-				delete referenceController;
+				referenceController->DeleteThis();
 			}
 		}
 	};
@@ -789,6 +842,15 @@ private:
 	Fly3DPrivateSharedPointer::FSharedReferencer<Mode> sharedReferenceCount;
 };
 
+template<class ObjectType, ESPMode Mode> 
+struct TIsBitwiseRelocatable<TSharedRef<ObjectType, Mode>> 
+{ 
+	enum 
+	{ 
+		Value = true 
+	};
+};
+
 template<class T>
 struct FMakeReferenceTo
 {
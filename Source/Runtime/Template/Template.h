@@ -1,12 +1,14 @@
 ﻿#pragma once
 
 #include "Runtime/Platform/Platform.h"
+#include "Runtime/Core/PlatformMemory.h"
 
 #include "Runtime/Template/RemoveReference.h"
 #include "Runtime/Template/IsArithmetic.h"
 #include "Runtime/Template/IsPointer.h"
 #include "Runtime/Template/AndOrNot.h"
 #include "Runtime/Template/EnableIf.h"
+#include "Runtime/Template/TypeTraits.h"
 
 #include <memory>
 
@@ -15,7 +17,7 @@ struct TUseBitwiseSwap
 {
 	enum 
 	{ 
-		Value = !TOrValue<__is_enum(T), TIsPointer<T>, TIsArithmetic<T>>::Value 
+		Value = TAndValue<TIsBitwiseRelocatable<T>::Value, TNot<TOrValue<__is_enum(T), TIsPointer<T>, TIsArithmetic<T>>>>::Value 
 	};
 };
 
@@ -76,10 +78,7 @@ FORCE_INLINE typename TEnableIf<TUseBitwiseSwap<T>::Value>::Type Swap(T& a, T& b
 {
 	if (&a != &b)
 	{
-		TTypeCompatibleBytes<T> temp;
-		memcpy(&temp, &a,     sizeof(T));
-		memcpy(&a,    &b,     sizeof(T));
-		memcpy(&b,    &temp,  sizeof(T));
+		FPlatformMemory::Memswap(&a, &b, sizeof(T));
 	}
 }
 
@@ -6,6 +6,7 @@
 #include "Runtime/Template/IsArithmetic.h"
 #include "Runtime/Template/TypeTraits.h"
 #include "Runtime/Template/IsTriviallyCopyConstructible.h"
+#include "Runtime/Template/IsTriviallyDestructible.h"
 
 template <typename T>
 struct TIsFunction
@@ -161,6 +162,33 @@ struct TIsBitwiseConstructible<int64, uint64>
 	}; 
 };
 
+/**
+* Whether a T can be moved to a new address with memcpy/memmove, leaving the source as dead memory that
+* is never destructed. Containers owning a heap pointer (TArray, shared pointers) are relocatable even
+* though they are not trivially copyable; specialize this for such types.
+*/
+template <typename T>
+struct TIsBitwiseRelocatable
+{
+	enum
+	{
+		Value =
+			TOr<
+				TIsZeroConstructType<T>,
+				TAnd<
+					TIsTriviallyCopyConstructible<T>,
+					TIsTriviallyDestructible<T>
+				>
+			>::Value
+	};
+};
+
+template <typename T>
+struct TIsBitwiseRelocatable<const T> : TIsBitwiseRelocatable<T>
+{
+
+};
+
 template <typename T, bool TypeIsSmall>
 struct TCallTraitsParamTypeHelper
 {
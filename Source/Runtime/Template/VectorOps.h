@@ -0,0 +1,565 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+#include "Runtime/Math/Math.h"
+#include "Runtime/Template/AreTypesEqual.h"
+#include "Runtime/Template/ChooseClass.h"
+#include "Runtime/Template/EnableIf.h"
+#include "Runtime/Template/IsSigned.h"
+#include "Runtime/Template/RemoveCV.h"
+#include "Runtime/Template/TypeTraits.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+#include <emmintrin.h>
+#endif
+
+/**
+* Search, count, min/max and compaction kernels over contiguous ranges. Element types that are compared bytewise
+* (integers, enums, pointers) or are float/double are processed 16 bytes at a time; everything else falls back to
+* operator== and operator<. TVectorLaneType maps an element type to the lane type the kernels operate on, void meaning
+* "not vectorizable". Integer lanes keep the signedness of the element type (of the underlying type for enums) so
+* the min/max kernels order negative values correctly; pointers use unsigned lanes.
+*
+* The kernels only use SSE2, the x86-64 baseline, so the 64-bit min/max, which has no SSE2 compare, stays scalar.
+* Unlike the memcpy kernels in FPlatformMemory they are not dispatched on CPUID: they are inlined into every container
+* call, where an indirect call would cost more than wider compares gain on the short ranges containers usually hold.
+*/
+namespace Fly3DPrivateVectorOps
+{
+	template <uint32 Size, bool IsSigned>
+	struct TIntOfSize;
+
+	template <> struct TIntOfSize<1, false> { typedef uint8  Type; };
+	template <> struct TIntOfSize<2, false> { typedef uint16 Type; };
+	template <> struct TIntOfSize<4, false> { typedef uint32 Type; };
+	template <> struct TIntOfSize<8, false> { typedef uint64 Type; };
+	template <> struct TIntOfSize<1, true>  { typedef int8   Type; };
+	template <> struct TIntOfSize<2, true>  { typedef int16  Type; };
+	template <> struct TIntOfSize<4, true>  { typedef int32  Type; };
+	template <> struct TIntOfSize<8, true>  { typedef int64  Type; };
+
+	template <typename T, bool IsBytewiseComparable = TTypeTraits<T>::IsBytewiseComparable>
+	struct TVectorLaneTypeImpl
+	{
+		typedef void Type;
+	};
+
+	template <typename T>
+	struct TVectorLaneTypeImpl<T, true>
+	{
+		typedef typename TIntOfSize<sizeof(T), TIsSigned<T>::Value>::Type Type;
+	};
+
+	template <typename T>
+	struct TVectorLaneTypeImpl<T*, true>
+	{
+		typedef typename TIntOfSize<sizeof(T*), false>::Type Type;
+	};
+
+	template <> struct TVectorLaneTypeImpl<float,       true> { typedef float  Type; };
+	template <> struct TVectorLaneTypeImpl<double,      true> { typedef double Type; };
+	template <> struct TVectorLaneTypeImpl<long double, true> { typedef void   Type; };
+}
+
+template <typename T>
+struct TVectorLaneType : public Fly3DPrivateVectorOps::TVectorLaneTypeImpl<typename TRemoveCV<T>::Type>
+{
+
+};
+
+template <typename T>
+struct TIsVectorSearchable
+{
+	enum
+	{
+		Value = PLATFORM_ENABLE_VECTORINTRINSICS && !TIsSame<typename TVectorLaneType<T>::Type, void>::Value
+	};
+};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+
+namespace Fly3DPrivateVectorOps
+{
+	FORCE_INLINE __m128i SelectVector(__m128i mask, __m128i a, __m128i b)
+	{
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+
+	/** Per lane type operations. Masks are _mm_movemask_epi8 results, so every lane owns sizeof(LaneType) bits. */
+	template <typename LaneType>
+	struct TVectorLane;
+
+	template <typename LaneType, typename IntegerOps>
+	struct TIntegerVectorLane
+	{
+		typedef __m128i VectorType;
+
+		enum
+		{
+			HasMinMax = IntegerOps::HasGreater
+		};
+
+		static FORCE_INLINE VectorType Load(const LaneType* data)
+		{
+			return _mm_loadu_si128((const __m128i*)data);
+		}
+
+		static FORCE_INLINE void Store(LaneType* data, VectorType value)
+		{
+			_mm_storeu_si128((__m128i*)data, value);
+		}
+
+		static FORCE_INLINE uint32 EqualMask(VectorType a, VectorType b)
+		{
+			return (uint32)_mm_movemask_epi8(IntegerOps::Equal(a, b));
+		}
+
+		static FORCE_INLINE VectorType Min(VectorType a, VectorType b)
+		{
+			return SelectVector(IntegerOps::Greater(a, b), b, a);
+		}
+
+		static FORCE_INLINE VectorType Max(VectorType a, VectorType b)
+		{
+			return SelectVector(IntegerOps::Greater(a, b), a, b);
+		}
+	};
+
+	struct FInt8Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(int8 value)            { return _mm_set1_epi8((char)value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi8(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_cmpgt_epi8(a, b); }
+	};
+
+	struct FUInt8Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(uint8 value)           { return _mm_set1_epi8((char)value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi8(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b)
+		{
+			const __m128i bias = _mm_set1_epi8((char)0x80);
+			return _mm_cmpgt_epi8(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+		}
+	};
+
+	struct FInt16Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(int16 value)           { return _mm_set1_epi16((short)value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi16(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_cmpgt_epi16(a, b); }
+	};
+
+	struct FUInt16Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(uint16 value)          { return _mm_set1_epi16((short)value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi16(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b)
+		{
+			const __m128i bias = _mm_set1_epi16((short)0x8000);
+			return _mm_cmpgt_epi16(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+		}
+	};
+
+	struct FInt32Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(int32 value)           { return _mm_set1_epi32(value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi32(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_cmpgt_epi32(a, b); }
+	};
+
+	struct FUInt32Ops
+	{
+		enum { HasGreater = true };
+		static FORCE_INLINE __m128i Splat(uint32 value)          { return _mm_set1_epi32((int32)value); }
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)   { return _mm_cmpeq_epi32(a, b); }
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b)
+		{
+			const __m128i bias = _mm_set1_epi32((int32)0x80000000);
+			return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+		}
+	};
+
+	/** SSE2 has no 64-bit compares: equality is built from two 32-bit halves and min/max stay scalar. */
+	struct FInt64Ops
+	{
+		enum { HasGreater = false };
+		static FORCE_INLINE __m128i Splat(uint64 value)
+		{
+			return _mm_set_epi32((int32)(value >> 32), (int32)value, (int32)(value >> 32), (int32)value);
+		}
+		static FORCE_INLINE __m128i Equal(__m128i a, __m128i b)
+		{
+			const __m128i equal32 = _mm_cmpeq_epi32(a, b);
+			return _mm_and_si128(equal32, _mm_shuffle_epi32(equal32, _MM_SHUFFLE(2, 3, 0, 1)));
+		}
+		static FORCE_INLINE __m128i Greater(__m128i a, __m128i b) { return _mm_setzero_si128(); }
+	};
+
+	template <> struct TVectorLane<int8>   : public TIntegerVectorLane<int8,   FInt8Ops>   { static FORCE_INLINE __m128i Splat(int8 value)   { return FInt8Ops::Splat(value); } };
+	template <> struct TVectorLane<uint8>  : public TIntegerVectorLane<uint8,  FUInt8Ops>  { static FORCE_INLINE __m128i Splat(uint8 value)  { return FUInt8Ops::Splat(value); } };
+	template <> struct TVectorLane<int16>  : public TIntegerVectorLane<int16,  FInt16Ops>  { static FORCE_INLINE __m128i Splat(int16 value)  { return FInt16Ops::Splat(value); } };
+	template <> struct TVectorLane<uint16> : public TIntegerVectorLane<uint16, FUInt16Ops> { static FORCE_INLINE __m128i Splat(uint16 value) { return FUInt16Ops::Splat(value); } };
+	template <> struct TVectorLane<int32>  : public TIntegerVectorLane<int32,  FInt32Ops>  { static FORCE_INLINE __m128i Splat(int32 value)  { return FInt32Ops::Splat(value); } };
+	template <> struct TVectorLane<uint32> : public TIntegerVectorLane<uint32, FUInt32Ops> { static FORCE_INLINE __m128i Splat(uint32 value) { return FUInt32Ops::Splat(value); } };
+	template <> struct TVectorLane<int64>  : public TIntegerVectorLane<int64,  FInt64Ops>  { static FORCE_INLINE __m128i Splat(int64 value)  { return FInt64Ops::Splat((uint64)value); } };
+	template <> struct TVectorLane<uint64> : public TIntegerVectorLane<uint64, FInt64Ops>  { static FORCE_INLINE __m128i Splat(uint64 value) { return FInt64Ops::Splat(value); } };
+
+	template <>
+	struct TVectorLane<float>
+	{
+		typedef __m128 VectorType;
+
+		enum
+		{
+			HasMinMax = true
+		};
+
+		static FORCE_INLINE VectorType Splat(float value)                 { return _mm_set1_ps(value); }
+		static FORCE_INLINE VectorType Load(const float* data)            { return _mm_loadu_ps(data); }
+		static FORCE_INLINE void       Store(float* data, VectorType value) { _mm_storeu_ps(data, value); }
+		static FORCE_INLINE uint32     EqualMask(VectorType a, VectorType b) { return (uint32)_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))); }
+		static FORCE_INLINE VectorType Min(VectorType a, VectorType b)    { return _mm_min_ps(a, b); }
+		static FORCE_INLINE VectorType Max(VectorType a, VectorType b)    { return _mm_max_ps(a, b); }
+	};
+
+	template <>
+	struct TVectorLane<double>
+	{
+		typedef __m128d VectorType;
+
+		enum
+		{
+			HasMinMax = true
+		};
+
+		static FORCE_INLINE VectorType Splat(double value)                 { return _mm_set1_pd(value); }
+		static FORCE_INLINE VectorType Load(const double* data)            { return _mm_loadu_pd(data); }
+		static FORCE_INLINE void       Store(double* data, VectorType value) { _mm_storeu_pd(data, value); }
+		static FORCE_INLINE uint32     EqualMask(VectorType a, VectorType b) { return (uint32)_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))); }
+		static FORCE_INLINE VectorType Min(VectorType a, VectorType b)     { return _mm_min_pd(a, b); }
+		static FORCE_INLINE VectorType Max(VectorType a, VectorType b)     { return _mm_max_pd(a, b); }
+	};
+
+	template <typename LaneType, typename SizeType>
+	SizeType Find(const LaneType* data, SizeType count, LaneType value)
+	{
+		typedef TVectorLane<LaneType> FLane;
+
+		const SizeType numLanes = (SizeType)(16 / sizeof(LaneType));
+		const typename FLane::VectorType splat = FLane::Splat(value);
+
+		SizeType index = 0;
+		for (; index + numLanes * 4 <= count; index += numLanes * 4)
+		{
+			const uint32 mask0 = FLane::EqualMask(FLane::Load(data + index), splat);
+			const uint32 mask1 = FLane::EqualMask(FLane::Load(data + index + numLanes), splat);
+			const uint32 mask2 = FLane::EqualMask(FLane::Load(data + index + numLanes * 2), splat);
+			const uint32 mask3 = FLane::EqualMask(FLane::Load(data + index + numLanes * 3), splat);
+
+			const uint64 mask = (uint64)(mask0 | (mask1 << 16)) | ((uint64)(mask2 | (mask3 << 16)) << 32);
+			if (mask)
+			{
+				const uint32 lowMask = (uint32)mask;
+				const uint32 bit     = lowMask ? FMath::CountTrailingZeros(lowMask) : 32 + FMath::CountTrailingZeros((uint32)(mask >> 32));
+				return index + (SizeType)(bit / sizeof(LaneType));
+			}
+		}
+
+		for (; index + numLanes <= count; index += numLanes)
+		{
+			const uint32 mask = FLane::EqualMask(FLane::Load(data + index), splat);
+			if (mask)
+			{
+				return index + (SizeType)(FMath::CountTrailingZeros(mask) / sizeof(LaneType));
+			}
+		}
+
+		for (; index < count; ++index)
+		{
+			if (data[index] == value)
+			{
+				return index;
+			}
+		}
+
+		return (SizeType)-1;
+	}
+
+	template <typename LaneType, typename SizeType>
+	SizeType FindLast(const LaneType* data, SizeType count, LaneType value)
+	{
+		typedef TVectorLane<LaneType> FLane;
+
+		const SizeType numLanes = (SizeType)(16 / sizeof(LaneType));
+		const typename FLane::VectorType splat = FLane::Splat(value);
+
+		SizeType index = count;
+		for (; index >= numLanes; index -= numLanes)
+		{
+			const uint32 mask = FLane::EqualMask(FLane::Load(data + index - numLanes), splat);
+			if (mask)
+			{
+				return index - numLanes + (SizeType)((31 - FMath::CountLeadingZeros(mask)) / sizeof(LaneType));
+			}
+		}
+
+		while (index > 0)
+		{
+			--index;
+			if (data[index] == value)
+			{
+				return index;
+			}
+		}
+
+		return (SizeType)-1;
+	}
+
+	template <typename LaneType, typename SizeType>
+	SizeType Count(const LaneType* data, SizeType count, LaneType value)
+	{
+		typedef TVectorLane<LaneType> FLane;
+
+		const SizeType numLanes = (SizeType)(16 / sizeof(LaneType));
+		const typename FLane::VectorType splat = FLane::Splat(value);
+
+		SizeType result = 0;
+		SizeType index  = 0;
+		for (; index + numLanes <= count; index += numLanes)
+		{
+			result += (SizeType)(FMath::CountBits(FLane::EqualMask(FLane::Load(data + index), splat)) / sizeof(LaneType));
+		}
+
+		for (; index < count; ++index)
+		{
+			result += data[index] == value ? 1 : 0;
+		}
+
+		return result;
+	}
+
+	template <bool IsMin, typename LaneType, typename SizeType>
+	typename TEnableIf<TVectorLane<LaneType>::HasMinMax, LaneType>::Type Reduce(const LaneType* data, SizeType count)
+	{
+		typedef TVectorLane<LaneType> FLane;
+
+		const SizeType numLanes = (SizeType)(16 / sizeof(LaneType));
+
+		LaneType result = data[0];
+		SizeType index  = 0;
+		if (count >= numLanes)
+		{
+			typename FLane::VectorType accumulator = FLane::Load(data);
+			for (index = numLanes; index + numLanes <= count; index += numLanes)
+			{
+				const typename FLane::VectorType value = FLane::Load(data + index);
+				accumulator = IsMin ? FLane::Min(accumulator, value) : FLane::Max(accumulator, value);
+			}
+
+			LaneType lanes[16 / sizeof(LaneType)];
+			FLane::Store(lanes, accumulator);
+
+			result = lanes[0];
+			for (SizeType lane = 1; lane < numLanes; ++lane)
+			{
+				result = IsMin ? FMath::Min(result, lanes[lane]) : FMath::Max(result, lanes[lane]);
+			}
+		}
+
+		for (; index < count; ++index)
+		{
+			result = IsMin ? FMath::Min(result, data[index]) : FMath::Max(result, data[index]);
+		}
+
+		return result;
+	}
+
+	template <bool IsMin, typename LaneType, typename SizeType>
+	typename TEnableIf<!TVectorLane<LaneType>::HasMinMax, LaneType>::Type Reduce(const LaneType* data, SizeType count)
+	{
+		LaneType result = data[0];
+		for (SizeType index = 1; index < count; ++index)
+		{
+			result = IsMin ? FMath::Min(result, data[index]) : FMath::Max(result, data[index]);
+		}
+
+		return result;
+	}
+
+	/** Stable compaction: whole blocks without a match are stored in one go, only mixed blocks are split per lane. */
+	template <typename LaneType, typename SizeType>
+	SizeType Remove(LaneType* data, SizeType count, LaneType value)
+	{
+		typedef TVectorLane<LaneType> FLane;
+
+		const SizeType numLanes = (SizeType)(16 / sizeof(LaneType));
+		const uint32   fullMask = 0xFFFF;
+		const typename FLane::VectorType splat = FLane::Splat(value);
+
+		SizeType writeIndex = 0;
+		SizeType readIndex  = 0;
+		for (; readIndex + numLanes <= count; readIndex += numLanes)
+		{
+			const typename FLane::VectorType block = FLane::Load(data + readIndex);
+			const uint32 mask = FLane::EqualMask(block, splat);
+
+			if (mask == 0)
+			{
+				if (writeIndex != readIndex)
+				{
+					FLane::Store(data + writeIndex, block);
+				}
+				writeIndex += numLanes;
+			}
+			else if (mask != fullMask)
+			{
+				for (SizeType lane = 0; lane < numLanes; ++lane)
+				{
+					if ((mask & (1u << (lane * sizeof(LaneType)))) == 0)
+					{
+						data[writeIndex++] = data[readIndex + lane];
+					}
+				}
+			}
+		}
+
+		for (; readIndex < count; ++readIndex)
+		{
+			if (!(data[readIndex] == value))
+			{
+				data[writeIndex++] = data[readIndex];
+			}
+		}
+
+		return writeIndex;
+	}
+}
+
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<ElementType>::Value, SizeType>::Type FindItem(const ElementType* data, SizeType count, const ElementType& item)
+{
+	for (SizeType index = 0; index < count; ++index)
+	{
+		if (data[index] == item)
+		{
+			return index;
+		}
+	}
+
+	return (SizeType)-1;
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<ElementType>::Value, SizeType>::Type FindLastItem(const ElementType* data, SizeType count, const ElementType& item)
+{
+	for (SizeType index = count - 1; index >= 0; --index)
+	{
+		if (data[index] == item)
+		{
+			return index;
+		}
+	}
+
+	return (SizeType)-1;
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<ElementType>::Value, SizeType>::Type CountItems(const ElementType* data, SizeType count, const ElementType& item)
+{
+	SizeType result = 0;
+	for (SizeType index = 0; index < count; ++index)
+	{
+		if (data[index] == item)
+		{
+			++result;
+		}
+	}
+
+	return result;
+}
+
+/** Returns the smallest element. The range must not be empty. */
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<ElementType>::Value, ElementType>::Type MinOfItems(const ElementType* data, SizeType count)
+{
+	typename TRemoveCV<ElementType>::Type result = data[0];
+	for (SizeType index = 1; index < count; ++index)
+	{
+		result = FMath::Min(result, data[index]);
+	}
+
+	return result;
+}
+
+/** Returns the largest element. The range must not be empty. */
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<!TIsVectorSearchable<ElementType>::Value, ElementType>::Type MaxOfItems(const ElementType* data, SizeType count)
+{
+	typename TRemoveCV<ElementType>::Type result = data[0];
+	for (SizeType index = 1; index < count; ++index)
+	{
+		result = FMath::Max(result, data[index]);
+	}
+
+	return result;
+}
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, SizeType>::Type FindItem(const ElementType* data, SizeType count, const ElementType& item)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	return Fly3DPrivateVectorOps::Find((const LaneType*)data, count, *(const LaneType*)&item);
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, SizeType>::Type FindLastItem(const ElementType* data, SizeType count, const ElementType& item)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	return Fly3DPrivateVectorOps::FindLast((const LaneType*)data, count, *(const LaneType*)&item);
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, SizeType>::Type CountItems(const ElementType* data, SizeType count, const ElementType& item)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	return Fly3DPrivateVectorOps::Count((const LaneType*)data, count, *(const LaneType*)&item);
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, ElementType>::Type MinOfItems(const ElementType* data, SizeType count)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	const LaneType result = Fly3DPrivateVectorOps::Reduce<true>((const LaneType*)data, count);
+	return *(const ElementType*)&result;
+}
+
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, ElementType>::Type MaxOfItems(const ElementType* data, SizeType count)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	const LaneType result = Fly3DPrivateVectorOps::Reduce<false>((const LaneType*)data, count);
+	return *(const ElementType*)&result;
+}
+
+/**
+* Removes every element equal to item, keeping the order of the others, and returns the new count.
+* Only available for vector searchable types, which are trivially destructible.
+*/
+template <typename ElementType, typename SizeType>
+FORCE_INLINE typename TEnableIf<TIsVectorSearchable<ElementType>::Value, SizeType>::Type RemoveItems(ElementType* data, SizeType count, const ElementType& item)
+{
+	typedef typename TVectorLaneType<ElementType>::Type LaneType;
+	return Fly3DPrivateVectorOps::Remove((LaneType*)data, count, *(const LaneType*)&item);
+}
+
+#endif // PLATFORM_ENABLE_VECTORINTRINSICS
@@ -1,8 +1,7 @@
 ﻿#pragma once
 
 #include "Runtime/Platform/Platform.h"
-
-#include <string>
+#include "Runtime/Core/String/FlyString.h"
 
 enum class EWindowMode
 {
@@ -158,7 +157,7 @@ struct FWindowDefinition
 	bool					shouldPreserveAspectRatio = true;
 	
 	/** the title of the window */
-	std::wstring			title = L"Wiindow";
+	FString					title = TEXT("Wiindow");
 	/** opacity of the window (0-1) */
 	float					opacity = 1.0f;
 	/** radius of the corner rounding */
@@ -226,6 +226,8 @@ int64 FWindowsApplication::ProcessMessage(HWND hwnd, uint32 msg, WPARAM wParam,
 		}
 		case WM_SIZE:
 		{
+			// The engine loop drops to its idle frame rate while minimized.
+			Globals::Minimized = wParam == SIZE_MINIMIZED;
 			break;
 		}
 		default:
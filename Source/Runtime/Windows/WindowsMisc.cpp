@@ -56,7 +56,7 @@ FLinearColor FWindowsMisc::GetScreenPixelColor(const FVector2D& inScreenPos, flo
 	return FLinearColor(FColor32(r, g, b, a));
 }
 
-bool FWindowsMisc::GetWindowTitleMatchingText(const WIDECHAR* titleStartsWith, std::wstring& outTitle)
+bool FWindowsMisc::GetWindowTitleMatchingText(const WIDECHAR* titleStartsWith, FString& outTitle)
 {
 	WIDECHAR buffer[8192];
 
@@ -111,7 +111,7 @@ void FWindowsMisc::ClipboardCopy(const WIDECHAR* str)
 	}
 }
 
-void FWindowsMisc::ClipboardPaste(std::wstring& dest)
+void FWindowsMisc::ClipboardPaste(FString& dest)
 {
 	if (OpenClipboard(GetActiveWindow()))
 	{
@@ -125,7 +125,7 @@ void FWindowsMisc::ClipboardPaste(std::wstring& dest)
 
 		if (!globalMem)
 		{
-			dest = L"";
+			dest.Empty();
 		}
 		else
 		{
@@ -136,11 +136,13 @@ void FWindowsMisc::ClipboardPaste(std::wstring& dest)
 			}
 			else
 			{
-				ANSICHAR* ach = (ANSICHAR*)data;
-				dest.resize(strlen(ach));
-				for (int32 i = 0; i < dest.size(); ++i)
+				const ANSICHAR* ach = (const ANSICHAR*)data;
+				const int32 len = (int32)strlen(ach);
+
+				dest.Empty(len);
+				for (int32 i = 0; i < len; ++i)
 				{
-					dest[i] = ach[i];
+					dest.AppendChar((uint8)ach[i]);
 				}
 			}
 			GlobalUnlock(globalMem);
@@ -148,6 +150,6 @@ void FWindowsMisc::ClipboardPaste(std::wstring& dest)
 	}
 	else 
 	{
-		dest = L"";
+		dest.Empty();
 	}
 }
\ No newline at end of file
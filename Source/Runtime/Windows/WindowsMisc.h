@@ -3,8 +3,7 @@
 #include "Runtime/Platform/Platform.h"
 #include "Runtime/Math/Vector2D.h"
 #include "Runtime/Math/Color.h"
-
-#include <string>
+#include "Runtime/Core/String/FlyString.h"
 
 struct FWindowsMisc
 {
@@ -13,9 +12,9 @@ struct FWindowsMisc
 	static int32 GetAppIcon();
 	static void PreventScreenSaver();
 	static FLinearColor GetScreenPixelColor(const FVector2D& inScreenPos, float inGamma = 1.0f);
-	static bool GetWindowTitleMatchingText(const WIDECHAR* titleStartsWith, std::wstring& outTitle);
+	static bool GetWindowTitleMatchingText(const WIDECHAR* titleStartsWith, FString& outTitle);
 	static float GetDPIScaleFactorAtPoint(int32 x, int32 y);
 	static void ClipboardCopy(const WIDECHAR* str);
-	static void ClipboardPaste(std::wstring& dest);
+	static void ClipboardPaste(FString& dest);
 	static void GetDesktopResolution(int32& outWidth, int32& outHeight);
 };
\ No newline at end of file
@@ -130,7 +130,7 @@ void FWindowsWindow::Initialize(const std::shared_ptr<FWindowDefinition>& inDefi
 	m_HWnd = CreateWindowEx(
 		windowExStyle,
 		AppWindowClass,
-		inDefinition->title.c_str(),
+		*inDefinition->title,
 		windowStyle,
 		windowX, 
 		windowY, 
@@ -0,0 +1,53 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/ChunkedArray.h"
+
+IMPLEMENT_TEST(ChunkedArrayStableAddresses)
+{
+	typedef TChunkedArray<int32, 256> FArrayType;
+
+	FArrayType array;
+	TEST_CHECK(array.IsEmpty());
+
+	TArray<int32*> addresses;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		array.Add(i);
+		addresses.Add(&array[i]);
+	}
+
+	TEST_CHECK(array.Num() == 1000);
+	TEST_CHECK(array.NumChunks() == (1000 + FArrayType::NumElementsPerChunk - 1) / FArrayType::NumElementsPerChunk);
+
+	// Growth appends chunks, so the addresses taken while filling still point at the same elements.
+	bool stable = true;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		stable &= addresses[i] == &array[i] && *addresses[i] == i;
+	}
+	TEST_CHECK(stable);
+
+	int32 expected = 0;
+	bool ordered = true;
+	for (int32 value : array)
+	{
+		ordered &= value == expected++;
+	}
+	TEST_CHECK(ordered && expected == 1000);
+
+	int32 numInChunks = 0;
+	for (int32 chunkIndex = 0; chunkIndex < array.NumChunks(); ++chunkIndex)
+	{
+		numInChunks += array.GetChunk(chunkIndex).Num();
+	}
+	TEST_CHECK(numInChunks == 1000);
+
+	array.RemoveLast(500);
+	TEST_CHECK(array.Num() == 500 && array.Last() == 499);
+	TEST_CHECK(&array[0] == addresses[0]);
+
+	FArrayType copy(array);
+	TEST_CHECK(copy.Num() == 500 && copy[499] == 499 && &copy[0] != &array[0]);
+
+	array.Empty();
+	TEST_CHECK(array.Num() == 0 && array.NumChunks() == 0);
+}
\ No newline at end of file
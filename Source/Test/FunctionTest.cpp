@@ -0,0 +1,146 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Template/Function.h"
+
+namespace Fly3DPrivateFunctionTest
+{
+	static int32 g_NumLive = 0;
+
+	/** Returns its own address when called, and points at itself so a bitwise move would be noticed. */
+	template <uint32 PaddingSize>
+	struct TTrackedFunctor
+	{
+		TTrackedFunctor* m_Self;
+		int32            m_Value;
+		uint8            m_Padding[PaddingSize];
+
+		explicit TTrackedFunctor(int32 value)
+			: m_Self(this)
+			, m_Value(value)
+		{
+			++g_NumLive;
+		}
+
+		TTrackedFunctor(const TTrackedFunctor& other)
+			: m_Self(this)
+			, m_Value(other.m_Value)
+		{
+			++g_NumLive;
+		}
+
+		TTrackedFunctor(TTrackedFunctor&& other)
+			: m_Self(this)
+			, m_Value(other.m_Value)
+		{
+			other.m_Value = -1;
+			++g_NumLive;
+		}
+
+		~TTrackedFunctor()
+		{
+			--g_NumLive;
+		}
+
+		const TTrackedFunctor* operator()() const
+		{
+			return this;
+		}
+	};
+
+	typedef TTrackedFunctor<4>  FSmallFunctor;
+	typedef TTrackedFunctor<64> FLargeFunctor;
+
+	template <typename FunctionType>
+	static bool IsStoredInline(const FunctionType& func)
+	{
+		const uint8* functor = (const uint8*)func();
+		return functor >= (const uint8*)&func && functor + sizeof(*func()) <= (const uint8*)&func + sizeof(FunctionType);
+	}
+
+	template <typename FunctionType>
+	static bool HasValue(const FunctionType& func, int32 value)
+	{
+		const auto* functor = func();
+		return functor->m_Self == functor && functor->m_Value == value;
+	}
+}
+
+IMPLEMENT_TEST(FunctionInlineStorage)
+{
+	using namespace Fly3DPrivateFunctionTest;
+
+	typedef TFunction<const FSmallFunctor*()> FSmallFunction;
+	typedef TFunction<const FLargeFunctor*()> FLargeFunction;
+
+	{
+		FSmallFunction small = FSmallFunctor(1);
+		FLargeFunction large = FLargeFunctor(2);
+
+		TEST_CHECK(IsStoredInline(small));
+		TEST_CHECK(!IsStoredInline(large));
+		TEST_CHECK(HasValue(small, 1) && HasValue(large, 2));
+		TEST_CHECK(g_NumLive == 2);
+
+		// Moving an inline functor has to run its move constructor in the new storage.
+		FSmallFunction movedSmall = MoveTemp(small);
+		TEST_CHECK(!small && movedSmall);
+		TEST_CHECK(IsStoredInline(movedSmall));
+		TEST_CHECK(HasValue(movedSmall, 1));
+
+		FLargeFunction movedLarge = MoveTemp(large);
+		TEST_CHECK(!large && HasValue(movedLarge, 2));
+		TEST_CHECK(g_NumLive == 2);
+
+		FSmallFunction copiedSmall = movedSmall;
+		TEST_CHECK(HasValue(copiedSmall, 1) && movedSmall() != copiedSmall());
+		TEST_CHECK(g_NumLive == 3);
+
+		copiedSmall = FSmallFunctor(3);
+		TEST_CHECK(HasValue(copiedSmall, 3));
+		TEST_CHECK(g_NumLive == 3);
+
+		copiedSmall = MoveTemp(movedSmall);
+		TEST_CHECK(HasValue(copiedSmall, 1) && !movedSmall);
+		TEST_CHECK(g_NumLive == 2);
+
+		copiedSmall = nullptr;
+		TEST_CHECK(!copiedSmall && g_NumLive == 1);
+	}
+
+	TEST_CHECK(g_NumLive == 0);
+}
+
+IMPLEMENT_TEST(UniqueFunctionInlineStorage)
+{
+	using namespace Fly3DPrivateFunctionTest;
+
+	typedef TUniqueFunction<const FSmallFunctor*()> FSmallFunction;
+
+	{
+		TArray<FSmallFunction> functions;
+		for (int32 i = 0; i < 100; ++i)
+		{
+			functions.Add(FSmallFunctor(i));
+		}
+
+		// Array growth relocates every function, each one keeps a valid inline functor.
+		bool intact = true;
+		for (int32 i = 0; i < 100; ++i)
+		{
+			intact &= IsStoredInline(functions[i]) && HasValue(functions[i], i);
+		}
+		TEST_CHECK(intact);
+		TEST_CHECK(g_NumLive == 100);
+
+		functions.RemoveAt(0, 50);
+		TEST_CHECK(g_NumLive == 50 && HasValue(functions[0], 50));
+
+		int32 calls = 0;
+		TUniqueFunction<void()> lambda = [&calls]() { ++calls; };
+		TUniqueFunction<void()> movedLambda = MoveTemp(lambda);
+		movedLambda();
+		TEST_CHECK(calls == 1);
+	}
+
+	TEST_CHECK(g_NumLive == 0);
+}
\ No newline at end of file
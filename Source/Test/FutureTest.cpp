@@ -0,0 +1,241 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Jobs/Future.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#include <thread>
+
+namespace Fly3DPrivateFutureTest
+{
+	enum
+	{
+		NUM_WORKERS     = 3,
+		NUM_FUTURES     = 8,
+		NUM_ASYNC_JOBS  = 256,
+		NUM_RACE_ROUNDS = 2000,
+	};
+}
+
+IMPLEMENT_TEST(FuturePromise)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	TFuture<int32> empty;
+	TEST_CHECK(!empty.IsValid());
+	TEST_CHECK(!empty.IsReady());
+
+	TPromise<int32> promise;
+	TFuture<int32>  future = promise.GetFuture();
+	TEST_CHECK(future.IsValid());
+	TEST_CHECK(!future.IsReady());
+
+	promise.SetValue(42);
+	TEST_CHECK(future.IsReady());
+	TEST_CHECK(future.Get() == 42);
+
+	// Moving the future moves the shared state with it.
+	TFuture<int32> moved(MoveTemp(future));
+	TEST_CHECK(!future.IsValid());
+	TEST_CHECK(moved.IsReady() && moved.Get() == 42);
+
+	// A thread outside the job system sleeps until another thread sets the result.
+	TPromise<void> voidPromise;
+	TFuture<void>  voidFuture = voidPromise.GetFuture();
+
+	std::thread setter([&voidPromise]() { voidPromise.SetValue(); });
+	voidFuture.Get();
+	setter.join();
+
+	TEST_CHECK(voidFuture.IsReady());
+}
+
+IMPLEMENT_TEST(FutureThen)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	// A chain set up before the result is set runs once it is, Then consumes the future it is called on.
+	TPromise<int32> promise;
+	TFuture<int32>  first   = promise.GetFuture();
+	TFuture<int32>  doubled = first.Then([](int32 value) { return value * 2; });
+	TEST_CHECK(!first.IsValid());
+
+	volatile int32 seen     = 0;
+	TFuture<void>  finished = doubled.Then([&seen](int32 value) { FPlatformAtomics::AtomicStore(&seen, value); });
+	TEST_CHECK(!finished.IsReady());
+
+	promise.SetValue(21);
+	finished.Get();
+	TEST_CHECK(seen == 42);
+
+	// A future that is ready already queues the continuation right away.
+	TPromise<int32> readyPromise;
+	readyPromise.SetValue(5);
+	TFuture<int32> plusOne = readyPromise.GetFuture().Then([](int32 value) { return value + 1; });
+	TEST_CHECK(plusOne.Get() == 6);
+
+	// void results chain into continuations that take no argument.
+	TPromise<void> voidPromise;
+	TFuture<int32> fromVoid = voidPromise.GetFuture().Then([]() { return 7; });
+	voidPromise.SetValue();
+	TEST_CHECK(fromVoid.Get() == 7);
+
+	FJobSystem::Shutdown();
+}
+
+IMPLEMENT_TEST(FutureAsync)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	TArray<TFuture<int32>> futures;
+	for (int32 i = 0; i < NUM_ASYNC_JOBS; ++i)
+	{
+		futures.Add(Async([i]() { return i * i; }));
+	}
+
+	bool allResults = true;
+	for (int32 i = 0; i < NUM_ASYNC_JOBS; ++i)
+	{
+		allResults &= futures[i].Get() == i * i;
+	}
+	TEST_CHECK(allResults);
+
+	volatile int32 numRuns = 0;
+	TFuture<void>  voidFuture = Async([&numRuns]() { FPlatformAtomics::InterlockedIncrement(&numRuns); });
+	voidFuture.Get();
+	TEST_CHECK(numRuns == 1);
+
+	FJobSystem::Shutdown();
+}
+
+IMPLEMENT_TEST(FutureWhenAll)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	TArray<TFuture<int32>> none;
+	TEST_CHECK(WhenAll(none).IsReady());
+
+	TArray<TPromise<int32>> promises;
+	TArray<TFuture<int32>>  futures;
+	for (int32 i = 0; i < NUM_FUTURES; ++i)
+	{
+		promises.Emplace();
+		futures.Add(promises[i].GetFuture());
+	}
+
+	TFuture<void> all = WhenAll(futures);
+
+	bool readyTooEarly = false;
+	for (int32 i = NUM_FUTURES - 1; i >= 0; --i)
+	{
+		readyTooEarly |= all.IsReady();
+		promises[i].SetValue(i + 100);
+	}
+	all.Get();
+	TEST_CHECK(!readyTooEarly);
+
+	// The futures stay valid and keep their results.
+	bool allResults = true;
+	for (int32 i = 0; i < NUM_FUTURES; ++i)
+	{
+		allResults &= futures[i].IsReady() && futures[i].Get() == i + 100;
+	}
+	TEST_CHECK(allResults);
+
+	FJobSystem::Shutdown();
+}
+
+IMPLEMENT_TEST(FutureWhenAny)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	TArray<TPromise<int32>> promises;
+	TArray<TFuture<int32>>  futures;
+	for (int32 i = 0; i < NUM_FUTURES; ++i)
+	{
+		promises.Emplace();
+		futures.Add(promises[i].GetFuture());
+	}
+
+	TFuture<int32> any = WhenAny(futures);
+	TEST_CHECK(!any.IsReady());
+
+	promises[3].SetValue(3);
+	TEST_CHECK(any.Get() == 3);
+
+	// Later results do not change the first one.
+	for (int32 i = 0; i < NUM_FUTURES; ++i)
+	{
+		if (i != 3)
+		{
+			promises[i].SetValue(i);
+		}
+	}
+	TEST_CHECK(any.Get() == 3);
+
+	// A future that is ready already wins right away.
+	TArray<TPromise<int32>> readyPromises;
+	TArray<TFuture<int32>>  readyFutures;
+	for (int32 i = 0; i < 2; ++i)
+	{
+		readyPromises.Emplace();
+		readyFutures.Add(readyPromises[i].GetFuture());
+	}
+	readyPromises[1].SetValue(1);
+
+	TFuture<int32> readyAny = WhenAny(readyFutures);
+	TEST_CHECK(readyAny.Get() == 1);
+	readyPromises[0].SetValue(0);
+
+	FJobSystem::Shutdown();
+}
+
+IMPLEMENT_TEST(FutureThenRacesSetValue)
+{
+	using namespace Fly3DPrivateFutureTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	// Then and SetValue race on every round, the continuation has to run exactly once whichever wins.
+	volatile int32 numRuns    = 0;
+	bool           allResults = true;
+
+	for (int32 round = 0; round < NUM_RACE_ROUNDS; ++round)
+	{
+		TPromise<int32> promise;
+		TFuture<int32>  future = promise.GetFuture();
+
+		volatile int32 isStarted = 0;
+		std::thread setter([&promise, &isStarted, round]()
+		{
+			while (!FPlatformAtomics::AtomicRead(&isStarted, EMemoryOrder::Acquire))
+			{
+				FPlatformAtomics::Pause();
+			}
+			promise.SetValue(round);
+		});
+
+		FPlatformAtomics::AtomicStore(&isStarted, 1, EMemoryOrder::Release);
+		TFuture<int32> next = future.Then([&numRuns](int32 value)
+		{
+			FPlatformAtomics::InterlockedIncrement(&numRuns);
+			return value;
+		});
+
+		allResults &= next.Get() == round;
+		setter.join();
+	}
+
+	FJobSystem::Shutdown();
+
+	TEST_CHECK(allResults);
+	TEST_CHECK(numRuns == NUM_RACE_ROUNDS);
+}
\ No newline at end of file
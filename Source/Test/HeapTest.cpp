@@ -0,0 +1,98 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/PriorityQueue.h"
+#include "Runtime/Template/Greater.h"
+
+namespace Fly3DPrivateHeapTest
+{
+	static uint32 NextRandom(uint32& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+}
+
+IMPLEMENT_TEST(HeapPushPop)
+{
+	using namespace Fly3DPrivateHeapTest;
+
+	uint32 state = 1;
+	TArray<int32> heap;
+
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		heap.HeapPush((int32)(NextRandom(state) % 100));
+	}
+
+	TEST_CHECK(heap.IsHeap(TLess<int32>()));
+
+	// Every pop returns the smallest remaining element, the last one leaves the array empty.
+	int32 previous = -1;
+	while (heap.Num() > 0)
+	{
+		int32 item;
+		heap.HeapPop(item);
+		TEST_CHECK(item >= previous);
+		previous = item;
+	}
+
+	TEST_CHECK(heap.Num() == 0);
+
+	heap.HeapPush(7);
+	heap.HeapPopDiscard();
+	TEST_CHECK(heap.Num() == 0);
+
+	TArray<int32> values;
+	for (int32 i = 0; i < 100; ++i)
+	{
+		values.Add(i);
+	}
+
+	values.Heapify(TGreater<int32>());
+	TEST_CHECK(values.IsHeap(TGreater<int32>()));
+	TEST_CHECK(values.HeapTop() == 99);
+
+	values.HeapRemoveAt(10, TGreater<int32>());
+	TEST_CHECK(values.Num() == 99 && values.IsHeap(TGreater<int32>()));
+}
+
+IMPLEMENT_TEST(PriorityQueue)
+{
+	using namespace Fly3DPrivateHeapTest;
+
+	TPriorityQueue<int32, TLess<int32>, 4> queue;
+
+	int32 item = 0;
+	TEST_CHECK(queue.IsEmpty());
+	TEST_CHECK(!queue.Pop(item));
+
+	uint32 state = 7;
+	for (int32 i = 0; i < 500; ++i)
+	{
+		queue.Push((int32)(NextRandom(state) % 1000));
+	}
+
+	queue.RemoveAt(3);
+	TEST_CHECK(queue.Num() == 499);
+
+	int32 previous = -1;
+	while (queue.Pop(item))
+	{
+		TEST_CHECK(item >= previous);
+		previous = item;
+	}
+
+	TEST_CHECK(queue.IsEmpty());
+
+	TArray<int32> elements;
+	elements.Add(5);
+	elements.Add(1);
+	elements.Add(9);
+
+	TPriorityQueue<int32, TGreater<int32>> maxQueue(elements, TGreater<int32>());
+	TEST_CHECK(maxQueue.Top() == 9);
+	TEST_CHECK(maxQueue.Pop() == 9);
+	TEST_CHECK(maxQueue.Pop() == 5);
+	TEST_CHECK(maxQueue.Pop() == 1);
+	TEST_CHECK(maxQueue.IsEmpty());
+}
\ No newline at end of file
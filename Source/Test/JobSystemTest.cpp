@@ -0,0 +1,114 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Jobs/JobSystem.h"
+#include "Runtime/Core/Jobs/ParallelFor.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+namespace Fly3DPrivateJobSystemTest
+{
+	enum
+	{
+		NUM_WORKERS       = 3,
+		NUM_OUTER_JOBS    = 16,
+		NUM_INNER_JOBS    = 64,
+	};
+
+	/** Runs ParallelFor over num indices and checks that every one of them was visited exactly once. */
+	static bool VisitsEachIndexOnce(int32 num, int32 minBatchSize)
+	{
+		TArray<int32> visits;
+		visits.AddZeroed(num > 0 ? num : 1);
+
+		int32* data = visits.GetData();
+		ParallelFor(num, [data](int32 index)
+		{
+			FPlatformAtomics::InterlockedIncrement(&data[index]);
+		}, minBatchSize);
+
+		for (int32 i = 0; i < num; ++i)
+		{
+			if (visits[i] != 1)
+			{
+				return false;
+			}
+		}
+
+		return num > 0 || visits[0] == 0;
+	}
+}
+
+IMPLEMENT_TEST(ParallelForEachIndexOnce)
+{
+	using namespace Fly3DPrivateJobSystemTest;
+
+	const int32 counts[]     = { 0, 1, 2, 7, 63, 64, 65, 1000, 4099 };
+	const int32 batchSizes[] = { 1, 3, 16, 64 };
+
+	// Without the job system ParallelFor runs inline, with it the batches spread over the workers.
+	bool inlineOnce = true;
+	for (int32 c = 0; c < (int32)(sizeof(counts) / sizeof(counts[0])); ++c)
+	{
+		inlineOnce &= VisitsEachIndexOnce(counts[c], 1);
+	}
+	TEST_CHECK(inlineOnce);
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	bool parallelOnce = true;
+	for (int32 c = 0; c < (int32)(sizeof(counts) / sizeof(counts[0])); ++c)
+	{
+		for (int32 b = 0; b < (int32)(sizeof(batchSizes) / sizeof(batchSizes[0])); ++b)
+		{
+			parallelOnce &= VisitsEachIndexOnce(counts[c], batchSizes[b]);
+		}
+	}
+	TEST_CHECK(parallelOnce);
+
+	FJobSystem::Shutdown();
+}
+
+IMPLEMENT_TEST(JobSystemNestedRun)
+{
+	using namespace Fly3DPrivateJobSystemTest;
+
+	FJobSystem::Startup(NUM_WORKERS);
+
+	volatile int32 numInnerRuns = 0;
+	volatile int32 numOuterDone = 0;
+
+	// Every outer job queues its own sub-jobs and waits for them from inside the job.
+	FJobCounter outerCounter;
+	for (int32 i = 0; i < NUM_OUTER_JOBS; ++i)
+	{
+		FJobSystem::Run([&]()
+		{
+			FJobCounter innerCounter;
+			for (int32 j = 0; j < NUM_INNER_JOBS; ++j)
+			{
+				FJobSystem::Run([&]() { FPlatformAtomics::InterlockedIncrement(&numInnerRuns); }, &innerCounter);
+			}
+
+			FJobSystem::Wait(innerCounter);
+			FPlatformAtomics::InterlockedIncrement(&numOuterDone);
+		}, &outerCounter);
+	}
+
+	FJobSystem::Wait(outerCounter);
+
+	TEST_CHECK(outerCounter.IsDone());
+	TEST_CHECK(numOuterDone == NUM_OUTER_JOBS);
+	TEST_CHECK(numInnerRuns == NUM_OUTER_JOBS * NUM_INNER_JOBS);
+
+	// ParallelFor from inside a job runs on the job system as well.
+	volatile int32 numNestedVisits = 0;
+	FJobCounter parallelCounter;
+	FJobSystem::Run([&]()
+	{
+		ParallelFor(1000, [&](int32) { FPlatformAtomics::InterlockedIncrement(&numNestedVisits); }, 8);
+	}, &parallelCounter);
+
+	FJobSystem::Wait(parallelCounter);
+	TEST_CHECK(numNestedVisits == 1000);
+
+	FJobSystem::Shutdown();
+}
\ No newline at end of file
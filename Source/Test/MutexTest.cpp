@@ -0,0 +1,270 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/HAL/Event.h"
+#include "Runtime/Core/HAL/Mutex.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#include <thread>
+
+namespace Fly3DPrivateMutexTest
+{
+	enum
+	{
+		NUM_THREADS       = 4,
+		NUM_ITERATIONS    = 20000,
+
+		/** Yields that give a wrongly released waiter time to show up. */
+		NUM_SETTLE_YIELDS = 1000,
+	};
+
+	/**
+	* Increments a plain counter under the lock from several threads and counts the holders on the way in. A lock that
+	* lets two threads in at once shows up as a second holder or as a lost increment.
+	*/
+	template <typename LockType>
+	static bool IsMutuallyExclusive(LockType& lock)
+	{
+		int32          counter     = 0;
+		volatile int32 numHolders  = 0;
+		volatile int32 numOverlaps = 0;
+
+		TArray<std::thread> threads;
+		for (int32 t = 0; t < NUM_THREADS; ++t)
+		{
+			threads.Emplace([&lock, &counter, &numHolders, &numOverlaps]()
+			{
+				for (int32 i = 0; i < NUM_ITERATIONS; ++i)
+				{
+					TScopeLock<LockType> scope(lock);
+
+					if (FPlatformAtomics::InterlockedIncrement(&numHolders) != 1)
+					{
+						FPlatformAtomics::InterlockedIncrement(&numOverlaps);
+					}
+
+					counter = counter + 1;
+
+					FPlatformAtomics::InterlockedDecrement(&numHolders);
+				}
+			});
+		}
+
+		for (int32 t = 0; t < threads.Num(); ++t)
+		{
+			threads[t].join();
+		}
+
+		return numOverlaps == 0 && counter == NUM_THREADS * NUM_ITERATIONS;
+	}
+
+	template <typename LockType>
+	static bool TryLockFailsWhileHeld(LockType& lock)
+	{
+		if (!lock.TryLock())
+		{
+			return false;
+		}
+
+		bool otherGotIt = true;
+		std::thread other([&lock, &otherGotIt]()
+		{
+			otherGotIt = lock.TryLock();
+		});
+		other.join();
+
+		lock.Unlock();
+
+		const bool relocked = lock.TryLock();
+		if (relocked)
+		{
+			lock.Unlock();
+		}
+
+		return !otherGotIt && relocked;
+	}
+}
+
+IMPLEMENT_TEST(MutexMutualExclusion)
+{
+	using namespace Fly3DPrivateMutexTest;
+
+	FMutex mutex;
+	TEST_CHECK(TryLockFailsWhileHeld(mutex));
+	TEST_CHECK(IsMutuallyExclusive(mutex));
+}
+
+IMPLEMENT_TEST(TicketLockMutualExclusion)
+{
+	using namespace Fly3DPrivateMutexTest;
+
+	FTicketLock lock;
+	TEST_CHECK(TryLockFailsWhileHeld(lock));
+	TEST_CHECK(IsMutuallyExclusive(lock));
+}
+
+IMPLEMENT_TEST(RWLockExclusion)
+{
+	using namespace Fly3DPrivateMutexTest;
+
+	FRWLock lock;
+
+	// Writers keep both values equal while holding the lock, so a reader that gets in during a write sees them differ.
+	int32          first      = 0;
+	int32          second     = 0;
+	volatile int32 numReaders = 0;
+	volatile int32 numWriters = 0;
+	volatile int32 numErrors  = 0;
+
+	TArray<std::thread> threads;
+	for (int32 t = 0; t < NUM_THREADS; ++t)
+	{
+		const bool isWriter = (t & 1) == 0;
+		threads.Emplace([&, isWriter]()
+		{
+			for (int32 i = 0; i < NUM_ITERATIONS; ++i)
+			{
+				if (isWriter)
+				{
+					FWriteScopeLock scope(lock);
+
+					if (FPlatformAtomics::InterlockedIncrement(&numWriters) != 1 || FPlatformAtomics::AtomicRead(&numReaders) != 0)
+					{
+						FPlatformAtomics::InterlockedIncrement(&numErrors);
+					}
+
+					first  = first + 1;
+					second = second + 1;
+
+					FPlatformAtomics::InterlockedDecrement(&numWriters);
+				}
+				else
+				{
+					FReadScopeLock scope(lock);
+
+					FPlatformAtomics::InterlockedIncrement(&numReaders);
+					if (FPlatformAtomics::AtomicRead(&numWriters) != 0 || first != second)
+					{
+						FPlatformAtomics::InterlockedIncrement(&numErrors);
+					}
+					FPlatformAtomics::InterlockedDecrement(&numReaders);
+				}
+			}
+		});
+	}
+
+	for (int32 t = 0; t < threads.Num(); ++t)
+	{
+		threads[t].join();
+	}
+
+	TEST_CHECK(numErrors == 0);
+	TEST_CHECK(first == (NUM_THREADS / 2) * NUM_ITERATIONS);
+	TEST_CHECK(second == first);
+
+	// Readers share the lock with each other.
+	volatile int32 otherRead = 0;
+	lock.ReadLock();
+	std::thread reader([&lock, &otherRead]()
+	{
+		FReadScopeLock scope(lock);
+		FPlatformAtomics::AtomicStore(&otherRead, 1);
+	});
+	reader.join();
+	lock.ReadUnlock();
+	TEST_CHECK(otherRead == 1);
+}
+
+IMPLEMENT_TEST(EventAutoReset)
+{
+	using namespace Fly3DPrivateMutexTest;
+
+	FEvent event(FEvent::EMode::AutoReset);
+	TEST_CHECK(!event.IsSignaled());
+	TEST_CHECK(!event.Wait(0));
+
+	// A successful wait consumes the signal.
+	event.Trigger();
+	TEST_CHECK(event.IsSignaled());
+	TEST_CHECK(event.Wait(0));
+	TEST_CHECK(!event.IsSignaled());
+	TEST_CHECK(!event.Wait(0));
+
+	// Each trigger lets exactly one sleeping waiter through.
+	volatile int32 numReleased = 0;
+
+	TArray<std::thread> threads;
+	for (int32 t = 0; t < NUM_THREADS; ++t)
+	{
+		threads.Emplace([&event, &numReleased]()
+		{
+			event.Wait();
+			FPlatformAtomics::InterlockedIncrement(&numReleased);
+		});
+	}
+
+	bool oneAtATime = true;
+	for (int32 t = 1; t <= NUM_THREADS; ++t)
+	{
+		event.Trigger();
+		while (FPlatformAtomics::AtomicRead(&numReleased) < t)
+		{
+			FPlatformAtomics::YieldThread();
+		}
+
+		for (int32 i = 0; i < NUM_SETTLE_YIELDS; ++i)
+		{
+			FPlatformAtomics::YieldThread();
+		}
+		oneAtATime &= FPlatformAtomics::AtomicRead(&numReleased) == t;
+	}
+
+	for (int32 t = 0; t < threads.Num(); ++t)
+	{
+		threads[t].join();
+	}
+
+	TEST_CHECK(oneAtATime);
+	TEST_CHECK(!event.IsSignaled());
+}
+
+IMPLEMENT_TEST(EventManualReset)
+{
+	using namespace Fly3DPrivateMutexTest;
+
+	FEvent initial(FEvent::EMode::ManualReset, true);
+	TEST_CHECK(initial.Wait(0));
+
+	FEvent event(FEvent::EMode::ManualReset);
+	TEST_CHECK(!event.Wait(0));
+
+	// One trigger releases every waiter.
+	volatile int32 numReleased = 0;
+
+	TArray<std::thread> threads;
+	for (int32 t = 0; t < NUM_THREADS; ++t)
+	{
+		threads.Emplace([&event, &numReleased]()
+		{
+			event.Wait();
+			FPlatformAtomics::InterlockedIncrement(&numReleased);
+		});
+	}
+
+	event.Trigger();
+
+	for (int32 t = 0; t < threads.Num(); ++t)
+	{
+		threads[t].join();
+	}
+
+	TEST_CHECK(numReleased == NUM_THREADS);
+
+	// It stays signaled until Reset.
+	TEST_CHECK(event.Wait(0));
+	TEST_CHECK(event.Wait(0));
+	TEST_CHECK(event.IsSignaled());
+
+	event.Reset();
+	TEST_CHECK(!event.IsSignaled());
+	TEST_CHECK(!event.Wait(0));
+}
\ No newline at end of file
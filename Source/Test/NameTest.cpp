@@ -0,0 +1,167 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Name.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+namespace Fly3DPrivateNameTest
+{
+	enum
+	{
+		NUM_GROW_NAMES       = 8192,
+		NUM_STABLE_NAMES     = 1024,
+		NUM_WRITER_THREADS   = 2,
+		NUM_READER_THREADS   = 2,
+		NUM_NAMES_PER_WRITER = 8192,
+	};
+
+	static FName MakeNumberedName(const char* prefix, int32 number, EFindName findType = FNAME_Add)
+	{
+		char name[64];
+		snprintf(name, sizeof(name), "%s_%d", prefix, number);
+		return FName(name, findType);
+	}
+}
+
+IMPLEMENT_TEST(NameUTF8)
+{
+	const FName wideName(L"Caf\u00E9Name");
+
+	// Narrow names are UTF-8 and must resolve to the same entry as the wide spelling, ASCII case ignored.
+	TEST_CHECK(FName("Caf\xC3\xA9Name") == wideName);
+	TEST_CHECK(FName("CAF\xC3\xA9name") == wideName);
+	TEST_CHECK(FName("Caf\xC3\xA9NameSuffix", 9) == wideName);
+	TEST_CHECK(wideName.GetEntry()->IsWide());
+
+	TEST_CHECK(FName("CafeName") != wideName);
+	TEST_CHECK(!FName("CafeName").GetEntry()->IsWide());
+	TEST_CHECK(FName("Caf\xC3\xA9Unknown", FNAME_Find) == NAME_None);
+}
+
+IMPLEMENT_TEST(NameCaseInsensitive)
+{
+	const FName name("HelloWorld");
+
+	TEST_CHECK(FName("helloworld") == name);
+	TEST_CHECK(FName(L"HELLOWORLD") == name);
+	TEST_CHECK(FName("hElLoWoRlD", FNAME_Find) == name);
+	TEST_CHECK(FName("HelloWorlds") != name);
+	TEST_CHECK(FName("none") == NAME_None && FName("") == NAME_None);
+
+	// The first spelling is the one kept for display, comparisons ignore case.
+	char display[32];
+	FName("HELLOWORLD").ToString(display, sizeof(display));
+	TEST_CHECK(strcmp(display, "HelloWorld") == 0);
+	TEST_CHECK(FName("HELLOWORLD").Compare(name) == 0);
+	TEST_CHECK(FName("Apple").Compare(FName("banana")) < 0);
+}
+
+IMPLEMENT_TEST(NameGrow)
+{
+	using namespace Fly3DPrivateNameTest;
+
+	const uint32 numNamesBefore = FName::GetNumNames();
+
+	// Enough names to grow every shard's slot table several times.
+	TArray<FName> names;
+	for (int32 i = 0; i < NUM_GROW_NAMES; ++i)
+	{
+		names.Add(MakeNumberedName("GrowName", i));
+	}
+
+	TEST_CHECK(FName::GetNumNames() == numNamesBefore + NUM_GROW_NAMES);
+
+	bool allFound = true;
+	for (int32 i = 0; i < NUM_GROW_NAMES; ++i)
+	{
+		allFound &= MakeNumberedName("growname", i, FNAME_Find) == names[i];
+	}
+	TEST_CHECK(allFound);
+	TEST_CHECK(FName::GetNumNames() == numNamesBefore + NUM_GROW_NAMES);
+}
+
+IMPLEMENT_TEST(NameConcurrentLookup)
+{
+	using namespace Fly3DPrivateNameTest;
+
+	TArray<FName> stableNames;
+	for (int32 i = 0; i < NUM_STABLE_NAMES; ++i)
+	{
+		stableNames.Add(MakeNumberedName("StableName", i));
+	}
+
+	volatile int32 numWriting = NUM_WRITER_THREADS;
+	volatile int32 numMisses  = 0;
+
+	TArray<std::thread> threads;
+
+	// Writers keep the shards growing while readers look names up without taking a lock.
+	for (int32 t = 0; t < NUM_WRITER_THREADS; ++t)
+	{
+		threads.Emplace([&, t]()
+		{
+			char prefix[32];
+			snprintf(prefix, sizeof(prefix), "WriterName%d", t);
+
+			for (int32 i = 0; i < NUM_NAMES_PER_WRITER; ++i)
+			{
+				MakeNumberedName(prefix, i);
+			}
+
+			FPlatformAtomics::InterlockedDecrement(&numWriting);
+		});
+	}
+
+	for (int32 t = 0; t < NUM_READER_THREADS; ++t)
+	{
+		threads.Emplace([&]()
+		{
+			do
+			{
+				for (int32 i = 0; i < NUM_STABLE_NAMES; ++i)
+				{
+					if (MakeNumberedName("StableName", i, FNAME_Find) != stableNames[i])
+					{
+						FPlatformAtomics::InterlockedIncrement(&numMisses);
+					}
+				}
+			}
+			while (FPlatformAtomics::AtomicRead(&numWriting) > 0);
+		});
+	}
+
+	for (int32 i = 0; i < threads.Num(); ++i)
+	{
+		threads[i].join();
+	}
+
+	TEST_CHECK(numMisses == 0);
+
+	bool allAdded = true;
+	for (int32 t = 0; t < NUM_WRITER_THREADS; ++t)
+	{
+		char prefix[32];
+		snprintf(prefix, sizeof(prefix), "WriterName%d", t);
+
+		for (int32 i = 0; i < NUM_NAMES_PER_WRITER; ++i)
+		{
+			allAdded &= !MakeNumberedName(prefix, i, FNAME_Find).IsNone();
+		}
+	}
+	TEST_CHECK(allAdded);
+}
+
+IMPLEMENT_TEST(NameTooLong)
+{
+	char longName[NAME_SIZE + 100];
+	memset(longName, 'x', sizeof(longName) - 1);
+	longName[sizeof(longName) - 1] = 0;
+
+	// Oversized names are cut to the longest name an entry holds, also when assertions are compiled out.
+	const FName name(longName);
+	TEST_CHECK(name.GetStringLength() == NAME_SIZE - 1);
+	TEST_CHECK(FName(longName, NAME_SIZE - 1) == name);
+}
\ No newline at end of file
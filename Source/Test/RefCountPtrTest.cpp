@@ -0,0 +1,139 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Template/RefCounting.h"
+
+namespace Fly3DPrivateRefCountPtrTest
+{
+	static int32 g_NumLive = 0;
+
+	class FBase : public FRefCountedObject
+	{
+	public:
+
+		explicit FBase(int32 value)
+			: m_Value(value)
+		{
+			++g_NumLive;
+		}
+
+		virtual ~FBase()
+		{
+			--g_NumLive;
+		}
+
+		int32 m_Value;
+	};
+
+	class FDerived : public FBase
+	{
+	public:
+
+		explicit FDerived(int32 value)
+			: FBase(value)
+		{
+
+		}
+	};
+
+	class FInterface
+	{
+	public:
+
+		virtual ~FInterface()
+		{
+
+		}
+
+		virtual int32 GetValue() const = 0;
+	};
+
+	/** The counted base is not the first base, so deleting through it has to find the start of the allocation. */
+	class FSecondBase : public FInterface, public FThreadSafeRefCountedObject
+	{
+	public:
+
+		FSecondBase()
+		{
+			++g_NumLive;
+		}
+
+		virtual ~FSecondBase()
+		{
+			--g_NumLive;
+		}
+
+		virtual int32 GetValue() const override
+		{
+			return 7;
+		}
+	};
+}
+
+IMPLEMENT_TEST(RefCountPtrOwnership)
+{
+	using namespace Fly3DPrivateRefCountPtrTest;
+
+	{
+		TRefCountPtr<FBase> empty;
+		TEST_CHECK(!empty && !empty.IsValid());
+
+		TRefCountPtr<FBase> first = MakeRefCount<FBase>(1);
+		TEST_CHECK(first && first->m_Value == 1 && first.GetRefCount() == 1);
+		TEST_CHECK(g_NumLive == 1);
+
+		TRefCountPtr<FBase> copy = first;
+		TEST_CHECK(copy == first && first.GetRefCount() == 2);
+
+		TRefCountPtr<FBase> moved = MoveTemp(copy);
+		TEST_CHECK(!copy && moved == first && first.GetRefCount() == 2);
+
+		moved = first;
+		TEST_CHECK(first.GetRefCount() == 2);
+
+		moved.SafeRelease();
+		TEST_CHECK(!moved && first.GetRefCount() == 1);
+
+		TRefCountPtr<FDerived> derived = MakeRefCount<FDerived>(2);
+		TRefCountPtr<FBase> upcast = derived;
+		TEST_CHECK(upcast == derived && derived.GetRefCount() == 2);
+		TEST_CHECK(g_NumLive == 2);
+
+		first = MoveTemp(upcast);
+		TEST_CHECK(g_NumLive == 1 && first->m_Value == 2 && derived.GetRefCount() == 2);
+
+		first.Swap(moved);
+		TEST_CHECK(!first && moved->m_Value == 2);
+
+		FBase* detached = moved.Detach();
+		TEST_CHECK(!moved && detached->GetRefCount() == 2);
+
+		TRefCountPtr<FBase> adopted(detached, false);
+		TEST_CHECK(adopted.GetRefCount() == 2);
+	}
+
+	TEST_CHECK(g_NumLive == 0);
+}
+
+IMPLEMENT_TEST(RefCountPtrSecondaryBase)
+{
+	using namespace Fly3DPrivateRefCountPtrTest;
+
+	{
+		TArray<TRefCountPtr<FSecondBase>> handles;
+		TRefCountPtr<FSecondBase> object = MakeRefCount<FSecondBase>();
+
+		for (int32 i = 0; i < 100; ++i)
+		{
+			handles.Add(object);
+		}
+
+		// Growing the array relocates the handles bitwise, the count is untouched by that.
+		TEST_CHECK(object.GetRefCount() == 101);
+		TEST_CHECK(handles[99]->GetValue() == 7);
+
+		handles.Empty();
+		TEST_CHECK(object.GetRefCount() == 1 && g_NumLive == 1);
+	}
+
+	TEST_CHECK(g_NumLive == 0);
+}
\ No newline at end of file
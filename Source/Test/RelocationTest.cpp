@@ -0,0 +1,158 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/TLSF/tlsf.h"
+
+namespace Fly3DPrivateRelocationTest
+{
+	/** Points at itself, so a bitwise relocation leaves a dangling m_Self behind. */
+	struct FSelfPointer
+	{
+		static int32 NumLive;
+
+		FSelfPointer* m_Self;
+		int32         m_Value;
+
+		FSelfPointer(int32 value)
+			: m_Self(this)
+			, m_Value(value)
+		{
+			++NumLive;
+		}
+
+		FSelfPointer(const FSelfPointer& other)
+			: m_Self(this)
+			, m_Value(other.m_Value)
+		{
+			++NumLive;
+		}
+
+		FSelfPointer(FSelfPointer&& other)
+			: m_Self(this)
+			, m_Value(other.m_Value)
+		{
+			++NumLive;
+		}
+
+		FSelfPointer& operator=(const FSelfPointer& other)
+		{
+			m_Value = other.m_Value;
+			return *this;
+		}
+
+		~FSelfPointer()
+		{
+			--NumLive;
+		}
+
+		bool IsIntact() const
+		{
+			return m_Self == this;
+		}
+	};
+
+	int32 FSelfPointer::NumLive = 0;
+
+	static bool IsIntact(const TArray<FSelfPointer>& array)
+	{
+		for (int32 i = 0; i < array.Num(); ++i)
+		{
+			if (!array[i].IsIntact())
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_TEST(RelocationTraits)
+{
+	using namespace Fly3DPrivateRelocationTest;
+
+	TEST_CHECK(TIsBitwiseRelocatable<int32>::Value);
+	TEST_CHECK(TIsBitwiseRelocatable<const float>::Value);
+	TEST_CHECK(TIsBitwiseRelocatable<TArray<int32>>::Value);
+	TEST_CHECK(!TIsBitwiseRelocatable<FSelfPointer>::Value);
+}
+
+IMPLEMENT_TEST(RelocationNonTrivial)
+{
+	using namespace Fly3DPrivateRelocationTest;
+
+	{
+		TArray<FSelfPointer> array;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			array.Emplace(i);
+		}
+
+		// Growth has to move-construct the elements instead of copying their bytes.
+		TEST_CHECK(IsIntact(array));
+		TEST_CHECK(FSelfPointer::NumLive == 1000);
+
+		array.RemoveAt(10, 20);
+		TEST_CHECK(IsIntact(array));
+		TEST_CHECK(array.Num() == 980 && array[10].m_Value == 30);
+
+		array.Insert(FSelfPointer(-1), 0);
+		TEST_CHECK(IsIntact(array));
+		TEST_CHECK(array[0].m_Value == -1 && array[11].m_Value == 30);
+
+		array.RemoveAtSwap(0);
+		TEST_CHECK(IsIntact(array));
+		TEST_CHECK(FSelfPointer::NumLive == 980);
+
+		array.Shrink();
+		TEST_CHECK(IsIntact(array));
+	}
+
+	TEST_CHECK(FSelfPointer::NumLive == 0);
+
+	TArray<TArray<int32>> nested;
+	for (int32 i = 0; i < 100; ++i)
+	{
+		nested.AddDefaulted();
+		nested.Last().Add(i);
+	}
+
+	bool nestedIntact = true;
+	for (int32 i = 0; i < 100; ++i)
+	{
+		nestedIntact &= nested[i].Num() == 1 && nested[i][0] == i;
+	}
+	TEST_CHECK(nestedIntact);
+}
+
+IMPLEMENT_TEST(RelocationExpandInPlace)
+{
+	static uint64 pool[8 * 1024];
+
+	tlsf_t tlsf = tlsf_create_with_pool(pool, sizeof(pool));
+
+	void* first  = tlsf_malloc(tlsf, 256);
+	void* second = tlsf_malloc(tlsf, 256);
+	void* third  = tlsf_malloc(tlsf, 256);
+	memset(first, 0x5A, 256);
+
+	// The neighbour is still in use, so the block cannot grow.
+	TEST_CHECK(!tlsf_expand_in_place(tlsf, first, 512));
+
+	tlsf_free(tlsf, second);
+
+	TEST_CHECK(tlsf_expand_in_place(tlsf, first, 512));
+	TEST_CHECK(tlsf_block_size(first) >= 512);
+	TEST_CHECK(((uint8*)first)[0] == 0x5A && ((uint8*)first)[255] == 0x5A);
+
+	// Growing past the freed neighbour would run into the third block.
+	TEST_CHECK(!tlsf_expand_in_place(tlsf, first, 1024));
+
+	// Shrinking always succeeds and hands the tail back to the pool.
+	TEST_CHECK(tlsf_expand_in_place(tlsf, first, 128));
+	TEST_CHECK(tlsf_block_size(first) < 512);
+
+	tlsf_free(tlsf, third);
+	tlsf_free(tlsf, first);
+
+	TEST_CHECK(tlsf_check(tlsf) == 0);
+	tlsf_destroy(tlsf);
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/PlatformAtomics.h"
+#include "Runtime/Core/PlatformTime.h"
+#include "Runtime/Render/RenderThread.h"
+#include "Runtime/RHI/DynamicRHI.h"
+
+#include <thread>
+
+namespace Fly3DPrivateRenderThreadTest
+{
+	enum
+	{
+		/** More commands than the queue holds, so that Enqueue also has to wait for room. */
+		NUM_COMMANDS = FRenderThread::COMMAND_QUEUE_CAPACITY * 3 + 1,
+
+		NUM_FRAMES   = 64,
+	};
+
+	/** How long the game thread has to stay blocked while the render thread is held up. */
+	static const double STALL_SECONDS = 0.02;
+
+	/** A null backend whose BeginFrame holds the render thread up until the gate opens. */
+	class FGatedRHI : public FNullDynamicRHI
+	{
+	public:
+
+		FGatedRHI()
+			: m_IsOpen(0)
+			, m_NumFramesEnded(0)
+		{
+
+		}
+
+		virtual void BeginFrame() override
+		{
+			while (!FPlatformAtomics::AtomicRead(&m_IsOpen, EMemoryOrder::Acquire))
+			{
+				FPlatformAtomics::YieldThread();
+			}
+		}
+
+		virtual void EndFrame() override
+		{
+			FPlatformAtomics::InterlockedIncrement(&m_NumFramesEnded);
+		}
+
+		void Open()
+		{
+			FPlatformAtomics::AtomicStore(&m_IsOpen, 1, EMemoryOrder::Release);
+		}
+
+		int32 GetNumFramesEnded() const
+		{
+			return FPlatformAtomics::AtomicRead(&m_NumFramesEnded, EMemoryOrder::Acquire);
+		}
+
+	private:
+
+		volatile int32 m_IsOpen;
+		volatile int32 m_NumFramesEnded;
+	};
+
+	static void WaitForFlag(const volatile int32* flag)
+	{
+		while (!FPlatformAtomics::AtomicRead(flag, EMemoryOrder::Acquire))
+		{
+			FPlatformAtomics::YieldThread();
+		}
+	}
+}
+
+IMPLEMENT_TEST(RenderThreadCommandOrder)
+{
+	using namespace Fly3DPrivateRenderThreadTest;
+
+	// Without a render thread commands run right away on the calling thread.
+	int32 numInline = 0;
+	FRenderThread::Enqueue([&numInline]() { ++numInline; });
+	TEST_CHECK(numInline == 1);
+
+	FRenderThread::Startup();
+	TEST_CHECK(FRenderThread::IsRunning());
+	TEST_CHECK(!FRenderThread::IsInRenderThread());
+
+	TArray<int32> order;
+	order.Reserve(NUM_COMMANDS);
+
+	bool allOnRenderThread = true;
+	for (int32 i = 0; i < NUM_COMMANDS; ++i)
+	{
+		FRenderThread::Enqueue([&order, &allOnRenderThread, i]()
+		{
+			allOnRenderThread &= FRenderThread::IsInRenderThread();
+			order.Add(i);
+		});
+	}
+	FRenderThread::Flush();
+
+	bool inOrder = order.Num() == NUM_COMMANDS;
+	for (int32 i = 0; inOrder && i < NUM_COMMANDS; ++i)
+	{
+		inOrder = order[i] == i;
+	}
+	TEST_CHECK(inOrder);
+	TEST_CHECK(allOnRenderThread);
+
+	// Shutdown runs the commands still queued before the thread stops.
+	volatile int32 numDrained = 0;
+	for (int32 i = 0; i < NUM_COMMANDS; ++i)
+	{
+		FRenderThread::Enqueue([&numDrained]() { FPlatformAtomics::InterlockedIncrement(&numDrained); });
+	}
+	FRenderThread::Shutdown();
+
+	TEST_CHECK(!FRenderThread::IsRunning());
+	TEST_CHECK(numDrained == NUM_COMMANDS);
+}
+
+IMPLEMENT_TEST(RenderThreadFence)
+{
+	using namespace Fly3DPrivateRenderThreadTest;
+
+	FRenderFence idle;
+	TEST_CHECK(idle.IsComplete());
+
+	FRenderThread::Startup();
+
+	// Hold the render thread up so that the fence cannot have passed yet.
+	volatile int32 isGateOpen = 0;
+	volatile int32 numBefore  = 0;
+	FRenderThread::Enqueue([&isGateOpen]() { WaitForFlag(&isGateOpen); });
+	for (int32 i = 0; i < 100; ++i)
+	{
+		FRenderThread::Enqueue([&numBefore]() { FPlatformAtomics::InterlockedIncrement(&numBefore); });
+	}
+
+	FRenderFence fence;
+	fence.BeginFence();
+	TEST_CHECK(!fence.IsComplete());
+
+	FPlatformAtomics::AtomicStore(&isGateOpen, 1, EMemoryOrder::Release);
+	fence.Wait();
+
+	TEST_CHECK(fence.IsComplete());
+	TEST_CHECK(numBefore == 100);
+
+	// A fence can be reused once it signaled.
+	fence.BeginFence();
+	fence.Wait();
+	TEST_CHECK(fence.IsComplete());
+
+	FRenderThread::Shutdown();
+}
+
+IMPLEMENT_TEST(RenderThreadFramesInFlight)
+{
+	using namespace Fly3DPrivateRenderThreadTest;
+
+	FDynamicRHI* const prevRHI = GDynamicRHI;
+
+	bool stalled     = true;
+	bool withinBound = true;
+	bool allFrames   = true;
+
+	for (int32 numFramesInFlight = 1; numFramesInFlight <= FRenderThread::MAX_FRAMES_IN_FLIGHT; ++numFramesInFlight)
+	{
+		FGatedRHI rhi;
+		GDynamicRHI = &rhi;
+
+		FRenderThread::Startup(numFramesInFlight);
+
+		volatile int32 numGameFrames = 0;
+		bool           outOfBound    = false;
+
+		std::thread gameThread([&rhi, &numGameFrames, &outOfBound, numFramesInFlight]()
+		{
+			for (int32 frame = 1; frame <= NUM_FRAMES; ++frame)
+			{
+				FRenderThread::BeginFrame();
+				FRenderThread::EndFrame();
+
+				// Once EndFrame returned, the render thread finished all but the last NumFramesInFlight - 1 frames.
+				outOfBound |= frame - rhi.GetNumFramesEnded() > numFramesInFlight - 1;
+				FPlatformAtomics::AtomicStore(&numGameFrames, frame, EMemoryOrder::Release);
+			}
+		});
+
+		// The render thread is stuck in the first frame, so the game thread ends NumFramesInFlight - 1 frames and then
+		// blocks in the EndFrame of the next one.
+		while (FPlatformAtomics::AtomicRead(&numGameFrames, EMemoryOrder::Acquire) < numFramesInFlight - 1)
+		{
+			FPlatformAtomics::YieldThread();
+		}
+
+		const double stallEnd = FPlatformTime::Seconds() + STALL_SECONDS;
+		while (FPlatformTime::Seconds() < stallEnd)
+		{
+			FPlatformAtomics::YieldThread();
+		}
+		stalled &= FPlatformAtomics::AtomicRead(&numGameFrames, EMemoryOrder::Acquire) == numFramesInFlight - 1;
+
+		rhi.Open();
+		gameThread.join();
+
+		FRenderThread::Shutdown();
+
+		withinBound &= !outOfBound;
+		allFrames   &= numGameFrames == NUM_FRAMES && rhi.GetNumFramesEnded() == NUM_FRAMES;
+	}
+
+	GDynamicRHI = prevRHI;
+
+	TEST_CHECK(stalled);
+	TEST_CHECK(withinBound);
+	TEST_CHECK(allFrames);
+}
\ No newline at end of file
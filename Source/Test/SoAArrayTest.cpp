@@ -0,0 +1,89 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/SoAArray.h"
+
+namespace Fly3DPrivateSoAArrayTest
+{
+	struct FCounted
+	{
+		static int32 NumLive;
+
+		int32 Value;
+
+		FCounted()
+			: Value(0)
+		{
+			++NumLive;
+		}
+
+		FCounted(int32 value)
+			: Value(value)
+		{
+			++NumLive;
+		}
+
+		FCounted(const FCounted& other)
+			: Value(other.Value)
+		{
+			++NumLive;
+		}
+
+		~FCounted()
+		{
+			--NumLive;
+		}
+	};
+
+	int32 FCounted::NumLive = 0;
+}
+
+IMPLEMENT_TEST(SoAArrayStreams)
+{
+	using namespace Fly3DPrivateSoAArrayTest;
+
+	{
+		typedef TSoAArray<float, FCounted, uint8> FArrayType;
+
+		FArrayType array;
+		TEST_CHECK(array.IsEmpty());
+
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			array.Emplace((float)i, i * 2, (uint8)i);
+		}
+
+		TEST_CHECK(array.Num() == 1000);
+		TEST_CHECK(FCounted::NumLive == 1000);
+
+		// Every stream starts on the minimum stream alignment and keeps its values across growth.
+		TEST_CHECK(((size_t)array.GetStreamData<0>() % FArrayType::MinStreamAlignment) == 0);
+		TEST_CHECK(((size_t)array.GetStreamData<1>() % FArrayType::MinStreamAlignment) == 0);
+		TEST_CHECK(((size_t)array.GetStreamData<2>() % FArrayType::MinStreamAlignment) == 0);
+
+		bool intact = true;
+		for (int32 i = 0; i < 1000; ++i)
+		{
+			intact &= array.Get<0>(i) == (float)i && array.Get<1>(i).Value == i * 2 && array.Get<2>(i) == (uint8)i;
+		}
+		TEST_CHECK(intact);
+
+		array.RemoveAtSwap(0);
+		TEST_CHECK(array.Num() == 999);
+		TEST_CHECK(FCounted::NumLive == 999);
+		TEST_CHECK(array.Get<0>(0) == 999.0f && array.Get<1>(0).Value == 1998);
+
+		FArrayType copy(array);
+		TEST_CHECK(copy.Num() == 999 && FCounted::NumLive == 1998);
+		TEST_CHECK(copy.Get<1>(998).Value == array.Get<1>(998).Value);
+
+		FArrayType moved(MoveTemp(copy));
+		TEST_CHECK(copy.Num() == 0 && moved.Num() == 999 && FCounted::NumLive == 1998);
+
+		array.Reset();
+		TEST_CHECK(array.Num() == 0 && FCounted::NumLive == 999);
+
+		array.AddDefaulted(3);
+		TEST_CHECK(array.Num() == 3 && array.Get<1>(2).Value == 0);
+	}
+
+	TEST_CHECK(FCounted::NumLive == 0);
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+﻿#include "Test/Test.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Fly3DPrivateTest
+{
+	enum
+	{
+		MAX_TESTS = 256
+	};
+
+	struct FTestEntry
+	{
+		const char*		Name;
+		FTestFunction	Function;
+	};
+
+	// Filled during static initialization, so plain arrays rather than anything that allocates.
+	static FTestEntry s_Tests[MAX_TESTS];
+	static int32 s_NumTests    = 0;
+	static int32 s_NumFailures = 0;
+
+	static bool IsSelected(const char* name, int32 argc, char** argv)
+	{
+		if (argc <= 1)
+		{
+			return true;
+		}
+
+		for (int32 i = 1; i < argc; ++i)
+		{
+			if (strstr(name, argv[i]) != nullptr)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
+
+void FTest::Register(const char* name, FTestFunction function)
+{
+	using namespace Fly3DPrivateTest;
+
+	Assert(s_NumTests < (int32)MAX_TESTS);
+
+	s_Tests[s_NumTests].Name     = name;
+	s_Tests[s_NumTests].Function = function;
+	s_NumTests += 1;
+}
+
+int32 FTest::RunAll(int32 argc, char** argv)
+{
+	using namespace Fly3DPrivateTest;
+
+	int32 numRun    = 0;
+	int32 numFailed = 0;
+
+	for (int32 i = 0; i < s_NumTests; ++i)
+	{
+		if (!IsSelected(s_Tests[i].Name, argc, argv))
+		{
+			continue;
+		}
+
+		const int32 numFailuresBefore = s_NumFailures;
+		s_Tests[i].Function();
+
+		const bool passed = s_NumFailures == numFailuresBefore;
+		printf("[%s] %s\n", passed ? "  OK  " : " FAIL ", s_Tests[i].Name);
+
+		numRun    += 1;
+		numFailed += passed ? 0 : 1;
+	}
+
+	printf("%d of %d tests passed\n", numRun - numFailed, numRun);
+
+	return (numRun > 0 && numFailed == 0) ? 0 : 1;
+}
+
+void FTest::ReportFailure(const char* expression, const char* file, int32 line)
+{
+	Fly3DPrivateTest::s_NumFailures += 1;
+	printf("%s(%d): TEST_CHECK(%s) failed\n", file, line, expression);
+}
+
+int main(int argc, char** argv)
+{
+	return FTest::RunAll(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+﻿#pragma once
+
+#include "Runtime/Platform/Platform.h"
+
+typedef void (*FTestFunction)();
+
+/**
+* Unit tests for the runtime, built into the console executable Fly3DTest and run by ctest. IMPLEMENT_TEST registers
+* a function during static initialization; TEST_CHECK records a failure and keeps going so one run reports every
+* broken expectation. Without arguments every test runs, otherwise only those whose name contains one of the arguments.
+*/
+class FTest
+{
+public:
+
+	static void Register(const char* name, FTestFunction function);
+
+	static int32 RunAll(int32 argc, char** argv);
+
+	static void ReportFailure(const char* expression, const char* file, int32 line);
+};
+
+struct FTestRegistrar
+{
+	FTestRegistrar(const char* name, FTestFunction function)
+	{
+		FTest::Register(name, function);
+	}
+};
+
+#define IMPLEMENT_TEST(Name) \
+	static void Test##Name(); \
+	static FTestRegistrar g_Test##Name##Registrar(#Name, &Test##Name); \
+	static void Test##Name()
+
+#define TEST_CHECK(expression) \
+	do { if (!(expression)) { FTest::ReportFailure(#expression, __FILE__, __LINE__); } } while (0)
\ No newline at end of file
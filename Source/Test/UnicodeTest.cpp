@@ -0,0 +1,453 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/String/Unicode.h"
+
+#include <string.h>
+
+/**
+* Scalar reference for the transcoders, one code point at a time. FUnicode takes 16 code unit blocks through SSE2,
+* so every result is compared against this with the non-ASCII input moved across the block boundaries.
+*/
+namespace Fly3DPrivateUnicodeTest
+{
+	enum
+	{
+		MAX_TEST_LENGTH = 48,
+	};
+
+	static const uint32 INVALID = 0xFFFFFFFF;
+
+	/** Decodes one code point, malformed sequences consume one byte, as documented for FUnicode. */
+	static uint32 DecodeUTF8(const uint8* src, int32 srcLen, int32& index)
+	{
+		const uint32 lead = src[index++];
+		if (lead < 0x80)
+		{
+			return lead;
+		}
+
+		const int32  numTrail     = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : 1;
+		const uint32 minCodePoint = numTrail == 3 ? 0x10000 : numTrail == 2 ? 0x800 : 0x80;
+
+		if (lead < 0xC2 || lead > 0xF4 || srcLen - index < numTrail)
+		{
+			return INVALID;
+		}
+
+		uint32 codePoint = lead & (0x3F >> numTrail);
+		for (int32 i = 0; i < numTrail; ++i)
+		{
+			if ((src[index + i] & 0xC0) != 0x80)
+			{
+				return INVALID;
+			}
+
+			codePoint = (codePoint << 6) | (src[index + i] & 0x3F);
+		}
+
+		if (codePoint < minCodePoint || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+		{
+			return INVALID;
+		}
+
+		index += numTrail;
+		return codePoint;
+	}
+
+	static void DecodeAll(const ANSICHAR* src, int32 srcLen, TArray<uint32>& out)
+	{
+		for (int32 index = 0; index < srcLen; )
+		{
+			out.Add(DecodeUTF8((const uint8*)src, srcLen, index));
+		}
+	}
+
+	static void DecodeAll(const CHAR16* src, int32 srcLen, TArray<uint32>& out)
+	{
+		for (int32 index = 0; index < srcLen; ++index)
+		{
+			const uint32 c = src[index];
+			if (c >= 0xD800 && c <= 0xDBFF && index + 1 < srcLen && src[index + 1] >= 0xDC00 && src[index + 1] <= 0xDFFF)
+			{
+				out.Add(0x10000 + ((c - 0xD800) << 10) + (src[++index] - 0xDC00));
+			}
+			else
+			{
+				out.Add((c >= 0xD800 && c <= 0xDFFF) ? INVALID : c);
+			}
+		}
+	}
+
+	static void DecodeAll(const CHAR32* src, int32 srcLen, TArray<uint32>& out)
+	{
+		for (int32 index = 0; index < srcLen; ++index)
+		{
+			out.Add((src[index] > 0x10FFFF || (src[index] >= 0xD800 && src[index] <= 0xDFFF)) ? INVALID : src[index]);
+		}
+	}
+
+	static void EncodeOne(TArray<ANSICHAR>& out, uint32 c)
+	{
+		if (c < 0x80)
+		{
+			out.Add((ANSICHAR)c);
+		}
+		else if (c < 0x800)
+		{
+			out.Add((ANSICHAR)(0xC0 | (c >> 6)));
+			out.Add((ANSICHAR)(0x80 | (c & 0x3F)));
+		}
+		else if (c < 0x10000)
+		{
+			out.Add((ANSICHAR)(0xE0 | (c >> 12)));
+			out.Add((ANSICHAR)(0x80 | ((c >> 6) & 0x3F)));
+			out.Add((ANSICHAR)(0x80 | (c & 0x3F)));
+		}
+		else
+		{
+			out.Add((ANSICHAR)(0xF0 | (c >> 18)));
+			out.Add((ANSICHAR)(0x80 | ((c >> 12) & 0x3F)));
+			out.Add((ANSICHAR)(0x80 | ((c >> 6) & 0x3F)));
+			out.Add((ANSICHAR)(0x80 | (c & 0x3F)));
+		}
+	}
+
+	static void EncodeOne(TArray<CHAR16>& out, uint32 c)
+	{
+		if (c < 0x10000)
+		{
+			out.Add((CHAR16)c);
+		}
+		else
+		{
+			out.Add((CHAR16)(0xD800 + ((c - 0x10000) >> 10)));
+			out.Add((CHAR16)(0xDC00 + ((c - 0x10000) & 0x3FF)));
+		}
+	}
+
+	static void EncodeOne(TArray<CHAR32>& out, uint32 c)
+	{
+		out.Add(c);
+	}
+
+	/**
+	* Reference conversion. outFitLength is how much of it a dest of destLen code units holds: whole code points
+	* only, which is the part of dest FUnicode specifies.
+	*/
+	template <typename DestType, typename SrcType>
+	static void ReferenceConvert(const SrcType* src, int32 srcLen, int32 destLen, TArray<DestType>& out, int32& outFitLength)
+	{
+		TArray<uint32> codePoints;
+		DecodeAll(src, srcLen, codePoints);
+
+		outFitLength = -1;
+		for (int32 i = 0; i < codePoints.Num(); ++i)
+		{
+			const int32 before = out.Num();
+			EncodeOne(out, codePoints[i] == INVALID ? (uint32)FUnicode::REPLACEMENT_CHAR : codePoints[i]);
+
+			if (outFitLength < 0 && out.Num() > destLen)
+			{
+				outFitLength = before;
+			}
+		}
+
+		if (outFitLength < 0)
+		{
+			outFitLength = out.Num();
+		}
+	}
+
+	static int32 Convert(CHAR16* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)   { return FUnicode::UTF8ToUTF16(dest, destLen, src, srcLen); }
+	static int32 Convert(CHAR32* dest, int32 destLen, const ANSICHAR* src, int32 srcLen)   { return FUnicode::UTF8ToUTF32(dest, destLen, src, srcLen); }
+	static int32 Convert(ANSICHAR* dest, int32 destLen, const CHAR16* src, int32 srcLen)   { return FUnicode::UTF16ToUTF8(dest, destLen, src, srcLen); }
+	static int32 Convert(ANSICHAR* dest, int32 destLen, const CHAR32* src, int32 srcLen)   { return FUnicode::UTF32ToUTF8(dest, destLen, src, srcLen); }
+
+	/** Converts src into every dest size from 0 to what it needs and compares each with the reference. */
+	template <typename DestType, typename SrcType>
+	static bool MatchesReference(const SrcType* src, int32 srcLen)
+	{
+		TArray<DestType> expected;
+		int32 fitLength;
+		ReferenceConvert(src, srcLen, 0, expected, fitLength);
+
+		const int32 needed = expected.Num();
+		if (Convert((DestType*)nullptr, 0, src, srcLen) != needed)
+		{
+			return false;
+		}
+
+		TArray<DestType> dest;
+		for (int32 destLen = 0; destLen <= needed; ++destLen)
+		{
+			TArray<DestType> unused;
+			ReferenceConvert(src, srcLen, destLen, unused, fitLength);
+
+			dest.Reset();
+			dest.AddZeroed(destLen + 1);
+
+			if (Convert(dest.GetData(), destLen, src, srcLen) != needed || dest[destLen] != 0)
+			{
+				return false;
+			}
+
+			for (int32 i = 0; i < fitLength; ++i)
+			{
+				if (dest[i] != expected[i])
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	static bool ReferenceValidate(const ANSICHAR* src, int32 srcLen)
+	{
+		TArray<uint32> codePoints;
+		DecodeAll(src, srcLen, codePoints);
+		return !codePoints.Contains(INVALID);
+	}
+
+	static int32 ReferenceCount(const ANSICHAR* src, int32 srcLen)
+	{
+		int32 count = 0;
+		for (int32 i = 0; i < srcLen; ++i)
+		{
+			count += ((uint8)src[i] & 0xC0) != 0x80;
+		}
+		return count;
+	}
+
+	static int32 ReferenceFind(const TCHAR* str, int32 len, const TCHAR* subStr, int32 subLen, bool ignoreCase)
+	{
+		for (int32 i = 0; i + subLen <= len; ++i)
+		{
+			int32 j = 0;
+			while (j < subLen && (ignoreCase ? FUnicode::ToLower(str[i + j]) == FUnicode::ToLower(subStr[j]) : str[i + j] == subStr[j]))
+			{
+				++j;
+			}
+
+			if (j == subLen)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	template <typename CharType>
+	static void Fill(TArray<CharType>& out, int32 len, CharType c)
+	{
+		out.Reset();
+		for (int32 i = 0; i < len; ++i)
+		{
+			out.Add((CharType)(c + i % 26));
+		}
+	}
+
+	/** Writes the code units of sequence into text at offset, clipped to the end of text. */
+	template <typename CharType>
+	static void Insert(TArray<CharType>& text, int32 offset, const CharType* sequence, int32 sequenceLen)
+	{
+		for (int32 i = 0; i < sequenceLen && offset + i < text.Num(); ++i)
+		{
+			text[offset + i] = sequence[i];
+		}
+	}
+}
+
+IMPLEMENT_TEST(UnicodeCaseMapping)
+{
+	// Latin-1, Latin Extended-A including the odd-upper runs and the pair crossing into Latin-1.
+	TEST_CHECK(FUnicode::ToLower(0x00C9) == 0x00E9 && FUnicode::ToUpper(0x00E9) == 0x00C9);
+	TEST_CHECK(FUnicode::ToLower(0x00D7) == 0x00D7);
+	TEST_CHECK(FUnicode::ToLower(0x0139) == 0x013A && FUnicode::ToLower(0x013A) == 0x013A);
+	TEST_CHECK(FUnicode::ToLower(0x0178) == 0x00FF && FUnicode::ToUpper(0x00FF) == 0x0178);
+
+	// Greek with the final sigma, Cyrillic, Armenian, Latin Extended Additional and fullwidth.
+	TEST_CHECK(FUnicode::ToUpper(0x03C2) == 0x03A3 && FUnicode::ToLower(0x03A3) == 0x03C3);
+	TEST_CHECK(FUnicode::ToLower(0x0401) == 0x0451 && FUnicode::ToUpper(0x044F) == 0x042F);
+	TEST_CHECK(FUnicode::ToLower(0x0531) == 0x0561);
+	TEST_CHECK(FUnicode::ToLower(0x1E9E) == 0x00DF && FUnicode::ToUpper(0x00DF) == 0x00DF);
+	TEST_CHECK(FUnicode::ToLower(0xFF21) == 0xFF41 && FUnicode::ToUpper(0xFF5A) == 0xFF3A);
+
+	// Blocks outside the table keep their case.
+	TEST_CHECK(FUnicode::ToLower(0x0181) == 0x0181 && FUnicode::ToLower(0x4E00) == 0x4E00);
+
+	const TCHAR upper[] = { 'N', 0x00C4, 0x0416, 0x0394, 0 };
+	const TCHAR lower[] = { 'n', 0x00E4, 0x0436, 0x03B4, 0 };
+	TEST_CHECK(FUnicode::CompareIgnoreCase(upper, lower, 4) == 0);
+}
+
+IMPLEMENT_TEST(UnicodeConversionKnownValues)
+{
+	const ANSICHAR utf8[] = "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+	const CHAR16   utf16[] = { 'A', 0x00E9, 0x20AC, 0xD83D, 0xDE00 };
+	const CHAR32   utf32[] = { 'A', 0x00E9, 0x20AC, 0x1F600 };
+
+	CHAR16   dest16[8];
+	CHAR32   dest32[8];
+	ANSICHAR dest8[16];
+
+	TEST_CHECK(FUnicode::UTF8ToUTF16(dest16, 8, utf8, 10) == 5 && memcmp(dest16, utf16, sizeof(utf16)) == 0);
+	TEST_CHECK(FUnicode::UTF8ToUTF32(dest32, 8, utf8, 10) == 4 && memcmp(dest32, utf32, sizeof(utf32)) == 0);
+	TEST_CHECK(FUnicode::UTF16ToUTF8(dest8, 16, utf16, 5) == 10 && memcmp(dest8, utf8, 10) == 0);
+	TEST_CHECK(FUnicode::UTF32ToUTF8(dest8, 16, utf32, 4) == 10 && memcmp(dest8, utf8, 10) == 0);
+
+	TEST_CHECK(FUnicode::ValidateUTF8(utf8, 10));
+	TEST_CHECK(FUnicode::CountCodePoints(utf8, 10) == 4);
+
+	// A surrogate pair that does not fit whole is not written, the return value is still the full length.
+	dest16[3] = 0;
+	TEST_CHECK(FUnicode::UTF8ToUTF16(dest16, 4, utf8, 10) == 5 && memcmp(dest16, utf16, 3 * sizeof(CHAR16)) == 0);
+	TEST_CHECK(FUnicode::UTF8ToUTF16(nullptr, 0, utf8, 10) == 5);
+}
+
+IMPLEMENT_TEST(UnicodeMalformedInput)
+{
+	using namespace Fly3DPrivateUnicodeTest;
+
+	// Overlong, surrogate, past U+10FFFF, truncated, stray continuation and invalid lead bytes.
+	const char* malformed[] =
+	{
+		"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xF0\x80\x80\x80", "\xED\xA0\x80", "\xED\xBF\xBF",
+		"\xF4\x90\x80\x80", "\xE2\x82", "\xF0\x9F\x98", "\x80", "\xBF", "\xFE", "\xFF", "\xC3", "\xE2\x28\xA1",
+	};
+
+	bool allMatch = true;
+	for (int32 i = 0; i < (int32)(sizeof(malformed) / sizeof(malformed[0])); ++i)
+	{
+		const int32 len = (int32)strlen(malformed[i]);
+
+		TEST_CHECK(!FUnicode::ValidateUTF8(malformed[i], len));
+		allMatch &= MatchesReference<CHAR16>(malformed[i], len);
+		allMatch &= MatchesReference<CHAR32>(malformed[i], len);
+	}
+	TEST_CHECK(allMatch);
+
+	// Every byte of a malformed sequence becomes one U+FFFD.
+	CHAR32 dest[4];
+	TEST_CHECK(FUnicode::UTF8ToUTF32(dest, 4, "\xE0\x80\x80", 3) == 3);
+	TEST_CHECK(dest[0] == FUnicode::REPLACEMENT_CHAR && dest[1] == FUnicode::REPLACEMENT_CHAR && dest[2] == FUnicode::REPLACEMENT_CHAR);
+
+	// Lone surrogates and code points past U+10FFFF encode as U+FFFD.
+	const CHAR16 loneHigh[] = { 0xD83D, 'A' };
+	const CHAR16 loneLow[]  = { 'A', 0xDE00 };
+	const CHAR16 highAtEnd[] = { 'A', 0xD83D };
+	const CHAR32 invalid32[] = { 0xD800, 0x110000, 'A' };
+
+	ANSICHAR dest8[16];
+	TEST_CHECK(FUnicode::UTF16ToUTF8(dest8, 16, loneHigh, 2) == 4 && memcmp(dest8, "\xEF\xBF\xBD" "A", 4) == 0);
+	TEST_CHECK(FUnicode::UTF16ToUTF8(dest8, 16, loneLow, 2) == 4 && memcmp(dest8, "A\xEF\xBF\xBD", 4) == 0);
+	TEST_CHECK(FUnicode::UTF16ToUTF8(dest8, 16, highAtEnd, 2) == 4 && memcmp(dest8, "A\xEF\xBF\xBD", 4) == 0);
+	TEST_CHECK(FUnicode::UTF32ToUTF8(dest8, 16, invalid32, 3) == 7 && memcmp(dest8, "\xEF\xBF\xBD\xEF\xBF\xBD" "A", 7) == 0);
+
+	TEST_CHECK(MatchesReference<ANSICHAR>(loneHigh, 2) && MatchesReference<ANSICHAR>(loneLow, 2) && MatchesReference<ANSICHAR>(highAtEnd, 2));
+	TEST_CHECK(MatchesReference<ANSICHAR>(invalid32, 3));
+}
+
+IMPLEMENT_TEST(UnicodeBlockBoundaries)
+{
+	using namespace Fly3DPrivateUnicodeTest;
+
+	const char* sequences8[] =
+	{
+		"\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x80", "\xE2\x82", "\xED\xA0\x80",
+	};
+
+	const CHAR16 sequences16[][2] = { { 0x00E9, 'x' }, { 0x20AC, 'x' }, { 0xD83D, 0xDE00 }, { 0xDE00, 'x' }, { 0xD83D, 'x' } };
+	const CHAR32 sequences32[]    = { 0x00E9, 0x20AC, 0x1F600, 0xD800, 0x110000 };
+
+	bool utf8Matches   = true;
+	bool validMatches  = true;
+	bool countMatches  = true;
+	bool utf16Matches  = true;
+	bool utf32Matches  = true;
+
+	TArray<ANSICHAR> text8;
+	TArray<CHAR16>   text16;
+	TArray<CHAR32>   text32;
+
+	// Every length up to three blocks with the non-ASCII input at every offset, so it lands before, on and
+	// after each 16 code unit block boundary, including sequences split across two blocks.
+	for (int32 len = 1; len <= MAX_TEST_LENGTH; ++len)
+	{
+		for (int32 offset = 0; offset < len; ++offset)
+		{
+			for (int32 s = 0; s < (int32)(sizeof(sequences8) / sizeof(sequences8[0])); ++s)
+			{
+				Fill(text8, len, (ANSICHAR)'a');
+				Insert(text8, offset, sequences8[s], (int32)strlen(sequences8[s]));
+
+				utf8Matches  &= MatchesReference<CHAR16>(text8.GetData(), len) && MatchesReference<CHAR32>(text8.GetData(), len);
+				validMatches &= FUnicode::ValidateUTF8(text8.GetData(), len) == ReferenceValidate(text8.GetData(), len);
+				countMatches &= FUnicode::CountCodePoints(text8.GetData(), len) == ReferenceCount(text8.GetData(), len);
+			}
+
+			for (int32 s = 0; s < (int32)(sizeof(sequences16) / sizeof(sequences16[0])); ++s)
+			{
+				Fill(text16, len, (CHAR16)'a');
+				Insert(text16, offset, sequences16[s], 2);
+				utf16Matches &= MatchesReference<ANSICHAR>(text16.GetData(), len);
+			}
+
+			for (int32 s = 0; s < (int32)(sizeof(sequences32) / sizeof(sequences32[0])); ++s)
+			{
+				Fill(text32, len, (CHAR32)'a');
+				Insert(text32, offset, &sequences32[s], 1);
+				utf32Matches &= MatchesReference<ANSICHAR>(text32.GetData(), len);
+			}
+		}
+	}
+
+	TEST_CHECK(utf8Matches);
+	TEST_CHECK(validMatches);
+	TEST_CHECK(countMatches);
+	TEST_CHECK(utf16Matches);
+	TEST_CHECK(utf32Matches);
+}
+
+IMPLEMENT_TEST(UnicodeFind)
+{
+	using namespace Fly3DPrivateUnicodeTest;
+
+	const TCHAR needles[][3] = { { 'x', 'y', 'z' }, { 'X', 'Y', 'Z' }, { 0x00C9, 'y', 0x0416 }, { 'x', 0x00E9, 'z' } };
+
+	bool allMatch = true;
+	TArray<TCHAR> text;
+
+	for (int32 len = 0; len <= MAX_TEST_LENGTH; ++len)
+	{
+		for (int32 offset = -1; offset < len; ++offset)
+		{
+			for (int32 n = 0; n < (int32)(sizeof(needles) / sizeof(needles[0])); ++n)
+			{
+				Fill(text, len, (TCHAR)'a');
+
+				// Lower case spellings of the needle, so the case-insensitive search finds it and the exact one does not.
+				for (int32 i = 0; offset >= 0 && i < 3 && offset + i < len; ++i)
+				{
+					text[offset + i] = FUnicode::ToLower(needles[n][i]);
+				}
+
+				for (int32 subLen = 1; subLen <= 3; ++subLen)
+				{
+					allMatch &= FUnicode::Find(text.GetData(), len, needles[n], subLen, false) == ReferenceFind(text.GetData(), len, needles[n], subLen, false);
+					allMatch &= FUnicode::Find(text.GetData(), len, needles[n], subLen, true) == ReferenceFind(text.GetData(), len, needles[n], subLen, true);
+				}
+			}
+		}
+	}
+
+	TEST_CHECK(allMatch);
+
+	const TCHAR haystack[] = { 'a', 'b', 'c', 'A', 'B', 'C' };
+	const TCHAR needle[]   = { 'A', 'B', 'C' };
+	TEST_CHECK(FUnicode::Find(haystack, 6, needle, 3, false) == 3);
+	TEST_CHECK(FUnicode::Find(haystack, 6, needle, 3, true) == 0);
+	TEST_CHECK(FUnicode::Find(haystack, 6, needle, 0, false) == 0);
+	TEST_CHECK(FUnicode::Find(haystack, 2, needle, 3, true) == -1);
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/ArrayView.h"
+
+namespace Fly3DPrivateVectorOpsTest
+{
+	enum ESignedEnum
+	{
+		SignedEnum_Negative = -100,
+		SignedEnum_Zero     = 0,
+		SignedEnum_Positive = 100
+	};
+
+	enum class EInt64Enum : int64
+	{
+		Lowest  = -0x7000000000000000LL,
+		Highest =  0x7000000000000000LL
+	};
+
+	static uint32 NextRandom(uint32& state)
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+
+	/** Compares the container kernels against plain loops on every length up to maxLength, covering the vector body and the scalar tail. */
+	template <typename T>
+	static void CheckAgainstScalar(const T* values, int32 numValues, int32 maxLength)
+	{
+		uint32 state = 12345;
+
+		for (int32 length = 1; length <= maxLength; ++length)
+		{
+			TArray<T> items;
+			for (int32 i = 0; i < length; ++i)
+			{
+				items.Add(values[NextRandom(state) % numValues]);
+			}
+
+			T expectedMin = items[0];
+			T expectedMax = items[0];
+			int32 expectedCount = 0;
+
+			for (int32 i = 0; i < length; ++i)
+			{
+				expectedMin = items[i] < expectedMin ? items[i] : expectedMin;
+				expectedMax = expectedMax < items[i] ? items[i] : expectedMax;
+				expectedCount += items[i] == values[0] ? 1 : 0;
+			}
+
+			TEST_CHECK(items.MinElement() == expectedMin);
+			TEST_CHECK(items.MaxElement() == expectedMax);
+			TEST_CHECK(items.Count(values[0]) == expectedCount);
+
+			TConstArrayView<T> view(items);
+			TEST_CHECK(view.MinElement() == expectedMin);
+			TEST_CHECK(view.MaxElement() == expectedMax);
+			TEST_CHECK(view.Count(values[0]) == expectedCount);
+		}
+	}
+}
+
+IMPLEMENT_TEST(VectorOpsSignedMinMax)
+{
+	using namespace Fly3DPrivateVectorOpsTest;
+
+	const int8  int8Values[]  = { -128, -1, 0, 1, 127, -5 };
+	const int16 int16Values[] = { -32768, -300, -1, 0, 1, 32767 };
+	const int32 int32Values[] = { -2147483647 - 1, -70000, -1, 0, 1, 2147483647 };
+	const int64 int64Values[] = { -9223372036854775807LL - 1, -5000000000LL, -1, 0, 1, 9223372036854775807LL };
+	const float floatValues[] = { -1e30f, -2.5f, -0.0f, 0.5f, 3.0f, 1e30f };
+
+	CheckAgainstScalar(int8Values,  6, 70);
+	CheckAgainstScalar(int16Values, 6, 40);
+	CheckAgainstScalar(int32Values, 6, 24);
+	CheckAgainstScalar(int64Values, 6, 12);
+	CheckAgainstScalar(floatValues, 6, 24);
+
+	TArray<int32> negatives;
+	for (int32 i = 0; i < 37; ++i)
+	{
+		negatives.Add(-i * 1000);
+	}
+
+	TEST_CHECK(negatives.MinElement() == -36000);
+	TEST_CHECK(negatives.MaxElement() == 0);
+}
+
+IMPLEMENT_TEST(VectorOpsUnsignedMinMax)
+{
+	using namespace Fly3DPrivateVectorOpsTest;
+
+	const uint8  uint8Values[]  = { 0, 1, 0x7F, 0x80, 0xFE, 0xFF };
+	const uint16 uint16Values[] = { 0, 1, 0x7FFF, 0x8000, 0xFFFE, 0xFFFF };
+	const uint32 uint32Values[] = { 0, 1, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFEu, 0xFFFFFFFFu };
+	const uint64 uint64Values[] = { 0, 1, 0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL };
+
+	CheckAgainstScalar(uint8Values,  6, 70);
+	CheckAgainstScalar(uint16Values, 6, 40);
+	CheckAgainstScalar(uint32Values, 6, 24);
+	CheckAgainstScalar(uint64Values, 6, 12);
+}
+
+IMPLEMENT_TEST(VectorOpsEnumAndCharMinMax)
+{
+	using namespace Fly3DPrivateVectorOpsTest;
+
+	const ESignedEnum enumValues[]  = { SignedEnum_Zero, SignedEnum_Negative, SignedEnum_Positive };
+	const EInt64Enum  int64Enums[]  = { EInt64Enum::Highest, EInt64Enum::Lowest };
+	const ANSICHAR    charValues[]  = { 'a', (ANSICHAR)0xE9, 'Z', (ANSICHAR)0x80, '0' };
+	const WIDECHAR    wcharValues[] = { L'a', (WIDECHAR)0x00E9, (WIDECHAR)0x4E2D, L'0' };
+
+	CheckAgainstScalar(enumValues,  3, 24);
+	CheckAgainstScalar(int64Enums,  2, 12);
+	CheckAgainstScalar(charValues,  5, 70);
+	CheckAgainstScalar(wcharValues, 4, 40);
+
+	TArray<ESignedEnum> enums;
+	for (int32 i = 0; i < 20; ++i)
+	{
+		enums.Add(i == 13 ? SignedEnum_Negative : SignedEnum_Positive);
+	}
+
+	TEST_CHECK(enums.MinElement() == SignedEnum_Negative);
+	TEST_CHECK(enums.MaxElement() == SignedEnum_Positive);
+	TEST_CHECK(enums.Count(SignedEnum_Negative) == 1);
+}
+
+IMPLEMENT_TEST(VectorOpsFindAndRemove)
+{
+	TArray<int16> items;
+	for (int32 i = 0; i < 50; ++i)
+	{
+		items.Add((int16)(i % 7 == 3 ? -3 : i));
+	}
+
+	TEST_CHECK(items.Find(-3) == 3);
+	TEST_CHECK(items.FindLast(-3) == 45);
+	TEST_CHECK(items.Find(-4) == INDEX_NONE);
+	TEST_CHECK(items.Count(-3) == 7);
+
+	TEST_CHECK(items.Remove(-3) == 7);
+	TEST_CHECK(items.Num() == 43);
+	TEST_CHECK(items.Count(-3) == 0);
+	TEST_CHECK(items.MinElement() == 0);
+	TEST_CHECK(items.MaxElement() == 49);
+}
\ No newline at end of file
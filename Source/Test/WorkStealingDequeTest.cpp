@@ -0,0 +1,155 @@
+﻿#include "Test/Test.h"
+#include "Runtime/Core/Containers/Array.h"
+#include "Runtime/Core/Containers/WorkStealingDeque.h"
+#include "Runtime/Core/PlatformAtomics.h"
+
+#include <thread>
+
+namespace Fly3DPrivateWorkStealingDequeTest
+{
+	enum
+	{
+		CAPACITY      = 4096,
+		NUM_ITEMS     = 200000,
+		NUM_THIEVES   = 3,
+		BURST_SIZE    = 64,
+	};
+
+	struct FItem
+	{
+		volatile int32 NumRuns;
+	};
+
+	static FORCE_INLINE void RunItem(FItem* item)
+	{
+		FPlatformAtomics::InterlockedIncrement(&item->NumRuns);
+	}
+}
+
+IMPLEMENT_TEST(WorkStealingDequeOrder)
+{
+	using namespace Fly3DPrivateWorkStealingDequeTest;
+
+	TWorkStealingDeque<FItem> deque(CAPACITY);
+	TEST_CHECK(deque.Capacity() == CAPACITY && deque.IsEmpty());
+	TEST_CHECK(deque.Pop() == nullptr && deque.Steal() == nullptr);
+
+	TArray<FItem> items;
+	items.AddZeroed(CAPACITY + 1);
+
+	for (int32 i = 0; i < CAPACITY; ++i)
+	{
+		TEST_CHECK(deque.Push(&items[i]));
+	}
+
+	TEST_CHECK(!deque.Push(&items[CAPACITY]));
+	TEST_CHECK(deque.Num() == CAPACITY);
+
+	// The owner takes the newest, thieves the oldest.
+	TEST_CHECK(deque.Pop() == &items[CAPACITY - 1]);
+	TEST_CHECK(deque.Steal() == &items[0]);
+
+	bool ordered = true;
+	for (int32 i = CAPACITY - 2; i >= 1; --i)
+	{
+		ordered &= deque.Pop() == &items[i];
+	}
+	TEST_CHECK(ordered && deque.IsEmpty());
+
+	// Keep the deque half full while the indices run several times around the ring.
+	for (int32 i = 0; i < CAPACITY / 2; ++i)
+	{
+		deque.Push(&items[i]);
+	}
+
+	bool wrapped = true;
+	for (int32 i = 0; i < CAPACITY * 4; ++i)
+	{
+		wrapped &= deque.Push(&items[(i + CAPACITY / 2) % CAPACITY]);
+		wrapped &= deque.Steal() == &items[i % CAPACITY];
+	}
+	TEST_CHECK(wrapped && deque.Num() == CAPACITY / 2);
+}
+
+IMPLEMENT_TEST(WorkStealingDequeConcurrentSteal)
+{
+	using namespace Fly3DPrivateWorkStealingDequeTest;
+
+	TWorkStealingDeque<FItem> deque(CAPACITY);
+
+	TArray<FItem> items;
+	items.AddZeroed(NUM_ITEMS);
+
+	volatile int32 ownerDone = 0;
+
+	TArray<std::thread> thieves;
+	for (int32 t = 0; t < NUM_THIEVES; ++t)
+	{
+		thieves.Emplace([&]()
+		{
+			while (true)
+			{
+				FItem* item = deque.Steal();
+				if (item)
+				{
+					RunItem(item);
+				}
+				else if (FPlatformAtomics::AtomicRead(&ownerDone) != 0 && deque.IsEmpty())
+				{
+					return;
+				}
+				else
+				{
+					FPlatformAtomics::YieldThread();
+				}
+			}
+		});
+	}
+
+	// The owner pushes in bursts and pops part of each, so the slots wrap around the ring many times over
+	// and both ends race for the last element whenever the deque runs dry.
+	int32 next = 0;
+	while (next < NUM_ITEMS)
+	{
+		for (int32 i = 0; i < BURST_SIZE && next < NUM_ITEMS; ++i)
+		{
+			if (deque.Push(&items[next]))
+			{
+				++next;
+			}
+			else if (FItem* item = deque.Pop())
+			{
+				RunItem(item);
+			}
+		}
+
+		for (int32 i = 0; i < BURST_SIZE / 2; ++i)
+		{
+			if (FItem* item = deque.Pop())
+			{
+				RunItem(item);
+			}
+		}
+	}
+
+	while (FItem* item = deque.Pop())
+	{
+		RunItem(item);
+	}
+
+	FPlatformAtomics::AtomicStore(&ownerDone, 1);
+
+	for (int32 t = 0; t < thieves.Num(); ++t)
+	{
+		thieves[t].join();
+	}
+
+	bool exactlyOnce = true;
+	for (int32 i = 0; i < NUM_ITEMS; ++i)
+	{
+		exactlyOnce &= items[i].NumRuns == 1;
+	}
+
+	TEST_CHECK(exactlyOnce);
+	TEST_CHECK(deque.IsEmpty());
+}
\ No newline at end of file